@@ -0,0 +1,420 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  SimWireResponse.cxx
+/// \brief Field and electronics response, noise and digitization of SimWire.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include "larsim/DetSim/SimWireResponse.h"
+
+// Framework includes
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "art_root_io/TFileService.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include "CLHEP/Random/RandFlat.h"
+
+// LArSoft includes
+#include "larcore/Geometry/Geometry.h"
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+#include "lardata/Utilities/LArFFT.h"
+
+// ROOT includes
+#include "TH1D.h"
+#include "TMath.h"
+
+// C++ includes
+#include <cmath>
+#include <string>
+#include <utility>
+
+namespace detsim {
+
+  //-------------------------------------------------
+  SimWireResponse::SimWireResponse(fhicl::ParameterSet const& pset)
+    : fCompression{pset.get<std::string>("CompressionType") == "Huffman" ? raw::kHuffman :
+                                                                           raw::kNone}
+    , fNoiseFact{pset.get<double>("NoiseFact")}
+    , fNoiseWidth{pset.get<double>("NoiseWidth")}
+    , fLowCutoff{pset.get<double>("LowCutoff")}
+    , fNFieldBins{pset.get<int>("FieldBins")}
+    , fCol3DCorrection{pset.get<double>("Col3DCorrection")}
+    , fInd3DCorrection{pset.get<double>("Ind3DCorrection")}
+    , fColFieldRespAmp{pset.get<double>("ColFieldRespAmp")}
+    , fIndFieldRespAmp{pset.get<double>("IndFieldRespAmp")}
+    , fShapeTimeConst{pset.get<std::vector<double>>("ShapeTimeConst")}
+    , fConvolutionCrossover{pset.get<double>("ConvolutionCrossover", 1.)}
+    , fResponseKernelThreshold{pset.get<double>("ResponseKernelThreshold", 1e-5)}
+  {}
+
+  //-------------------------------------------------
+  void
+  SimWireResponse::Initialize(CLHEP::HepRandomEngine& engine)
+  {
+    auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataForJob();
+    auto const detProp =
+      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataForJob(clockData);
+    fSampleRate = sampling_rate(clockData);
+    fNSamplesReadout = detProp.NumberTimeSamples();
+
+    // get access to the TFile service
+    art::ServiceHandle<art::TFileService const> tfs;
+
+    fNoiseDist = tfs->make<TH1D>("Noise", ";Noise (ADC);", 1000, -10., 10.);
+
+    art::ServiceHandle<util::LArFFT const> fFFT;
+    fNTicks = fFFT->FFTSize();
+
+    // Note the magic 100 here. Argo and uBooNe use NChannels.
+    fNoise.resize(100);
+    // GenNoise() will further resize each channel's
+    // fNoise vector to fNTicks long.
+
+    for (int p = 0; p < 100; ++p) {
+      GenNoise(fNoise[p], engine);
+      for (int i = 0; i < fNTicks; ++i) {
+        fNoiseDist->Fill(fNoise[p][i]);
+      }
+    } //end loop over wires
+
+    ///set field response and electronics response, then convolute them
+    SetFieldResponse();
+    SetElectResponse();
+    ConvoluteResponseFunctions();
+    MakeResponseKernels();
+  }
+
+  //-------------------------------------------------
+  std::vector<SimWireResponse::ChannelInfo_t>
+  SimWireResponse::MakeChannelTable(geo::GeometryCore const& geom)
+  {
+    std::vector<ChannelInfo_t> table;
+    table.reserve(geom.Nchannels());
+    for (raw::ChannelID_t chan = 0; chan < geom.Nchannels(); ++chan) {
+      ChannelInfo_t info;
+      info.signalType = geom.SignalType(chan);
+      // all but induction channels get the collection response
+      info.response =
+        (info.signalType == geo::kInduction) ? kInductionResponse : kCollectionResponse;
+      std::vector<geo::WireID> const wires = geom.ChannelToWire(chan);
+      info.plane = wires.empty() ? geo::PlaneID::InvalidID : wires.front().Plane;
+      table.push_back(info);
+    }
+    return table;
+  }
+
+  //-------------------------------------------------
+  bool
+  SimWireResponse::Convolute(std::vector<double>& charges,
+                             std::size_t nSignalTicks,
+                             ResponseIndex_t response,
+                             std::vector<double>& work) const
+  {
+    TruncatedResponseKernel const& kernel = fKernels[response];
+    if (UseTimeDomainConvolution(nSignalTicks, kernel)) {
+      kernel.convolute(charges, work);
+      return true;
+    }
+    art::ServiceHandle<util::LArFFT> fFFT;
+    fFFT->Convolute(charges, fShapes[response]);
+    return false;
+  }
+
+  //-------------------------------------------------
+  void
+  SimWireResponse::SampleNoiseIndices(CLHEP::HepRandomEngine& engine,
+                                      std::size_t nChannels,
+                                      std::vector<unsigned int>& noiseIndices) const
+  {
+    std::vector<double> choices(nChannels);
+    CLHEP::RandFlat::shootArray(&engine, nChannels, choices.data());
+
+    // pick a "noise channel" for every channel - this makes sure the noise
+    // has the right coherent characteristics to be on one channel
+    double const scale = 1. * (fNoise.size() - 1) + 0.1;
+    noiseIndices.resize(nChannels);
+    for (std::size_t i = 0; i < nChannels; ++i)
+      noiseIndices[i] = TMath::Nint(choices[i] * scale);
+  }
+
+  //-------------------------------------------------
+  raw::RawDigit
+  SimWireResponse::Digitize(raw::ChannelID_t channel,
+                            std::vector<double> const& signal,
+                            unsigned int noiseIndex) const
+  {
+    std::vector<float> const& noise = fNoise[noiseIndex];
+
+    std::vector<short> adcvec;
+    adcvec.reserve(fNTicks);
+    for (int i = 0; i < fNTicks; ++i) {
+      adcvec.push_back((short)TMath::Nint(noise[i] + signal[i]));
+    }
+    adcvec.resize(fNSamplesReadout);
+
+    // compress the adc vector using the desired compression scheme,
+    // if raw::kNone is selected nothing happens to adcvec
+    // This shrinks adcvec, if fCompression is not kNone.
+    raw::Compress(adcvec, fCompression);
+
+    return raw::RawDigit(channel, fNTicks, std::move(adcvec), fCompression);
+  }
+
+  //-------------------------------------------------
+  void
+  SimWireResponse::ConvoluteResponseFunctions()
+  {
+    std::vector<double> col(fNTicks, 0.);
+    std::vector<double> ind(fNTicks, 0.);
+
+    unsigned int mxbin = TMath::Min(fNTicks, (int)fNElectResp + fNFieldBins);
+
+    double sumCol = 0.;
+    double sumInd = 0.;
+
+    for (unsigned int i = 1; i < mxbin; ++i) {
+      sumCol = 0.;
+      sumInd = 0.;
+      for (unsigned int j = 0; j < (unsigned int)fNFieldBins; ++j) {
+        unsigned int k = i - j;
+        if (k == 0) break;
+        sumCol += fElectResponse[k] * fColFieldResponse[j];
+        sumInd += fElectResponse[k] * fIndFieldResponse[j];
+      }
+      col[i] = sumCol;
+      ind[i] = sumInd;
+
+    } //end loop over bins;
+
+    ///pad out the rest of the vector with 0.
+    ind.resize(fNTicks, 0.);
+    col.resize(fNTicks, 0.);
+
+    // write the shapes out to a file
+    art::ServiceHandle<art::TFileService const> tfs;
+    fColTimeShape = tfs->make<TH1D>(
+      "ConvolutedCollection", ";ticks; Electronics#timesCollection", fNTicks, 0, fNTicks);
+    fIndTimeShape = tfs->make<TH1D>(
+      "ConvolutedInduction", ";ticks; Electronics#timesInduction", fNTicks, 0, fNTicks);
+
+    std::vector<TComplex>& indShape = fShapes[kInductionResponse];
+    std::vector<TComplex>& colShape = fShapes[kCollectionResponse];
+    indShape.resize(fNTicks / 2 + 1);
+    colShape.resize(fNTicks / 2 + 1);
+
+    ///do the FFT of the shapes
+    std::vector<double> delta(fNTicks);
+    delta[0] = 1.0;
+    delta[fNTicks - 1] = 1.0;
+
+    art::ServiceHandle<util::LArFFT> fFFT;
+    fFFT->AlignedSum(ind, delta, false);
+    fFFT->AlignedSum(col, delta, false);
+    fFFT->DoFFT(ind, indShape);
+    fFFT->DoFFT(col, colShape);
+
+    ///check that you did the right thing
+    for (unsigned int i = 0; i < ind.size(); ++i) {
+      fColTimeShape->Fill(i, col[i]);
+      fIndTimeShape->Fill(i, ind[i]);
+    }
+
+    fColTimeShape->Write();
+    fIndTimeShape->Write();
+  }
+
+  //-------------------------------------------------
+  void
+  SimWireResponse::MakeResponseKernels()
+  {
+    // the FFT convolution is circular, with the response obtained back from
+    // the shapes in frequency space (which include the alignment shift)
+    art::ServiceHandle<util::LArFFT> fFFT;
+    std::vector<double> response(fNTicks, 0.);
+
+    for (std::size_t r = 0; r < kNResponses; ++r) {
+      fFFT->DoInvFFT(fShapes[r], response);
+      fKernels[r] = TruncatedResponseKernel(response, fResponseKernelThreshold);
+    }
+
+    MF_LOG_DEBUG("SimWire") << "Time-domain response kernels: "
+                            << fKernels[kInductionResponse].size() << " ticks (induction), "
+                            << fKernels[kCollectionResponse].size() << " ticks (collection)";
+  }
+
+  //-------------------------------------------------
+  bool
+  SimWireResponse::UseTimeDomainConvolution(std::size_t nSignalTicks,
+                                            TruncatedResponseKernel const& kernel) const
+  {
+    // a direct convolution takes one multiply-add per signal tick per kernel
+    // value; the FFT path takes a forward and an inverse transform
+    double const directCost = double(nSignalTicks) * kernel.size();
+    double const fftCost = fNTicks * std::log2(double(fNTicks));
+    return directCost < fConvolutionCrossover * fftCost;
+  }
+
+  //-------------------------------------------------
+  void
+  SimWireResponse::GenNoise(std::vector<float>& noise, CLHEP::HepRandomEngine& engine)
+  {
+    CLHEP::RandFlat flat(engine);
+
+    noise.clear();
+    noise.resize(fNTicks, 0.);
+    std::vector<TComplex> noiseFrequency(fNTicks / 2 + 1, 0.); ///<noise in frequency space
+
+    double pval = 0.;
+    double lofilter = 0.;
+    double phase = 0.;
+    double rnd[2] = {0.};
+
+    //width of frequencyBin in kHz
+    double binWidth = 1.0 / (fNTicks * fSampleRate * 1.0e-6);
+    for (int i = 0; i < fNTicks / 2 + 1; ++i) {
+      //exponential noise spectrum
+      pval = fNoiseFact * exp(-(double)i * binWidth / fNoiseWidth);
+      //low frequency cutoff
+      lofilter = 1.0 / (1.0 + exp(-(i - fLowCutoff / binWidth) / 0.5));
+      //randomize 10%
+      flat.fireArray(2, rnd, 0, 1);
+      pval *= lofilter * (0.9 + 0.2 * rnd[0]);
+      //random pahse angle
+      phase = rnd[1] * 2. * TMath::Pi();
+
+      TComplex tc(pval * cos(phase), pval * sin(phase));
+      noiseFrequency[i] += tc;
+    }
+
+    //std::cout << "filled noise freq" << std::endl;
+
+    //inverse FFT MCSignal
+    art::ServiceHandle<util::LArFFT> fFFT;
+    fFFT->DoInvFFT(noiseFrequency, noise);
+
+    noiseFrequency.clear();
+
+    ///multiply each noise value by fNTicks as the InvFFT
+    ///divides each bin by fNTicks assuming that a forward FFT
+    ///has already been done.
+    for (unsigned int i = 0; i < noise.size(); ++i)
+      noise[i] *= 1. * fNTicks;
+  }
+
+  //-------------------------------------------------
+  void
+  SimWireResponse::SetFieldResponse()
+  {
+    art::ServiceHandle<geo::Geometry const> geo;
+
+    double xyz1[3] = {0.};
+    double xyz2[3] = {0.};
+    double xyzl[3] = {0.};
+    ///< should always have at least 2 planes
+    geo->Plane(0).LocalToWorld(xyzl, xyz1);
+    geo->Plane(1).LocalToWorld(xyzl, xyz2);
+
+    ///this assumes all planes are equidistant from each other,
+    ///probably not a bad assumption
+    double pitch = xyz2[0] - xyz1[0]; ///in cm
+
+    fColFieldResponse.resize(fNFieldBins, 0.);
+    fIndFieldResponse.resize(fNFieldBins, 0.);
+
+    ///set the response for the collection plane first
+    ///the first entry is 0
+
+    // write out the response functions to the file
+    // get access to the TFile service
+    art::ServiceHandle<art::TFileService const> tfs;
+    fIndFieldResp =
+      tfs->make<TH1D>("InductionFieldResponse", ";t (ns);Induction Response", fNTicks, 0, fNTicks);
+    fColFieldResp = tfs->make<TH1D>(
+      "CollectionFieldResponse", ";t (ns);Collection Response", fNTicks, 0, fNTicks);
+    auto const detProp =
+      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataForJob();
+    double driftvelocity = detProp.DriftVelocity(detProp.Efield(), detProp.Temperature()) / 1000.;
+    int nbinc = TMath::Nint(fCol3DCorrection * (std::abs(pitch)) /
+                            (driftvelocity * fSampleRate)); ///number of bins //KP
+
+    double integral = 0.;
+    for (int i = 1; i < nbinc; ++i) {
+      fColFieldResponse[i] = fColFieldResponse[i - 1] + 1.0;
+      integral += fColFieldResponse[i];
+    }
+
+    for (int i = 0; i < nbinc; ++i) {
+      fColFieldResponse[i] *= fColFieldRespAmp / integral;
+      fColFieldResp->Fill(i, fColFieldResponse[i]);
+    }
+
+    ///now the induction plane
+
+    int nbini =
+      TMath::Nint(fInd3DCorrection * (std::abs(pitch)) / (driftvelocity * fSampleRate)); //KP
+    for (int i = 0; i < nbini; ++i) {
+      fIndFieldResponse[i] = fIndFieldRespAmp / (1. * nbini);
+      fIndFieldResponse[nbini + i] = -fIndFieldRespAmp / (1. * nbini);
+
+      fIndFieldResp->Fill(i, fIndFieldResponse[i]);
+      fIndFieldResp->Fill(nbini + i, fIndFieldResponse[nbini + i]);
+    }
+
+    fColFieldResp->Write();
+    fIndFieldResp->Write();
+  }
+
+  //-------------------------------------------------
+  void
+  SimWireResponse::SetElectResponse()
+  {
+    fElectResponse.resize(fNTicks, 0.);
+    std::vector<double> time(fNTicks, 0.);
+
+    double norm = fShapeTimeConst[1] * TMath::Pi();
+    norm /= sin(fShapeTimeConst[1] * TMath::Pi() / fShapeTimeConst[0]) / fSampleRate;
+
+    double peak = 0.;
+
+    for (int i = 0; i < fNTicks; ++i) {
+      time[i] = (1. * i - 0.33333 * fNTicks) * fSampleRate;
+
+      // The 120000 is an arbitrary scaling to get displays for microboone
+      fElectResponse[i] = 120000.0 * exp(-time[i] / fShapeTimeConst[0]) /
+                          (1. + exp(-time[i] / fShapeTimeConst[1])) / norm;
+
+      if (fElectResponse[i] > peak) { peak = fElectResponse[i]; }
+    } ///end loop over time buckets
+
+    ///remove all values of fElectResponse and time where fElectResponse < 0.01*peak
+    peak *= 0.01;
+    std::vector<double>::iterator eitr = fElectResponse.begin();
+    std::vector<double>::iterator titr = time.begin();
+    while (eitr != fElectResponse.end()) {
+      if (*eitr < peak) {
+        fElectResponse.erase(eitr);
+        time.erase(titr);
+      }
+      else {
+        ++eitr;
+        ++titr;
+      }
+    } //end loop to remove low response values
+
+    fNElectResp = fElectResponse.size();
+
+    // write the response out to a file
+    art::ServiceHandle<art::TFileService const> tfs;
+    fElectResp = tfs->make<TH1D>(
+      "ElectronicsResponse", ";t (ns);Electronics Response", fNElectResp, 0, fNElectResp);
+    for (unsigned int i = 0; i < fNElectResp; ++i) {
+      fElectResp->Fill(i, fElectResponse[i]);
+    }
+
+    fElectResp->Write();
+  }
+
+} // namespace detsim
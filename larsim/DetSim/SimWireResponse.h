@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  SimWireResponse.h
+/// \brief Field and electronics response, noise and digitization of SimWire.
+///
+////////////////////////////////////////////////////////////////////////
+
+/// The simple wire response of `SimWire` (triangular collection and bipolar
+/// induction field response, convoluted with the electronics shaping), its
+/// noise model and the digitization of a channel.
+///
+/// `SimWire` applies it to the charge of the `sim::SimChannel` of each
+/// channel; `SimDriftElectrons` applies it directly to the drifted charge
+/// when configured to produce digits.
+///
+/// Configuration parameters are the ones of `SimWire`:
+/// `NoiseFact`, `NoiseWidth`, `LowCutoff`, `FieldBins`, `Col3DCorrection`,
+/// `Ind3DCorrection`, `ColFieldRespAmp`, `IndFieldRespAmp`, `ShapeTimeConst`,
+/// `CompressionType`, `ConvolutionCrossover` (default: `1`) and
+/// `ResponseKernelThreshold` (default: `1e-5`); other keys are ignored.
+///
+/// The properties of the channels needed in the simulation (signal type,
+/// plane and the response to use) are tabulated by `MakeChannelTable()`, so
+/// that the loops on the channels don't query the geometry.
+
+#ifndef DetSim_SimWireResponse_h
+#define DetSim_SimWireResponse_h
+
+#include "larsim/DetSim/TruncatedResponseKernel.h"
+
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "lardataobj/RawData/RawDigit.h"
+#include "lardataobj/RawData/raw.h"
+
+#include "fhiclcpp/fwd.h"
+
+#include "TComplex.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+class TH1D;
+
+namespace CLHEP {
+  class HepRandomEngine;
+}
+
+namespace geo {
+  class GeometryCore;
+}
+
+namespace detsim {
+
+  class SimWireResponse {
+  public:
+    /// Index of the response functions.
+    enum ResponseIndex_t : unsigned short {
+      kInductionResponse,  ///< bipolar response of induction planes
+      kCollectionResponse, ///< unipolar response of collection planes
+      kNResponses          ///< number of responses
+    };
+
+    /// Properties of a channel used in the simulation.
+    struct ChannelInfo_t {
+      geo::SigType_t signalType;     ///< signal type of the channel
+      ResponseIndex_t response;      ///< response functions of the channel
+      geo::PlaneID::PlaneID_t plane; ///< plane of (the first wire of) the channel
+    };
+
+    explicit SimWireResponse(fhicl::ParameterSet const& pset);
+
+    /**
+     * @brief Computes the responses and generates the noise.
+     * @param engine random engine for the noise
+     *
+     * Requires `util::LArFFT`, `geo::Geometry`, `DetectorClocksService`,
+     * `DetectorPropertiesService` and `art::TFileService`, where the response
+     * and noise histograms are written. To be called at `beginJob()`.
+     */
+    void Initialize(CLHEP::HepRandomEngine& engine);
+
+    /// Number of ticks of the signals (the FFT size).
+    int
+    NTicks() const
+    {
+      return fNTicks;
+    }
+
+    /// Returns the properties of all the channels, indexed by channel ID.
+    static std::vector<ChannelInfo_t> MakeChannelTable(geo::GeometryCore const& geom);
+
+    /**
+     * @brief Convolutes the charge of a channel with the response.
+     * @param charges charge on each tick, `NTicks()` long; replaced by the signal
+     * @param nSignalTicks number of ticks with charge
+     * @param response the response of the channel
+     * @param work scratch buffer
+     * @return whether the convolution was performed in the time domain
+     */
+    bool Convolute(std::vector<double>& charges,
+                   std::size_t nSignalTicks,
+                   ResponseIndex_t response,
+                   std::vector<double>& work) const;
+
+    /**
+     * @brief Chooses a noise pattern for each channel.
+     * @param engine random engine for the choice
+     * @param nChannels number of channels
+     * @param[out] noiseIndices the pattern of each channel, resized to `nChannels`
+     *
+     * Random numbers are drawn in a single block, in the same sequence as one
+     * draw per channel.
+     */
+    void SampleNoiseIndices(CLHEP::HepRandomEngine& engine,
+                            std::size_t nChannels,
+                            std::vector<unsigned int>& noiseIndices) const;
+
+    /**
+     * @brief Adds noise to a signal and digitizes it.
+     * @param channel the channel of the digits
+     * @param signal signal on each tick, `NTicks()` long
+     * @param noiseIndex the noise pattern to use (see `SampleNoiseIndices()`)
+     */
+    raw::RawDigit Digitize(raw::ChannelID_t channel,
+                           std::vector<double> const& signal,
+                           unsigned int noiseIndex) const;
+
+  private:
+    void ConvoluteResponseFunctions(); ///< convolute electronics and field response
+    void MakeResponseKernels();        ///< time-domain version of the convoluted responses
+
+    /// Whether direct convolution of `nSignalTicks` ticks is cheaper than FFT.
+    bool UseTimeDomainConvolution(std::size_t nSignalTicks,
+                                  TruncatedResponseKernel const& kernel) const;
+
+    void SetFieldResponse(); ///< response of wires to field
+    void SetElectResponse(); ///< response of electronics
+
+    void GenNoise(std::vector<float>& array, CLHEP::HepRandomEngine& engine);
+
+    raw::Compress_t fCompression; ///< compression type to use
+
+    double fNoiseFact;                   ///< noise scale factor
+    double fNoiseWidth;                  ///< exponential noise width (kHz)
+    double fLowCutoff;                   ///< low frequency filter cutoff (kHz)
+    int fNTicks = 0;                     ///< number of ticks of the clock
+    int fNFieldBins;                     ///< number of bins for field response
+    double fSampleRate = 0.;             ///< sampling rate in ns
+    unsigned int fNSamplesReadout = 0;   ///< number of ADC readout samples in 1 readout frame
+    double fCol3DCorrection;             ///< correction factor to account for 3D path of
+                                         ///< electrons thru wires
+    double fInd3DCorrection;             ///< correction factor to account for 3D path of
+                                         ///< electrons thru wires
+    double fColFieldRespAmp;             ///< amplitude of response to field
+    double fIndFieldRespAmp;             ///< amplitude of response to field
+    std::vector<double> fShapeTimeConst; ///< time constants for exponential shaping
+    unsigned int fNElectResp = 0;        ///< number of entries from response to use
+    double fConvolutionCrossover;        ///< direct convolution is used when its cost is smaller
+                                         ///< than this factor times N log2(N) (0: FFT only)
+    double fResponseKernelThreshold;     ///< response values below this fraction of the
+                                         ///< peak are dropped from the time-domain kernels
+
+    std::vector<double> fColFieldResponse; ///< response function for the field @ collection plane
+    std::vector<double> fIndFieldResponse; ///< response function for the field @ induction plane
+    /// convoluted response functions in frequency space, by response index
+    std::array<std::vector<TComplex>, kNResponses> fShapes;
+    /// time-domain version of fShapes, by response index
+    std::array<TruncatedResponseKernel, kNResponses> fKernels;
+    std::vector<double> fElectResponse;     ///< response function for the electronics
+    std::vector<std::vector<float>> fNoise; ///< noise on each channel for each time
+
+    TH1D* fIndFieldResp = nullptr; ///< response function for the field @ induction plane
+    TH1D* fColFieldResp = nullptr; ///< response function for the field @ collection plane
+    TH1D* fElectResp = nullptr;    ///< response function for the electronics
+    TH1D* fColTimeShape = nullptr; ///< convoluted shape for field x electronics @ col plane
+    TH1D* fIndTimeShape = nullptr; ///< convoluted shape for field x electronics @ ind plane
+    TH1D* fNoiseDist = nullptr;    ///< distribution of noise counts
+  };                               // class SimWireResponse
+
+} // namespace detsim
+
+#endif // DetSim_SimWireResponse_h
@@ -0,0 +1,130 @@
+/**
+ * @file   larsim/DetSim/TruncatedResponseKernel.h
+ * @brief  Direct (time-domain) convolution with a truncated response.
+ * @see    larsim/DetSim/SimWire_module.cc
+ *
+ * FFT convolution costs the same whatever the signal; when only a few ticks
+ * of a channel carry charge, adding a copy of the response for each of them
+ * is much cheaper. The kernel keeps the shortest (circular) window of the
+ * response containing all its significant values, so that the result
+ * reproduces the circular convolution performed via FFT.
+ *
+ * This is a header-only library.
+ */
+
+#ifndef LARSIM_DETSIM_TRUNCATEDRESPONSEKERNEL_H
+#define LARSIM_DETSIM_TRUNCATEDRESPONSEKERNEL_H
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace detsim {
+
+  /**
+   * @brief Response function truncated for direct circular convolution.
+   *
+   * The response is given as the one used by FFT convolution: a sequence
+   * of `period()` values where the value at index `k` is the contribution
+   * to tick `t + k` (modulo the period) of a unit charge at tick `t`.
+   */
+  class TruncatedResponseKernel {
+  public:
+    TruncatedResponseKernel() = default;
+
+    /**
+     * @brief Builds the kernel from a full (circular) response.
+     * @param response the full response, one value per tick
+     * @param threshold values smaller than this fraction of the peak
+     *                  (in absolute value) are not significant
+     */
+    TruncatedResponseKernel(std::vector<double> const& response, double threshold)
+      : fPeriod{response.size()}
+    {
+      if (response.empty()) return;
+
+      double peak = 0.;
+      for (double v : response)
+        peak = std::max(peak, std::abs(v));
+      double const cut = threshold * peak;
+
+      // the window is the complement of the longest circular run
+      // of non-significant values
+      std::vector<std::size_t> significant;
+      for (std::size_t i = 0; i < fPeriod; ++i)
+        if (std::abs(response[i]) > cut) significant.push_back(i);
+      if (significant.empty()) return;
+
+      std::size_t gapEnd = significant.front(); // window starts after largest gap
+      std::size_t largestGap = significant.front() + fPeriod - significant.back() - 1;
+      for (std::size_t i = 1; i < significant.size(); ++i) {
+        std::size_t const gap = significant[i] - significant[i - 1] - 1;
+        if (gap > largestGap) {
+          largestGap = gap;
+          gapEnd = significant[i];
+        }
+      }
+
+      fFirst = gapEnd;
+      std::size_t const length = fPeriod - largestGap;
+      fValues.reserve(length);
+      for (std::size_t j = 0; j < length; ++j)
+        fValues.push_back(response[(fFirst + j) % fPeriod]);
+    }
+
+    /// Returns the number of values kept in the kernel.
+    std::size_t
+    size() const
+    {
+      return fValues.size();
+    }
+
+    /// Returns the length of the full response (and of the signals).
+    std::size_t
+    period() const
+    {
+      return fPeriod;
+    }
+
+    /// Returns the offset of the first value of the kernel in the response.
+    std::size_t
+    first() const
+    {
+      return fFirst;
+    }
+
+    /**
+     * @brief Replaces `signal` with its circular convolution with the kernel.
+     * @param signal the signal; must be `period()` long
+     * @param work scratch buffer, resized as needed
+     */
+    void
+    convolute(std::vector<double>& signal, std::vector<double>& work) const
+    {
+      work.assign(fPeriod, 0.);
+      std::size_t const length = fValues.size();
+      for (std::size_t t = 0; t < fPeriod; ++t) {
+        double const q = signal[t];
+        if (q == 0.) continue;
+        std::size_t const start = (t + fFirst) % fPeriod;
+        std::size_t const nBeforeWrap = std::min(length, fPeriod - start);
+        double* out = work.data() + start;
+        for (std::size_t j = 0; j < nBeforeWrap; ++j)
+          out[j] += q * fValues[j];
+        for (std::size_t j = nBeforeWrap; j < length; ++j)
+          work[j - nBeforeWrap] += q * fValues[j];
+      } // for
+      signal.swap(work);
+    }
+
+  private:
+    std::size_t fPeriod = 0;     ///< length of the full response
+    std::size_t fFirst = 0;      ///< offset of fValues.front() in the response
+    std::vector<double> fValues; ///< the significant window of the response
+  };
+
+} // namespace detsim
+
+#endif // LARSIM_DETSIM_TRUNCATEDRESPONSEKERNEL_H
@@ -0,0 +1,151 @@
+/**
+ * @file   larsim/ElectronDrift/DiffusionChargeSpreading.h
+ * @brief  Analytic spreading of a diffused charge cloud on a grid of bins.
+ * @see    larsim/ElectronDrift/SimDriftElectrons_module.cc
+ *
+ * Instead of sampling the position of each electron cluster, the drifted
+ * charge of a deposit can be distributed on the readout grid (wires by TDC
+ * ticks) by integrating its Gaussian diffusion profile over each bin, and
+ * then fluctuated with a multinomial draw over the bins covered.
+ *
+ * This is a header-only library.
+ */
+
+#ifndef LARSIM_ELECTRONDRIFT_DIFFUSIONCHARGESPREADING_H
+#define LARSIM_ELECTRONDRIFT_DIFFUSIONCHARGESPREADING_H
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace detsim {
+  namespace diffusion {
+
+    /// Fractions of a distribution in consecutive bins, starting from `first`.
+    struct BinFractions {
+      int first = 0;                ///< index of the first bin
+      std::vector<double> fractions; ///< fraction of the distribution in each bin
+    };
+
+    /**
+     * @brief Integrates a normal distribution over bins.
+     * @param mean mean of the distribution
+     * @param sigma standard deviation of the distribution
+     * @param origin lower edge of bin #0
+     * @param width width of each bin
+     * @param sigmaRange bins are included up to this many sigmas from the mean
+     * @return fractions of the distribution in each bin within the range
+     *
+     * Bin `i` covers `[ origin + i * width, origin + (i + 1) * width )`.
+     * The fractions are normalised to 1, i.e. the tails beyond `sigmaRange`
+     * are assigned to the bins in the range in proportion to their content.
+     * A non-positive `sigma` puts the whole distribution in the bin of `mean`.
+     */
+    inline BinFractions
+    gaussianBinFractions(double mean,
+                         double sigma,
+                         double origin,
+                         double width,
+                         double sigmaRange)
+    {
+      BinFractions bins;
+      if (sigma <= 0.) {
+        bins.first = static_cast<int>(std::floor((mean - origin) / width));
+        bins.fractions.push_back(1.);
+        return bins;
+      }
+
+      int const first =
+        static_cast<int>(std::floor((mean - sigmaRange * sigma - origin) / width));
+      int const last =
+        static_cast<int>(std::floor((mean + sigmaRange * sigma - origin) / width));
+
+      double const norm = 1. / (sigma * std::sqrt(2.));
+      auto const cdf = [mean, norm](double x) { return 0.5 * std::erfc((mean - x) * norm); };
+
+      bins.first = first;
+      bins.fractions.reserve(last - first + 1);
+      double lowerCDF = cdf(origin + first * width);
+      for (int i = first; i <= last; ++i) {
+        double const upperCDF = cdf(origin + (i + 1) * width);
+        bins.fractions.push_back(upperCDF - lowerCDF);
+        lowerCDF = upperCDF;
+      }
+
+      double const total = std::accumulate(bins.fractions.begin(), bins.fractions.end(), 0.);
+      if (total > 0.) {
+        for (double& fraction : bins.fractions)
+          fraction /= total;
+      }
+      return bins;
+    } // gaussianBinFractions()
+
+    /**
+     * @brief Splits `n` entries among bins with a multinomial distribution.
+     * @tparam Binomial callable `(int n, double p)` returning a binomial draw
+     * @param n number of entries to split
+     * @param probabilities probability of each bin (need not be normalised)
+     * @param binomial random binomial generator
+     * @return the number of entries in each bin, summing to `n`
+     *
+     * The multinomial is sampled as a sequence of conditional binomials; the
+     * last bin with a nonzero probability takes all the remaining entries.
+     * If no bin has a nonzero probability, all the counts are zero.
+     */
+    template <typename Binomial>
+    std::vector<int>
+    multinomialSplit(int n, std::vector<double> const& probabilities, Binomial&& binomial)
+    {
+      std::vector<int> counts(probabilities.size(), 0);
+
+      std::size_t last = probabilities.size();
+      while ((last > 0) && !(probabilities[last - 1] > 0.))
+        --last;
+      if (last == 0) return counts;
+      --last;
+
+      double mass = std::accumulate(probabilities.begin(), probabilities.begin() + last + 1, 0.);
+      for (std::size_t i = 0; (i < last) && (n > 0); ++i) {
+        double const p = probabilities[i];
+        if (!(p > 0.)) continue;
+        int const k = (p >= mass) ? n : binomial(n, p / mass);
+        counts[i] = k;
+        n -= k;
+        mass -= p;
+      }
+      counts[last] = n;
+      return counts;
+    } // multinomialSplit()
+
+    /**
+     * @brief Splits a charge among bins, keeping its fractional part.
+     * @tparam Binomial callable `(int n, double p)` returning a binomial draw
+     * @param charge number of electrons to split (need not be integral)
+     * @param probabilities probability of each bin (need not be normalised)
+     * @param binomial random binomial generator
+     * @return the charge in each bin, summing to `charge`
+     *
+     * The whole electrons are split by `multinomialSplit()`, and the
+     * fractional remainder is added to the most probable bin. If no bin has a
+     * nonzero probability, all the charges are zero.
+     */
+    template <typename Binomial>
+    std::vector<double>
+    chargeSplit(double charge, std::vector<double> const& probabilities, Binomial&& binomial)
+    {
+      int const n = (charge > 0.) ? static_cast<int>(std::floor(charge)) : 0;
+      std::vector<int> const counts = multinomialSplit(n, probabilities, binomial);
+      std::vector<double> charges(counts.begin(), counts.end());
+
+      auto const itMax = std::max_element(probabilities.begin(), probabilities.end());
+      if ((n < charge) && (itMax != probabilities.end()) && (*itMax > 0.))
+        charges[itMax - probabilities.begin()] += charge - n;
+      return charges;
+    } // chargeSplit()
+
+  } // namespace diffusion
+} // namespace detsim
+
+#endif // LARSIM_ELECTRONDRIFT_DIFFUSIONCHARGESPREADING_H
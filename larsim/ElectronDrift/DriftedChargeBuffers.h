@@ -0,0 +1,253 @@
+/**
+ * @file   larsim/ElectronDrift/DriftedChargeBuffers.h
+ * @brief  Per-channel tick buffers of drifted charge, with reduced truth.
+ * @see    larsim/ElectronDrift/SimDriftElectrons_module.cc
+ *
+ * When `SimDriftElectrons` produces digits directly, the drifted electrons
+ * are added to tick buffers of each channel instead of to the IDEs of a
+ * `sim::SimChannel`. The truth is reduced to the total charge and energy of
+ * each track on each channel, with its charge-weighted mean tick and deposit
+ * position.
+ *
+ * Only the tick ranges which receive charge are stored, in single precision:
+ * a full readout window per channel would take gigabytes in large detectors.
+ * The dense waveform is filled one channel at a time, when digitizing.
+ *
+ * This is a header-only library.
+ */
+
+#ifndef LARSIM_ELECTRONDRIFT_DRIFTEDCHARGEBUFFERS_H
+#define LARSIM_ELECTRONDRIFT_DRIFTEDCHARGEBUFFERS_H
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace detsim {
+
+  /**
+   * @brief Drifted charge of each channel, in ranges of ticks.
+   *
+   * The charge of a channel is kept in sorted, disjoint ranges of contiguous
+   * ticks. A charge within `MaxGap` ticks of a range extends it (filling the
+   * gap with zeroes), and ranges which get that close are merged: the memory
+   * needed follows the ticks with charge, not the length of the readout.
+   * The channel records are reused after `clear()`.
+   */
+  class DriftedChargeBuffers {
+  public:
+    /// Charge of one track on a channel.
+    struct TrackCharge_t {
+      int trackID;             ///< ID of the track in the detector simulation
+      double electrons = 0.;   ///< number of electrons on the channel
+      double energy = 0.;      ///< energy of the deposits the electrons come from [MeV]
+      double tickSum = 0.;     ///< sum of the ticks, weighted by electrons
+      double xyzSum[3] = {0.}; ///< sum of deposit positions, weighted by electrons [cm]
+
+      /// Charge-weighted mean tick.
+      double
+      meanTick() const
+      {
+        return tickSum / electrons;
+      }
+    };
+
+    /// Charge on a range of contiguous ticks.
+    struct TickRange_t {
+      unsigned int first;         ///< first tick of the range
+      std::vector<float> charges; ///< electrons on each tick of the range
+
+      /// Returns the tick after the last one of the range.
+      unsigned int
+      end() const
+      {
+        return first + charges.size();
+      }
+    };
+
+    /// Content of a channel.
+    struct Channel_t {
+      unsigned int channel;              ///< channel ID
+      std::vector<TickRange_t> ranges;   ///< ticks with charge, sorted
+      std::size_t nSignalTicks = 0;      ///< number of ticks with charge
+      std::vector<TrackCharge_t> tracks; ///< charge of each track (if truth is kept)
+    };
+
+    /// Empty ticks between charges which are still stored in the same range.
+    static constexpr unsigned int MaxGap = 16;
+
+    DriftedChargeBuffers() = default;
+
+    /**
+     * @brief Constructor.
+     * @param nChannels number of channels in the detector
+     * @param nTicks number of ticks of each buffer
+     * @param keepTruth whether to record the charge of each track
+     */
+    DriftedChargeBuffers(std::size_t nChannels, std::size_t nTicks, bool keepTruth)
+      : fNTicks{nTicks}, fKeepTruth{keepTruth}, fSlot(nChannels, NoSlot)
+    {}
+
+    /**
+     * @brief Adds drifted electrons to a channel.
+     * @param channel the channel receiving the electrons
+     * @param tick the tick of arrival; charge after the buffer is only in the truth
+     * @param electrons the number of electrons
+     * @param trackID the track which produced the electrons
+     * @param energy the energy associated to the electrons [MeV]
+     * @param xyz the position of the deposit [cm]
+     */
+    void
+    add(unsigned int channel,
+        unsigned int tick,
+        double electrons,
+        int trackID,
+        double energy,
+        double const* xyz)
+    {
+      Channel_t& data = channelData(channel);
+      if (tick < fNTicks) {
+        float& charge = chargeAt(data, tick);
+        if (charge == 0.f) ++data.nSignalTicks;
+        charge += electrons;
+      }
+      if (!fKeepTruth) return;
+
+      TrackCharge_t& track = trackData(data, trackID);
+      track.electrons += electrons;
+      track.energy += energy;
+      track.tickSum += electrons * tick;
+      for (std::size_t i = 0; i < 3; ++i)
+        track.xyzSum[i] += electrons * xyz[i];
+    }
+
+    /// Returns the number of channels with charge.
+    std::size_t
+    size() const
+    {
+      return fNUsed;
+    }
+
+    /// Returns the content of the channels, in order of their first charge.
+    Channel_t const*
+    begin() const
+    {
+      return fChannels.data();
+    }
+    Channel_t const*
+    end() const
+    {
+      return fChannels.data() + fNUsed;
+    }
+
+    /// Returns the content of `channel`, `nullptr` if it has no charge.
+    Channel_t const*
+    find(unsigned int channel) const
+    {
+      std::size_t const slot = fSlot[channel];
+      return (slot == NoSlot) ? nullptr : &fChannels[slot];
+    }
+
+    /**
+     * @brief Fills the dense waveform of a channel.
+     * @param data the content of the channel
+     * @param[out] charges the electrons on each tick of the readout
+     */
+    void
+    fillCharges(Channel_t const& data, std::vector<double>& charges) const
+    {
+      charges.assign(fNTicks, 0.);
+      for (TickRange_t const& range : data.ranges)
+        std::copy(range.charges.begin(), range.charges.end(), charges.begin() + range.first);
+    }
+
+    /// Removes all charge; the channel records are kept for reuse.
+    void
+    clear()
+    {
+      for (std::size_t i = 0; i < fNUsed; ++i)
+        fSlot[fChannels[i].channel] = NoSlot;
+      fNUsed = 0;
+      fLastTrack = 0;
+    }
+
+  private:
+    static constexpr std::size_t NoSlot = std::numeric_limits<std::size_t>::max();
+
+    std::size_t fNTicks = 0;          ///< number of ticks of the buffers
+    bool fKeepTruth = false;          ///< whether to record the charge of each track
+    std::vector<std::size_t> fSlot;   ///< index in fChannels of each channel
+    std::vector<Channel_t> fChannels; ///< channel content; only fNUsed are current
+    std::size_t fNUsed = 0;           ///< number of channels with charge
+    std::size_t fLastTrack = 0;       ///< index of the last track added to
+
+    Channel_t&
+    channelData(unsigned int channel)
+    {
+      std::size_t& slot = fSlot[channel];
+      if (slot != NoSlot) return fChannels[slot];
+
+      slot = fNUsed++;
+      if (slot == fChannels.size()) fChannels.emplace_back();
+      Channel_t& data = fChannels[slot];
+      data.channel = channel;
+      data.ranges.clear();
+      data.nSignalTicks = 0;
+      data.tracks.clear();
+      return data;
+    }
+
+    /// Returns the charge of `tick`, extending or creating its range.
+    float&
+    chargeAt(Channel_t& data, unsigned int tick)
+    {
+      auto& ranges = data.ranges;
+      auto next = std::upper_bound(
+        ranges.begin(), ranges.end(), tick, [](unsigned int t, TickRange_t const& range) {
+          return t < range.first;
+        });
+
+      if (next != ranges.begin()) {
+        auto const prev = std::prev(next);
+        if (tick <= prev->end() + MaxGap) {
+          if (tick >= prev->end()) prev->charges.resize(tick - prev->first + 1, 0.f);
+          // the extended range may now reach the next one
+          if ((next != ranges.end()) && (next->first <= prev->end() + MaxGap)) {
+            prev->charges.resize(next->first - prev->first, 0.f);
+            prev->charges.insert(prev->charges.end(), next->charges.begin(), next->charges.end());
+            ranges.erase(next);
+          }
+          return prev->charges[tick - prev->first];
+        }
+      }
+
+      if ((next != ranges.end()) && (next->first <= tick + MaxGap + 1)) {
+        next->charges.insert(next->charges.begin(), next->first - tick, 0.f);
+        next->first = tick;
+        return next->charges.front();
+      }
+
+      return ranges.insert(next, TickRange_t{tick, {0.f}})->charges.front();
+    }
+
+    TrackCharge_t&
+    trackData(Channel_t& data, int trackID)
+    {
+      // consecutive additions very often come from the same track
+      auto& tracks = data.tracks;
+      if ((fLastTrack < tracks.size()) && (tracks[fLastTrack].trackID == trackID))
+        return tracks[fLastTrack];
+      for (fLastTrack = 0; fLastTrack < tracks.size(); ++fLastTrack)
+        if (tracks[fLastTrack].trackID == trackID) return tracks[fLastTrack];
+      tracks.push_back({trackID});
+      return tracks.back();
+    }
+
+  }; // class DriftedChargeBuffers
+
+} // namespace detsim
+
+#endif // LARSIM_ELECTRONDRIFT_DRIFTEDCHARGEBUFFERS_H
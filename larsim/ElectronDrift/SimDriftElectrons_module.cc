@@ -46,6 +46,34 @@
  *   is actually off it by less than the chosen margin, it's accounted for by
  *   that plane; by default the margin is 0 and all the charge off the plane
  *   is lost (with a warning)
+ * * analytic diffusion: with `DiffusionKernel: "Analytic"` (default:
+ *   `"MonteCarlo"`), no electron clusters are sampled; the Gaussian charge
+ *   cloud of each deposit is integrated over the wire pitch and TDC tick bins
+ *   it covers (up to `AnalyticSigmaRange` sigmas), and the electrons are
+ *   distributed among those bins with a multinomial draw. The cost scales
+ *   with the number of bins covered rather than with the number of clusters.
+ * * adaptive electron cluster size: regulated by `AdaptiveClusterSize`;
+ *   the number of clusters of each deposit is chosen so that the diffused
+ *   charge cloud, `ClusterSigmaRange` sigmas wide, is sampled with
+ *   `ClustersPerResolutionCell` clusters for each wire pitch by drift-tick
+ *   cell it covers. The number of clusters is never larger than the one
+ *   from the fixed `ElectronClusterSize`, and never smaller than
+ *   `MinNumberOfElCluster`.
+ * * direct digitization: with `DirectToWaveform: true`, no `sim::SimChannel`
+ *   with the full ionization information is produced. The drifted electrons
+ *   are added to a buffer of ticks for each channel, which is convoluted with
+ *   the response of `SimWire` and digitized with its noise, producing a
+ *   `raw::RawDigit` for every channel. The response is configured by the
+ *   `DirectWaveform` table, with the same parameters as `SimWire`; the noise
+ *   uses a separate random engine (seed key: `SeedNoise`). With
+ *   `ReducedTruth: true` (default), a `sim::SimChannel` is still produced for
+ *   each channel with charge, with a single entry per track: its total
+ *   electrons and energy, at its charge-weighted mean tick and deposit
+ *   position.
+ * * readout window: with a `DepositTimeWindow` table (see
+ *   `sim::DepositTimeWindow`), energy deposits whose electrons can't reach
+ *   the planes within the readout window are skipped; the default maximum
+ *   delay is the longest drift time of the detector, plus 10%.
  *
  * Update:
  * Christoph Alt, September 2018 (christoph.alt@cern.ch)
@@ -54,9 +82,16 @@
 
 // LArSoft includes
 #include "larcore/Geometry/Geometry.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+#include "lardataobj/RawData/RawDigit.h"
 #include "lardataobj/Simulation/SimChannel.h"
 #include "lardataobj/Simulation/SimDriftedElectronCluster.h"
 #include "lardataobj/Simulation/SimEnergyDeposit.h"
+#include "larsim/DetSim/SimWireResponse.h"
+#include "larsim/ElectronDrift/DiffusionChargeSpreading.h"
+#include "larsim/ElectronDrift/DriftedChargeBuffers.h"
+#include "larsim/Simulation/DepositTimeWindow.h"
 #include "larsim/Simulation/LArG4Parameters.h"
 #include "larsim/Utils/SCEOffsetBounds.h"
 
@@ -71,19 +106,25 @@
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
+#include "art/Framework/Principal/Run.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "canvas/Utilities/Exception.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "nurandom/RandomUtils/NuRandomService.h"
 
 // External libraries
+#include "CLHEP/Random/RandBinomial.h"
 #include "CLHEP/Random/RandGauss.h"
 #include "TMath.h"
 
 // C++ includes
 #include <algorithm> // std::find
 #include <cmath>
+#include <limits>
 #include <map>
+#include <memory>
+#include <string>
 
 // stuff from wes
 #include "larsim/IonizationScintillation/ISCalcSeparate.h"
@@ -99,6 +140,8 @@ namespace detsim {
     // art::EDProducer.
     void produce(art::Event& evt) override;
     void beginJob() override;
+    void beginRun(art::Run& run) override;
+    void endJob() override;
 
   private:
     // The label of the module that created the sim::SimEnergyDeposit
@@ -120,6 +163,37 @@ namespace detsim {
 
     bool fStoreDriftedElectronClusters;
 
+    // adaptive cluster size
+    bool fAdaptiveClusterSize;
+    double fClusterSigmaRange;
+    double fClustersPerResolutionCell;
+    std::vector<std::vector<double>> fMinWirePitch; ///< smallest wire pitch [cryostat][tpc] (cm)
+
+    int adaptiveClusterNumber(double LDiffSig,
+                              double TDiffSig,
+                              double wirePitch,
+                              double tickDriftLength) const;
+
+    // analytic charge spreading
+    bool fAnalyticDiffusion;    ///< integrate the diffusion profile instead of sampling clusters
+    double fAnalyticSigmaRange; ///< range of the integration, in sigmas
+
+    // direct digitization
+    bool fDirectToWaveform;                         ///< produce digits, not full SimChannels
+    bool fReducedTruth;                             ///< produce SimChannels by track
+    std::unique_ptr<SimWireResponse> fResponse;     ///< response, noise and digitization
+    CLHEP::HepRandomEngine* fNoiseEngine = nullptr; ///< engine for the noise
+    DriftedChargeBuffers fChargeBuffers;            ///< drifted charge on each channel
+    std::vector<SimWireResponse::ChannelInfo_t> fChannelTable; ///< properties of each channel
+
+    /// Convolutes and digitizes the drifted charge of all channels.
+    std::unique_ptr<std::vector<raw::RawDigit>> digitize() const;
+
+    /// SimChannels with the reduced truth of each channel with charge.
+    std::unique_ptr<std::vector<sim::SimChannel>> reducedTruth() const;
+
+    sim::DepositTimeWindow fTimeWindow; ///< skips deposits out of the readout window
+
     // double fOffPlaneMargin;
 
     // In order to create the associations, for each channel we create
@@ -138,6 +212,28 @@ namespace detsim {
     // The above ensemble may be thought of as a 3D array of
     // ChannelBookKeepings: e.g., SimChannel[cryostat,tpc,channel ID].
 
+    size_t findOrAddChannel(ChannelMap_t& channelDataMap,
+                            raw::ChannelID_t channel,
+                            size_t edIndex,
+                            std::vector<sim::SimChannel>& channels) const;
+
+    // Distributes the electrons of a deposit on the wires and ticks of each
+    // plane. Like in the cluster path, each plane receives the whole charge,
+    // fractional electrons included, less the charge drifting outside of the
+    // plane or before tick 0; the split among the bins of each plane is an
+    // independent multinomial draw.
+    void spreadChargeAnalytically(sim::SimEnergyDeposit const& energyDeposit,
+                                  size_t edIndex,
+                                  geo::TPCGeo const& tpcGeo,
+                                  int driftcoordinate,
+                                  double const* driftPos,
+                                  double TDrift,
+                                  double nElectrons,
+                                  double LDiffSig,
+                                  double TDiffSig,
+                                  detinfo::DetectorClocksData const& clockData,
+                                  std::vector<sim::SimChannel>& channels);
+
     // Save the number of cryostats, and the number of TPCs within
     // each cryostat.
     size_t fNCryostats;
@@ -168,8 +264,41 @@ namespace detsim {
     // "Seed"
     , fRandGauss{art::ServiceHandle<rndm::NuRandomService>{}->createEngine(*this, pset, "Seed")}
     , fStoreDriftedElectronClusters{pset.get<bool>("StoreDriftedElectronClusters", false)}
+    , fAdaptiveClusterSize{pset.get<bool>("AdaptiveClusterSize", false)}
+    , fClusterSigmaRange{pset.get<double>("ClusterSigmaRange", 3.)}
+    , fClustersPerResolutionCell{pset.get<double>("ClustersPerResolutionCell", 4.)}
   {
-    produces<std::vector<sim::SimChannel>>();
+    std::string const kernel = pset.get<std::string>("DiffusionKernel", "MonteCarlo");
+    if (kernel == "MonteCarlo")
+      fAnalyticDiffusion = false;
+    else if (kernel == "Analytic")
+      fAnalyticDiffusion = true;
+    else {
+      throw art::Exception(art::errors::Configuration)
+        << "SimDriftElectrons: unknown DiffusionKernel '" << kernel
+        << "' (supported: 'MonteCarlo', 'Analytic')\n";
+    }
+    fAnalyticSigmaRange = pset.get<double>("AnalyticSigmaRange", 4.);
+    if (fAnalyticDiffusion && fStoreDriftedElectronClusters) {
+      throw art::Exception(art::errors::Configuration)
+        << "SimDriftElectrons: StoreDriftedElectronClusters requires the MonteCarlo"
+        << " DiffusionKernel\n";
+    }
+
+    fTimeWindow = sim::DepositTimeWindow(
+      pset.get<fhicl::ParameterSet>("DepositTimeWindow", fhicl::ParameterSet{}));
+
+    fDirectToWaveform = pset.get<bool>("DirectToWaveform", false);
+    fReducedTruth = fDirectToWaveform && pset.get<bool>("ReducedTruth", true);
+    if (fDirectToWaveform) {
+      fResponse =
+        std::make_unique<SimWireResponse>(pset.get<fhicl::ParameterSet>("DirectWaveform"));
+      fNoiseEngine = &art::ServiceHandle<rndm::NuRandomService>{}->createEngine(
+        *this, "HepJamesRandom", "noise", pset, "SeedNoise");
+      produces<std::vector<raw::RawDigit>>();
+    }
+
+    if (!fDirectToWaveform || fReducedTruth) produces<std::vector<sim::SimChannel>>();
     if (fStoreDriftedElectronClusters) { produces<std::vector<sim::SimDriftedElectronCluster>>(); }
   }
 
@@ -218,6 +347,198 @@ namespace detsim {
     fNTPCs.resize(fNCryostats);
     for (size_t n = 0; n < fNCryostats; ++n)
       fNTPCs[n] = fGeometry->NTPC(n);
+
+    // the finest wire pitch of each TPC sets the transverse resolution
+    fMinWirePitch.resize(fNCryostats);
+    for (size_t c = 0; c < fNCryostats; ++c) {
+      fMinWirePitch[c].resize(fNTPCs[c]);
+      for (size_t t = 0; t < fNTPCs[c]; ++t) {
+        geo::TPCGeo const& tpcGeo = fGeometry->TPC(t, c);
+        double pitch = std::numeric_limits<double>::max();
+        for (size_t p = 0; p < tpcGeo.Nplanes(); ++p)
+          pitch = std::min(pitch, tpcGeo.Plane(p).WirePitch());
+        fMinWirePitch[c][t] = pitch;
+      }
+    }
+
+    // margin for the plane spacing, space charge and diffusion
+    fTimeWindow.SetDefaultMaxDelay(1.1 *
+                                   sim::DepositTimeWindow::MaxDriftTime(*fGeometry, detProp));
+
+    if (fDirectToWaveform) {
+      fResponse->Initialize(*fNoiseEngine);
+      fChargeBuffers =
+        DriftedChargeBuffers(fGeometry->Nchannels(), fResponse->NTicks(), fReducedTruth);
+    }
+  }
+
+  //-------------------------------------------------
+  void
+  SimDriftElectrons::beginRun(art::Run&)
+  {
+    if (fDirectToWaveform) fChannelTable = SimWireResponse::MakeChannelTable(*fGeometry);
+  }
+
+  //-------------------------------------------------
+  void
+  SimDriftElectrons::endJob()
+  {
+    fTimeWindow.PrintSummary("SimDriftElectrons");
+  }
+
+  //-------------------------------------------------
+  // Number of clusters needed to sample the diffused charge cloud: the
+  // cloud covers about (1 + range * sigma / cell size) cells in each
+  // direction, each cell being a wire pitch wide and a tick long.
+  int
+  SimDriftElectrons::adaptiveClusterNumber(double LDiffSig,
+                                           double TDiffSig,
+                                           double wirePitch,
+                                           double tickDriftLength) const
+  {
+    double const nWires = 1. + 2. * fClusterSigmaRange * TDiffSig / wirePitch;
+    double const nTicks = 1. + 2. * fClusterSigmaRange * LDiffSig / tickDriftLength;
+    return (int)std::ceil(fClustersPerResolutionCell * nWires * nTicks);
+  }
+
+  //-------------------------------------------------
+  size_t
+  SimDriftElectrons::findOrAddChannel(ChannelMap_t& channelDataMap,
+                                      raw::ChannelID_t channel,
+                                      size_t edIndex,
+                                      std::vector<sim::SimChannel>& channels) const
+  {
+    // Find whether we already have this channel in our map.
+    auto search = channelDataMap.find(channel);
+
+    // Have we created the sim::SimChannel corresponding to
+    // channel ID?
+    if (search == channelDataMap.end()) {
+      // We haven't. Initialize the bookkeeping information
+      // for this channel.
+      ChannelBookKeeping bookKeeping;
+
+      // Add a new channel to the end of the list we'll
+      // write out after we've processed this event.
+      bookKeeping.channelIndex = channels.size();
+      channels.emplace_back(channel);
+
+      // Initialize a vector with the index of the step that
+      // created this channel.
+      bookKeeping.stepList.push_back(edIndex);
+
+      // Save the bookkeeping information for this channel.
+      channelDataMap[channel] = bookKeeping;
+      return bookKeeping.channelIndex;
+    }
+
+    // We've created this SimChannel for a previous energy
+    // deposit. Get its address.
+    auto& bookKeeping = search->second;
+
+    // Has this step contributed to this channel before?
+    auto& stepList = bookKeeping.stepList;
+    auto stepSearch = std::find(stepList.begin(), stepList.end(), edIndex);
+    if (stepSearch == stepList.end()) {
+      // No, so add this step's index to the list.
+      stepList.push_back(edIndex);
+    }
+    return bookKeeping.channelIndex;
+  }
+
+  //-------------------------------------------------
+  void
+  SimDriftElectrons::spreadChargeAnalytically(sim::SimEnergyDeposit const& energyDeposit,
+                                              size_t edIndex,
+                                              geo::TPCGeo const& tpcGeo,
+                                              int driftcoordinate,
+                                              double const* driftPos,
+                                              double TDrift,
+                                              double nElectrons,
+                                              double LDiffSig,
+                                              double TDiffSig,
+                                              detinfo::DetectorClocksData const& clockData,
+                                              std::vector<sim::SimChannel>& channels)
+  {
+    auto const& tpcClock = clockData.TPCClock();
+    geo::TPCID const& tpcid = tpcGeo.ID();
+    ChannelMap_t& channelDataMap = fChannelMaps[tpcid.Cryostat][tpcid.TPC];
+
+    auto const mp = energyDeposit.MidPoint();
+    double const xyz[3] = {mp.X(), mp.Y(), mp.Z()};
+    double const energyPerElectron = energyDeposit.Energy() / nElectrons;
+    if (!(nElectrons > 0.)) return;
+
+    // TDC ticks are in electronics time (us), wire bins in wire number
+    double const tickPeriod = tpcClock.TickPeriod();
+    double const tickSigma = LDiffSig * fRecipDriftVel[0] * 1.e-3;
+    auto binomial = [this](int n, double p) {
+      return (int)CLHEP::RandBinomial::shoot(&fRandGauss.engine(), n, p);
+    };
+
+    double pos[3] = {driftPos[0], driftPos[1], driftPos[2]};
+    for (size_t p = 0; p < tpcGeo.Nplanes(); ++p) {
+      geo::PlaneGeo const& plane = tpcGeo.Plane(p);
+      pos[driftcoordinate] = tpcGeo.PlaneLocation(p)[driftcoordinate];
+
+      // drift time to this plane, as in the cluster path
+      double TPlane = TDrift;
+      for (size_t ip = 0; ip < p; ++ip) {
+        TPlane +=
+          (tpcGeo.PlaneLocation(ip + 1)[driftcoordinate] -
+           tpcGeo.PlaneLocation(ip)[driftcoordinate]) *
+          fRecipDriftVel[(tpcGeo.Nplanes() == 2 && driftcoordinate == 0) ? ip + 2 : ip + 1];
+      }
+
+      // wire w collects the charge within half a pitch from it
+      diffusion::BinFractions const wireBins = diffusion::gaussianBinFractions(
+        plane.WireCoordinate(geo::Point_t{pos[0], pos[1], pos[2]}),
+        TDiffSig / plane.WirePitch(),
+        -0.5,
+        1.,
+        fAnalyticSigmaRange);
+      diffusion::BinFractions const tickBins =
+        diffusion::gaussianBinFractions(clockData.G4ToElecTime(TPlane + energyDeposit.Time()),
+                                        tickSigma,
+                                        0.,
+                                        tickPeriod,
+                                        fAnalyticSigmaRange);
+
+      std::vector<double> probabilities;
+      probabilities.reserve(wireBins.fractions.size() * tickBins.fractions.size());
+      for (double const wireFraction : wireBins.fractions)
+        for (double const tickFraction : tickBins.fractions)
+          probabilities.push_back(wireFraction * tickFraction);
+
+      std::vector<double> const charges = diffusion::chargeSplit(nElectrons, probabilities, binomial);
+
+      int const nWires = plane.Nwires();
+      size_t const nTicks = tickBins.fractions.size();
+      for (size_t iWire = 0; iWire < wireBins.fractions.size(); ++iWire) {
+        int const wire = wireBins.first + (int)iWire;
+        // charge drifting outside the plane is lost
+        if (wire < 0 || wire >= nWires) continue;
+
+        raw::ChannelID_t const channel = fGeometry->PlaneWireToChannel(
+          geo::WireID(tpcid.Cryostat, tpcid.TPC, p, (geo::WireID::WireID_t)wire));
+
+        size_t channelIndex = channels.size(); // not yet assigned
+        for (size_t iTick = 0; iTick < nTicks; ++iTick) {
+          double const n = charges[iWire * nTicks + iTick];
+          int const tick = tickBins.first + (int)iTick;
+          if (n <= 0. || tick < 0) continue;
+          if (fDirectToWaveform) {
+            fChargeBuffers.add(
+              channel, (unsigned int)tick, n, energyDeposit.TrackID(), n * energyPerElectron, xyz);
+            continue;
+          }
+          if (channelIndex == channels.size())
+            channelIndex = findOrAddChannel(channelDataMap, channel, edIndex, channels);
+          channels[channelIndex].AddIonizationElectrons(
+            energyDeposit.TrackID(), (unsigned int)tick, n, xyz, n * energyPerElectron);
+        } // for ticks
+      }   // for wires
+    }     // for planes
   }
 
   //-------------------------------------------------
@@ -240,6 +561,8 @@ namespace detsim {
     std::unique_ptr<std::vector<sim::SimDriftedElectronCluster>>
       SimDriftedElectronClusterCollection(new std::vector<sim::SimDriftedElectronCluster>);
 
+    fChargeBuffers.clear();
+
     // Clear the channel maps from the last event. Remember,
     // fChannelMaps is an array[cryo][tpc] of maps.
     size_t cryo = 0;
@@ -253,9 +576,13 @@ namespace detsim {
     auto const clockData =
       art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(event);
     auto const& tpcClock = clockData.TPCClock();
+    // distance drifted in one TPC tick (cm); TickPeriod() is in us
+    double const tickDriftLength = tpcClock.TickPeriod() * 1000. / fRecipDriftVel[0];
 
     auto const detProp =
       art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(event, clockData);
+    fTimeWindow.SetEvent(clockData, detProp);
+
     // We're going through the input vector by index, rather than by
     // iterator, because we need the index number to compute the
     // associations near the end of this method.
@@ -266,6 +593,9 @@ namespace detsim {
     for (size_t edIndex = 0; edIndex < energyDepositsSize; ++edIndex) {
       auto const& energyDeposit = energyDeposits[edIndex];
 
+      // skip the deposits whose charge would arrive out of the readout window
+      if (!fTimeWindow.Accept(energyDeposit)) continue;
+
       // "xyz" is the position of the energy deposit in world
       // coordinates. Note that the units of distance in
       // sim::SimEnergyDeposit are supposed to be cm.
@@ -408,10 +738,37 @@ namespace detsim {
       double SqrtT = std::sqrt(TDrift);
       double LDiffSig = SqrtT * fLDiff_const;
       double TDiffSig = SqrtT * fTDiff_const;
+
+      if (fAnalyticDiffusion) {
+        fDriftClusterPos[transversecoordinate1] = avegagetransversePos1;
+        fDriftClusterPos[transversecoordinate2] = avegagetransversePos2;
+        spreadChargeAnalytically(energyDeposit,
+                                 edIndex,
+                                 tpcGeo,
+                                 driftcoordinate,
+                                 fDriftClusterPos,
+                                 TDrift,
+                                 nElectrons,
+                                 LDiffSig,
+                                 TDiffSig,
+                                 clockData,
+                                 *channels);
+        continue;
+      }
       double electronclsize = fElectronClusterSize;
 
       // Number of electron clusters.
       int nClus = (int)std::ceil(nElectrons / electronclsize);
+      if (fAdaptiveClusterSize) {
+        int const nAdaptive = adaptiveClusterNumber(
+          LDiffSig, TDiffSig, fMinWirePitch[cryostat][tpc], tickDriftLength);
+        if (nAdaptive < nClus) {
+          nClus = std::max(nAdaptive, fMinNumberOfElCluster);
+          electronclsize = nElectrons / nClus;
+          if (electronclsize < 1.0) { electronclsize = 1.0; }
+          nClus = (int)std::ceil(nElectrons / electronclsize);
+        }
+      }
       if (nClus < fMinNumberOfElCluster) {
         electronclsize = nElectrons / fMinNumberOfElCluster;
         if (electronclsize < 1.0) { electronclsize = 1.0; }
@@ -493,56 +850,21 @@ namespace detsim {
             auto const simTime = energyDeposit.Time();
             unsigned int tdc = tpcClock.Ticks(clockData.G4ToElecTime(TDiff + simTime));
 
-            // Find whether we already have this channel in our map.
-            ChannelMap_t& channelDataMap = fChannelMaps[cryostat][tpc];
-            auto search = channelDataMap.find(channel);
-
-            // We will find (or create) the pointer to a
-            // sim::SimChannel.
-            size_t channelIndex = 0;
-
-            // Have we created the sim::SimChannel corresponding to
-            // channel ID?
-            if (search == channelDataMap.end()) {
-              // We haven't. Initialize the bookkeeping information
-              // for this channel.
-              ChannelBookKeeping bookKeeping;
-
-              // Add a new channel to the end of the list we'll
-              // write out after we've processed this event.
-              bookKeeping.channelIndex = channels->size();
-              channels->emplace_back(channel);
-              channelIndex = bookKeeping.channelIndex;
-
-              // Initialize a vector with the index of the step that
-              // created this channel.
-              bookKeeping.stepList.push_back(edIndex);
-
-              // Save the bookkeeping information for this channel.
-              channelDataMap[channel] = bookKeeping;
+            if (fDirectToWaveform) {
+              fChargeBuffers.add(
+                channel, tdc, fnElDiff[k], energyDeposit.TrackID(), fnEnDiff[k], xyz);
             }
             else {
-              // We've created this SimChannel for a previous energy
-              // deposit. Get its address.
-
-              auto& bookKeeping = search->second;
-              channelIndex = bookKeeping.channelIndex;
-
-              // Has this step contributed to this channel before?
-              auto& stepList = bookKeeping.stepList;
-              auto stepSearch = std::find(stepList.begin(), stepList.end(), edIndex);
-              if (stepSearch == stepList.end()) {
-                // No, so add this step's index to the list.
-                stepList.push_back(edIndex);
-              }
-            }
+              size_t const channelIndex =
+                findOrAddChannel(fChannelMaps[cryostat][tpc], channel, edIndex, *channels);
 
-            sim::SimChannel* channelPtr = &(channels->at(channelIndex));
+              sim::SimChannel* channelPtr = &(channels->at(channelIndex));
 
-            // Add the electron clusters and energy to the
-            // sim::SimChannel
-            channelPtr->AddIonizationElectrons(
-              energyDeposit.TrackID(), tdc, fnElDiff[k], xyz, fnEnDiff[k]);
+              // Add the electron clusters and energy to the
+              // sim::SimChannel
+              channelPtr->AddIonizationElectrons(
+                energyDeposit.TrackID(), tdc, fnElDiff[k], xyz, fnEnDiff[k]);
+            }
 
             if (fStoreDriftedElectronClusters)
               SimDriftedElectronClusterCollection->emplace_back(
@@ -566,11 +888,76 @@ namespace detsim {
       }     // end loop over planes
     }       // for each sim::SimEnergyDeposit
 
-    // Write the sim::SimChannel collection.
-    event.put(std::move(channels));
+    if (fDirectToWaveform) {
+      event.put(digitize());
+      if (fReducedTruth) event.put(reducedTruth());
+    }
+    else {
+      // Write the sim::SimChannel collection.
+      event.put(std::move(channels));
+    }
     if (fStoreDriftedElectronClusters) event.put(std::move(SimDriftedElectronClusterCollection));
   }
 
+  //-------------------------------------------------
+  std::unique_ptr<std::vector<raw::RawDigit>>
+  SimDriftElectrons::digitize() const
+  {
+    auto digits = std::make_unique<std::vector<raw::RawDigit>>();
+    unsigned int const nChannels = fChannelTable.size();
+    digits->reserve(nChannels);
+
+    std::vector<unsigned int> noiseIndices;
+    fResponse->SampleNoiseIndices(*fNoiseEngine, nChannels, noiseIndices);
+    std::vector<double> signal;
+    std::vector<double> work; // buffer for the time-domain convolution
+    std::vector<double> const noCharge(fResponse->NTicks(), 0.);
+    unsigned int nTimeDomain = 0;
+    unsigned int nFFT = 0;
+    for (unsigned int chan = 0; chan < nChannels; ++chan) {
+      DriftedChargeBuffers::Channel_t const* data = fChargeBuffers.find(chan);
+      if (!data || (data->nSignalTicks == 0)) {
+        digits->push_back(fResponse->Digitize(chan, noCharge, noiseIndices[chan]));
+        continue;
+      }
+
+      fChargeBuffers.fillCharges(*data, signal);
+      if (fResponse->Convolute(signal, data->nSignalTicks, fChannelTable[chan].response, work))
+        ++nTimeDomain;
+      else
+        ++nFFT;
+      digits->push_back(fResponse->Digitize(chan, signal, noiseIndices[chan]));
+    } // for channels
+
+    MF_LOG_DEBUG("SimDriftElectrons")
+      << "Digitized " << nChannels << " channels, " << fChargeBuffers.size()
+      << " with charge (" << nTimeDomain << " convoluted in time domain, " << nFFT
+      << " via FFT)";
+    return digits;
+  }
+
+  //-------------------------------------------------
+  std::unique_ptr<std::vector<sim::SimChannel>>
+  SimDriftElectrons::reducedTruth() const
+  {
+    auto channels = std::make_unique<std::vector<sim::SimChannel>>();
+    channels->reserve(fChargeBuffers.size());
+    for (DriftedChargeBuffers::Channel_t const& data : fChargeBuffers) {
+      sim::SimChannel& sc = channels->emplace_back(data.channel);
+      for (DriftedChargeBuffers::TrackCharge_t const& track : data.tracks) {
+        double const xyz[3] = {track.xyzSum[0] / track.electrons,
+                               track.xyzSum[1] / track.electrons,
+                               track.xyzSum[2] / track.electrons};
+        sc.AddIonizationElectrons(track.trackID,
+                                  (unsigned int)std::lround(track.meanTick()),
+                                  track.electrons,
+                                  xyz,
+                                  track.energy);
+      } // for tracks
+    }   // for channels
+    return channels;
+  }
+
 } // namespace detsim
 
 DEFINE_ART_MODULE(detsim::SimDriftElectrons)
@@ -62,6 +62,12 @@ class evgen::MarleyGen : public art::EDProducer {
         "MARLEYGen" // default value
       };
 
+      fhicl::Table<evgen::MARLEYHelper::Pool_Config> pool_ {
+        Name("pool"),
+        Comment("If enabled, MARLEY events are pre-generated in parallel"
+          " and drawn from the pool")
+      };
+
     }; // struct Config
 
     // Type to enable FHiCL parameter validation by art
@@ -145,9 +151,11 @@ void evgen::MarleyGen::produce(art::Event& e)
   TLorentzVector vertex_pos = fVertexSampler->sample_vertex_pos(*geo);
 
   // Create the MCTruth object, and retrieve the marley::Event object
-  // that was generated as it was created
-  simb::MCTruth truth = fMarleyHelper->create_MCTruth(vertex_pos,
-    fEvent.get());
+  // that was generated as it was created. The neutrino source never
+  // changes, so a single pool (with the configured source) is used.
+  simb::MCTruth truth = fMarleyHelper->pool_enabled()
+    ? fMarleyHelper->create_pooled_MCTruth(vertex_pos, 0u, {}, fEvent.get())
+    : fMarleyHelper->create_MCTruth(vertex_pos, fEvent.get());
 
   // Write the marley::Event object to the event tree
   fEventTree->Fill();
@@ -171,6 +179,11 @@ void evgen::MarleyGen::reconfigure(const Parameters& p)
   // Create a new marley::Generator object based on the current configuration
   fMarleyHelper = std::make_unique<MARLEYHelper>(p().marley_parameters_,
     *seed_service, "MARLEY");
+
+  // Set up the pool of pre-generated MARLEY events, if requested
+  fMarleyHelper->configure_pool(*seed_service,
+    p().pool_().threads_(),
+    p().pool_().events_per_thread_());
 }
 
 DEFINE_ART_MODULE(evgen::MarleyGen)
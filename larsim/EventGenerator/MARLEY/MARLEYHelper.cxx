@@ -12,6 +12,7 @@
 
 // LArSoft includes
 #include "larsim/EventGenerator/MARLEY/MARLEYHelper.h"
+#include "larsim/Utils/ParallelFor.h"
 #include "nurandom/RandomUtils/NuRandomService.h"
 
 // ROOT includes
@@ -20,8 +21,13 @@
 
 // MARLEY includes
 #include "marley/Event.hh"
+#include "marley/NeutrinoSource.hh"
 #include "marley/RootJSONConfig.hh"
 
+// standard library includes
+#include <limits>
+#include <utility>
+
 namespace {
   // We need to convert from MARLEY's energy units (MeV) to LArSoft's
   // (GeV) using this conversion factor
@@ -111,13 +117,48 @@ void evgen::MARLEYHelper::add_marley_particles(simb::MCTruth& truth,
 //------------------------------------------------------------------------------
 simb::MCTruth evgen::MARLEYHelper::create_MCTruth(
   const TLorentzVector& vtx_pos, marley::Event* marley_event)
+{
+  marley::Event event = fMarleyGenerator->create_event();
+
+  simb::MCTruth truth = make_MCTruth(vtx_pos, event);
+
+  if (marley_event) *marley_event = event;
+
+  flush_marley_log();
+
+  return truth;
+}
+
+//------------------------------------------------------------------------------
+simb::MCTruth evgen::MARLEYHelper::create_pooled_MCTruth(
+  const TLorentzVector& vtx_pos, std::size_t source_key,
+  const SourceMaker& make_source, marley::Event* marley_event)
+{
+  if (!pool_enabled()) throw cet::exception("MARLEYHelper " + fHelperName)
+    << "A pooled MARLEY event was requested, but the event pool is not"
+    << " configured.";
+
+  std::deque<marley::Event>& pool = fEventPools[source_key];
+  if (pool.empty()) fill_pool(source_key, make_source);
+
+  marley::Event event = std::move(pool.front());
+  pool.pop_front();
+
+  simb::MCTruth truth = make_MCTruth(vtx_pos, event);
+
+  if (marley_event) *marley_event = std::move(event);
+
+  return truth;
+}
+
+//------------------------------------------------------------------------------
+simb::MCTruth evgen::MARLEYHelper::make_MCTruth(
+  const TLorentzVector& vtx_pos, const marley::Event& event)
 {
   simb::MCTruth truth;
 
   truth.SetOrigin(simb::kSuperNovaNeutrino);
 
-  marley::Event event = fMarleyGenerator->create_event();
-
   // Add the initial and final state particles to the MCTruth object.
   add_marley_particles(truth, event.get_initial_particles(), vtx_pos, false);
   add_marley_particles(truth, event.get_final_particles(), vtx_pos, true);
@@ -158,8 +199,12 @@ simb::MCTruth evgen::MARLEYHelper::create_MCTruth(
     Q2 * std::pow(MeV_to_GeV, 2)
   );
 
-  if (marley_event) *marley_event = event;
+  return truth;
+}
 
+//------------------------------------------------------------------------------
+void evgen::MARLEYHelper::flush_marley_log()
+{
   // Process the MARLEY logging messages (if any) captured by our
   // stringstream and forward them to the messagefacility logger
   std::string line;
@@ -169,8 +214,104 @@ simb::MCTruth evgen::MARLEYHelper::create_MCTruth(
 
   // Reset the MARLEY log stream
   fMarleyLogStream = std::stringstream();
+}
 
-  return truth;
+//------------------------------------------------------------------------------
+void evgen::MARLEYHelper::configure_pool(
+  rndm::NuRandomService& rand_service, unsigned int n_threads,
+  unsigned int events_per_thread)
+{
+  fPoolGenerators.clear();
+  fPoolSourceKeys.clear();
+  fEventPools.clear();
+  fPoolEventsPerThread = events_per_thread;
+  fPoolSeeded = false;
+
+  if (n_threads == 0u) return;
+
+  if (events_per_thread == 0u) throw cet::exception("MARLEYHelper "
+    + fHelperName) << "The MARLEY event pool needs at least one event per"
+    << " worker generator.";
+
+  // The worker generators are created serially here: only the event
+  // generation itself runs in the TBB tasks of fill_pool()
+  marley::RootJSONConfig config(fMarleyJSON);
+  for (unsigned int i = 0u; i < n_threads; ++i) {
+    fPoolGenerators.push_back(std::make_unique<marley::Generator>(
+      config.create_generator()));
+
+    // Each worker generator has its own engine in the NuRandomService, so
+    // that its seed is as unique across jobs as the one of the main
+    // generator. The pooled events are generated well ahead of the art
+    // events they end up in, so they can't follow per-event reseeding.
+    rndm::NuRandomService::seed_t worker_seed = rand_service.registerEngine(
+      [this, i](rndm::NuRandomService::EngineId const& /* unused */,
+        rndm::NuRandomService::seed_t lar_seed) -> void
+      {
+        if (fPoolSeeded) throw cet::exception("MARLEYHelper "
+          + fHelperName) << "The MARLEY event pool can't be used with a"
+          << " NuRandomService policy reseeding the engines on each event:"
+          << " disable the pool (threads: 0) or change the policy.";
+        fPoolGenerators[i]->reseed(static_cast<uint_fast64_t>(lar_seed));
+      },
+      fHelperName + "_pool" + std::to_string(i)
+    );
+    // same workaround as for the main generator in the constructor
+    fPoolGenerators[i]->reseed(static_cast<uint_fast64_t>(worker_seed));
+  }
+  fPoolSeeded = true;
+
+  MF_LOG_INFO("MARLEYHelper " + fHelperName) << "MARLEY events will be"
+    << " pre-generated in pools of " << n_threads * events_per_thread
+    << " by " << n_threads << " worker threads.";
+  flush_marley_log();
+}
+
+//------------------------------------------------------------------------------
+void evgen::MARLEYHelper::fill_pool(std::size_t source_key,
+  const SourceMaker& make_source)
+{
+  size_t const n_workers = fPoolGenerators.size();
+  fPoolSourceKeys.resize(n_workers, std::numeric_limits<std::size_t>::max());
+
+  // Create the sources serially (they may come from ROOT objects), and only
+  // for the workers that are not loaded with the right one already
+  std::vector<std::unique_ptr<marley::NeutrinoSource> > sources(n_workers);
+  if (make_source) {
+    for (size_t i = 0; i < n_workers; ++i) {
+      if (fPoolSourceKeys[i] != source_key) sources[i] = make_source();
+    }
+  }
+
+  // Each worker generator fills its own chunk as a TBB task, within the
+  // threads of the art job
+  std::vector<std::vector<marley::Event> > chunks(n_workers);
+  try {
+    larsim::Utils::ParallelFor(n_workers, 0u,
+      [this, &sources, &chunks](std::size_t i) {
+        marley::Generator& gen = *fPoolGenerators[i];
+        if (sources[i]) gen.set_source(std::move(sources[i]));
+        chunks[i].reserve(fPoolEventsPerThread);
+        for (unsigned int j = 0u; j < fPoolEventsPerThread; ++j) {
+          chunks[i].push_back(gen.create_event());
+        }
+      });
+  }
+  catch (...) {
+    // the state of the worker generators is not known any more
+    fPoolSourceKeys.assign(n_workers, std::numeric_limits<std::size_t>::max());
+    throw;
+  }
+  if (make_source) fPoolSourceKeys.assign(n_workers, source_key);
+
+  // Append the events in worker order, so that the sequence of pooled
+  // events does not depend on the thread scheduling
+  std::deque<marley::Event>& pool = fEventPools[source_key];
+  for (auto& chunk : chunks) {
+    for (auto& event : chunk) pool.push_back(std::move(event));
+  }
+
+  flush_marley_log();
 }
 
 //------------------------------------------------------------------------------
@@ -259,6 +400,13 @@ void evgen::MARLEYHelper::reconfigure(
   // Create a new marley::Generator object based on the current configuration
   fMarleyGenerator = std::make_unique<marley::Generator>(
     config.create_generator());
+
+  // Keep the configuration for the generators of the event pool, which is
+  // disabled until configure_pool() is called again
+  fMarleyJSON = json;
+  fPoolGenerators.clear();
+  fPoolSourceKeys.clear();
+  fEventPools.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -11,6 +11,11 @@
 
 // standard library includes
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -39,10 +44,12 @@ namespace rndm { class NuRandomService; }
 #include "TLorentzVector.h"
 
 // MARLEY includes
+#include "marley/Event.hh"
 #include "marley/Generator.hh"
 #include "marley/JSON.hh"
 namespace marley {
   class Event;
+  class NeutrinoSource;
   class Particle;
 }
 
@@ -248,6 +255,32 @@ namespace evgen {
 
       }; // struct Config
 
+      /// Collection of configuration parameters for the pool of
+      /// pre-generated MARLEY events (see create_pooled_MCTruth())
+      struct Pool_Config {
+
+        fhicl::Atom<unsigned int> threads_ {
+          Name("threads"),
+          Comment("Number of worker generators filling the event pool, each"
+            " as a TBB task on the threads of the art job. Each worker owns"
+            " a MARLEY generator with its own engine in the"
+            " NuRandomService. Zero disables the pool"),
+          0u // default value
+        };
+
+        fhicl::Atom<unsigned int> events_per_thread_ {
+          Name("events_per_thread"),
+          Comment("Number of events generated by each worker generator whenever"
+            " the pool for a neutrino source runs empty"),
+          100u // default value
+        };
+
+      }; // struct Pool_Config
+
+      /// Function creating a new neutrino source for a worker generator
+      using SourceMaker
+        = std::function<std::unique_ptr<marley::NeutrinoSource>()>;
+
       // Configuration-checking constructors
       MARLEYHelper(const fhicl::Table<Config>& conf,
         rndm::NuRandomService& rand_service,
@@ -266,6 +299,30 @@ namespace evgen {
       simb::MCTruth create_MCTruth(const TLorentzVector& vtx_pos,
         marley::Event* marley_event = nullptr);
 
+      /// @brief Enables the pool of pre-generated events
+      /// @details Creates n_threads worker generators from the current
+      /// MARLEY configuration. Worker i is seeded by its own engine of
+      /// rand_service, with instance name "<helper name>_pool<i>", so it
+      /// must be called while the module is being constructed. Per-event
+      /// reseeding is not supported: the first reseed after this call throws
+      /// a cet::exception. A zero n_threads disables the pool.
+      void configure_pool(rndm::NuRandomService& rand_service,
+        unsigned int n_threads, unsigned int events_per_thread);
+
+      bool pool_enabled() const { return !fPoolGenerators.empty(); }
+
+      // Like create_MCTruth(), but the marley::Event is drawn from the pool
+      // of events generated with the neutrino source identified by
+      // source_key. When that pool is empty, it is refilled by the worker
+      // generators running as TBB tasks, each loaded with a source from
+      // make_source (an empty make_source keeps their current source,
+      // initially the one from the configuration).
+      // Events are independent of each other for a given source, so the
+      // sampled distributions are the same as in create_MCTruth().
+      simb::MCTruth create_pooled_MCTruth(const TLorentzVector& vtx_pos,
+        std::size_t source_key, const SourceMaker& make_source,
+        marley::Event* marley_event = nullptr);
+
       marley::Generator& get_generator() { return *fMarleyGenerator; }
       const marley::Generator& get_generator() const
         { return *fMarleyGenerator; }
@@ -312,8 +369,37 @@ namespace evgen {
       void load_full_paths_into_json(marley::JSON& json,
         const std::string& array_name);
 
+      // Fills the MCTruth object with the particles and interaction
+      // parameters of a MARLEY event
+      simb::MCTruth make_MCTruth(const TLorentzVector& vtx_pos,
+        const marley::Event& event);
+
+      // Generates new events for the pool of source_key in parallel
+      void fill_pool(std::size_t source_key, const SourceMaker& make_source);
+
+      // Forwards the MARLEY logging messages captured by fMarleyLogStream
+      // to the messagefacility logger
+      void flush_marley_log();
+
       std::unique_ptr<marley::Generator> fMarleyGenerator;
 
+      // JSON configuration used to create fMarleyGenerator (and the pool
+      // worker generators)
+      marley::JSON fMarleyJSON;
+
+      // Worker generators filling the event pools, and the key of the
+      // neutrino source each of them is currently loaded with
+      std::vector<std::unique_ptr<marley::Generator> > fPoolGenerators;
+      std::vector<std::size_t> fPoolSourceKeys;
+
+      unsigned int fPoolEventsPerThread = 0u;
+
+      // Whether the worker generators have received their seeds
+      bool fPoolSeeded = false;
+
+      // Pre-generated events not used yet, for each neutrino source key
+      std::map<std::size_t, std::deque<marley::Event> > fEventPools;
+
       // name to use for this instance of MARLEYHelper
       std::string fHelperName;
 
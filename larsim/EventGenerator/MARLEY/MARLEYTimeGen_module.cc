@@ -217,6 +217,15 @@ class evgen::MarleyTimeGen : public art::EDProducer {
         }
       };
 
+      fhicl::Table<evgen::MARLEYHelper::Pool_Config> pool_ {
+        Name("pool"),
+        Comment("If enabled, MARLEY events are pre-generated in parallel"
+          " for each neutrino source (the whole spectrum, or each time bin"
+          " of a \"fit\" format spectrum file) and drawn from the pool."
+          " This is ignored by the \"uniform energy\" sampling mode, which"
+          " needs a different source for each vertex.")
+      };
+
     }; // struct Config
 
     // Type to enable FHiCL parameter validation by art
@@ -371,6 +380,10 @@ class evgen::MarleyTimeGen : public art::EDProducer {
     std::unique_ptr<marley::NeutrinoSource> source_from_time_fit(
       const TimeFit& fit);
 
+    /// @brief Create a MARLEY neutrino source object using the
+    /// time-integrated spectrum from the ROOT TH2D
+    std::unique_ptr<marley::NeutrinoSource> source_from_th2d() const;
+
     /// @brief Create simb::MCTruth and sim::SupernovaTruth objects using
     /// spectrum information from a ROOT TH2D
     void create_truths_th2d(simb::MCTruth& mc_truth,
@@ -569,8 +582,11 @@ void evgen::MarleyTimeGen::create_truths_th2d(simb::MCTruth& mc_truth,
   {
     // Generate a MARLEY event using the time-integrated spectrum
     // (the generator was already configured to use it by reconfigure())
-    mc_truth = fMarleyHelper->create_MCTruth(vertex_pos,
-      fEvent.get());
+    if (fMarleyHelper->pool_enabled()) {
+      mc_truth = fMarleyHelper->create_pooled_MCTruth(vertex_pos, 0u,
+        [this]() { return source_from_th2d(); }, fEvent.get());
+    }
+    else mc_truth = fMarleyHelper->create_MCTruth(vertex_pos, fEvent.get());
 
     // Find the time distribution corresponding to the selected energy bin
     double E_nu = fEvent->projectile().total_energy();
@@ -602,8 +618,11 @@ void evgen::MarleyTimeGen::create_truths_th2d(simb::MCTruth& mc_truth,
   {
     // Generate a MARLEY event using the time-integrated spectrum
     // (the generator was already configured to use it by reconfigure())
-    mc_truth = fMarleyHelper->create_MCTruth(vertex_pos,
-      fEvent.get());
+    if (fMarleyHelper->pool_enabled()) {
+      mc_truth = fMarleyHelper->create_pooled_MCTruth(vertex_pos, 0u,
+        [this]() { return source_from_th2d(); }, fEvent.get());
+    }
+    else mc_truth = fMarleyHelper->create_MCTruth(vertex_pos, fEvent.get());
 
     // Sample a time uniformly
     TAxis* time_axis = fSpectrumHist->GetXaxis();
@@ -799,6 +818,18 @@ void evgen::MarleyTimeGen::reconfigure(const Parameters& p)
     << " will be generated for each art::Event using the \"" << samp_mode_str
     << "\" sampling mode.";
 
+  // Set up the pool of pre-generated MARLEY events, if requested
+  const auto& pool_conf = p().pool_();
+  if (pool_conf.threads_() > 0u) {
+    if (fSamplingMode == TimeGenSamplingMode::UNIFORM_ENERGY) {
+      MF_LOG_WARNING("MARLEYTimeGen") << "The MARLEY event pool is not"
+        << " supported by the \"uniform energy\" sampling mode. Events will"
+        << " be generated one at a time.";
+    }
+    else fMarleyHelper->configure_pool(*seed_service, pool_conf.threads_(),
+      pool_conf.events_per_thread_());
+  }
+
   // Retrieve the time-dependent neutrino spectrum from the spectrum file.
   // Use different methods depending on the file's format.
   std::string spectrum_file_format = marley_utils::to_lowercase(
@@ -867,16 +898,9 @@ void evgen::MarleyTimeGen::reconfigure(const Parameters& p)
     // used to compute neutrino vertex weights for the sim::SupernovaTruth
     // objects.
 
-    // Get a 1D projection of the energy spectrum (integrated over time)
-    TH1D* energy_spect = fSpectrumHist->ProjectionY("energy_spect");
-
-    // Create a new MARLEY neutrino source object using this projection
-    // TODO: replace the hard-coded electron neutrino PDG code here (and in
-    // several other places in this source file) when you're ready to use
-    // MARLEY with multiple neutrino flavors
-    std::unique_ptr<marley::NeutrinoSource> nu_source
-      = marley_root::make_root_neutrino_source(marley_utils::ELECTRON_NEUTRINO,
-      energy_spect);
+    // Create a new MARLEY neutrino source object using a 1D projection of
+    // the energy spectrum (integrated over time)
+    std::unique_ptr<marley::NeutrinoSource> nu_source = source_from_th2d();
 
     // Factor of hbar_c^2 converts from MeV^(-2) to fm^2
     fFluxAveragedCrossSection = marley_utils::hbar_c2
@@ -1106,12 +1130,21 @@ void evgen::MarleyTimeGen::create_truths_time_fit(simb::MCTruth& mc_truth,
   if (fSamplingMode == TimeGenSamplingMode::HISTOGRAM
     || fSamplingMode == TimeGenSamplingMode::UNIFORM_TIME)
   {
-    // Replace the generator's old source with the new one for the current
-    // time bin
-    gen.set_source(std::move(nu_source));
+    if (fMarleyHelper->pool_enabled()) {
+      // Draw a MARLEY event from the pool of the current time bin
+      mc_truth = fMarleyHelper->create_pooled_MCTruth(vertex_pos,
+        time_bin_index, [this, time_bin_index]() {
+          return source_from_time_fit(fTimeFits.at(time_bin_index));
+        }, fEvent.get());
+    }
+    else {
+      // Replace the generator's old source with the new one for the current
+      // time bin
+      gen.set_source(std::move(nu_source));
 
-    // Generate a MARLEY event using the updated source
-    mc_truth = fMarleyHelper->create_MCTruth(vertex_pos, fEvent.get());
+      // Generate a MARLEY event using the updated source
+      mc_truth = fMarleyHelper->create_MCTruth(vertex_pos, fEvent.get());
+    }
 
     if (fSamplingMode == TimeGenSamplingMode::HISTOGRAM) {
       // Unbiased sampling creates neutrino vertices with unit weight
@@ -1203,6 +1236,20 @@ std::unique_ptr<marley::NeutrinoSource>
   return nu_source;
 }
 
+//------------------------------------------------------------------------------
+std::unique_ptr<marley::NeutrinoSource>
+  evgen::MarleyTimeGen::source_from_th2d() const
+{
+  // Get a 1D projection of the energy spectrum (integrated over time)
+  TH1D* energy_spect = fSpectrumHist->ProjectionY("energy_spect");
+
+  // TODO: replace the hard-coded electron neutrino PDG code here (and in
+  // several other places in this source file) when you're ready to use
+  // MARLEY with multiple neutrino flavors
+  return marley_root::make_root_neutrino_source(
+    marley_utils::ELECTRON_NEUTRINO, energy_spect);
+}
+
 //------------------------------------------------------------------------------
 simb::MCTruth evgen::MarleyTimeGen::make_uniform_energy_mctruth(double E_min,
   double E_max, double& E_nu, const TLorentzVector& vertex_pos)
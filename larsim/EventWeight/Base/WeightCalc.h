@@ -25,6 +25,10 @@ namespace evwgh {
     void                        SetName(std::string name) {fName=name;}
     std::string                 GetName() {return fName;}
 
+    /// Whether GetWeight() may run concurrently with the other calculators
+    /// (calculators must opt in, after checking their dependencies).
+    virtual bool                IsThreadSafe() const {return false;}
+
     /**
      * @brief Applies Gaussian smearing to a set of data
      * @param centralValues the values to be smeared
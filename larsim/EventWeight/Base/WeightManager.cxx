@@ -1,5 +1,11 @@
 #include "WeightManager.h"
 
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+
+#include <exception>
+#include <utility>
+
 
 namespace evwgh {
 
@@ -13,22 +19,78 @@ namespace evwgh {
   { return _name; }
 
 
+  void WeightManager::AddWeightCalc(std::string const& func, std::string const& func_type,
+                                    WeightCalc* wcalc, int nMultisims)
+  {
+    Weight_t* winfo=new Weight_t();
+    winfo->fWeightCalcType=func_type;
+    winfo->fWeightCalc=wcalc;
+    winfo->fNmultisims=nMultisims;
+
+    fWeightCalcMap.emplace(func, winfo);
+    _configured = true;
+  }
+
+
   //
   // CORE FUNCTION
   //
   MCEventWeight WeightManager::Run(art::Event & e, const int inu)
+  {
+    return Run(inu, [&e](Weight_t& winfo){ return winfo.GetWeight(e); });
+  }
+
+
+  MCEventWeight WeightManager::Run(const int inu, WeightFunc_t const& getWeight)
   {
 
     if (!_configured)
       throw cet::exception(__PRETTY_FUNCTION__) << "Have not configured yet!" << std::endl;
 
     //
-    // Loop over all functions ang calculate weights
+    // Calculate the weights of all functions: the thread-safe ones as
+    // parallel tasks, the others in this thread
+    //
+    std::vector<std::pair<std::string const*, Weight_t*>> calcs;
+    for (auto& [name, winfo] : fWeightCalcMap) calcs.emplace_back(&name, winfo);
+    std::vector<std::vector<std::vector<double>>> results(calcs.size());
+
+    std::vector<size_t> parallel, serial;
+    for (size_t i = 0; i < calcs.size(); ++i)
+      (calcs[i].second->fWeightCalc->IsThreadSafe()? parallel: serial).push_back(i);
+
+    if (fNThreads == 1) {
+      serial.insert(serial.end(), parallel.begin(), parallel.end());
+      parallel.clear();
+    }
+
+    // the thread-safe calculators run as TBB tasks, sharing the threads of the
+    // job; the arena caps them to fNThreads (the calling thread included)
+    tbb::task_arena arena{ (fNThreads == 0)? tbb::task_arena::automatic: static_cast<int>(fNThreads) };
+    tbb::task_group tasks;
+    arena.execute([&]() {
+      for (size_t i: parallel)
+        tasks.run([&results, &calcs, &getWeight, i]() { results[i] = getWeight(*calcs[i].second); });
+    });
+
+    // the tasks must be waited for even if a serial calculator fails
+    std::exception_ptr error;
+    try {
+      for (size_t i: serial) results[i] = getWeight(*calcs[i].second);
+    }
+    catch (...) {
+      error = std::current_exception();
+    }
+    arena.execute([&tasks]() { tasks.wait(); }); // rethrows a task exception
+    if (error) std::rethrow_exception(error);
+
+    //
+    // Merge the weights in order of function name, as the serial loop did
     //
     MCEventWeight mcwgh;
-    for (auto it = fWeightCalcMap.begin() ;it != fWeightCalcMap.end(); it++) {
+    for (size_t i = 0; i < calcs.size(); ++i) {
 
-      auto const & weights = it->second->GetWeight(e);
+      auto const & weights = results[i];
 
       if(weights.size() == 0){
         std::vector<double> empty;
@@ -37,7 +99,7 @@ namespace evwgh {
       }
       else{
         std::pair<std::string, std::vector<double> >
-          p(it->first+"_"+it->second->fWeightCalcType,
+          p(*calcs[i].first+"_"+calcs[i].second->fWeightCalcType,
             weights[inu]);
         mcwgh.fWeight.insert(p);
       }
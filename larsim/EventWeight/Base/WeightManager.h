@@ -21,6 +21,8 @@
 #include "WeightCalc.h"
 #include "WeightCalcFactory.h"
 
+#include <functional>
+
 namespace evwgh {
   /**
      \class WeightManager
@@ -59,10 +61,39 @@ namespace evwgh {
        The execution takes following steps:             \n
        0) Loos over all the previously emplaced calculators \n
        1) For each of them calculates the weights (more weight can be requested per calculator) \n
-       3) Returns a map from "calculator name" to vector of weights calculated which is available inside MCEventWeight
+       3) Returns a map from "calculator name" to vector of weights calculated which is available inside MCEventWeight \n
+       With weight_threads different from 1, the calculators run as TBB tasks on the threads of the
+       job, except the ones which are not thread-safe (WeightCalc::IsThreadSafe()), which run one
+       after the other in the calling thread;
+       the result does not depend on the number of threads.
      */
     MCEventWeight Run(art::Event &e, const int inu);
 
+    /// Function computing the weights of one calculator (see Run()).
+    using WeightFunc_t = std::function<std::vector<std::vector<double>>(Weight_t&)>;
+
+    /**
+      * @brief Like Run(art::Event&, int), computing the weights via `getWeight`
+      * @param inu the index of the simulated neutrino in the event
+      * @param getWeight called once for each calculator, possibly concurrently
+       Run(e, inu) is Run(inu, getWeight) with a getWeight calling Weight_t::GetWeight(e).
+     */
+    MCEventWeight Run(const int inu, WeightFunc_t const& getWeight);
+
+    /**
+      * @brief Adds an already configured calculator (Configure() does this for each function)
+      * @param func the name of the function
+      * @param func_type the type of the calculator
+      * @param wcalc the calculator
+      * @param nMultisims the number of multisims of the function
+     */
+    void AddWeightCalc(std::string const& func, std::string const& func_type,
+                       WeightCalc* wcalc, int nMultisims);
+
+    /// Sets the number of threads running the calculators (0: no limit)
+    void SetNThreads(unsigned int nThreads)
+    { fNThreads = nThreads; }
+
     /**
       * @brief Returns the map between calculator name and Weight_t product
       */
@@ -77,6 +108,7 @@ namespace evwgh {
 
   private:
     std::map<std::string, Weight_t*> fWeightCalcMap; ///< A set of custom weight calculators
+    unsigned int fNThreads{1}; ///< Threads running the calculators (0: no limit)
     bool _configured{false}; ///< Readiness flag
     std::string _name; ///< Name
   };
@@ -92,6 +124,7 @@ namespace evwgh {
 
     // Loop over all the functions and register them
     auto const module_label = p.get<std::string>("module_label");
+    fNThreads = p.get<unsigned int>("weight_threads", 1);
     for (auto const& func : rw_func) {
       auto const ps_func = p.get<fhicl::ParameterSet>(func);
       std::string func_type = ps_func.get<std::string>("type");
@@ -106,12 +139,7 @@ namespace evwgh {
       CLHEP::HepRandomEngine& engine = seedservice->createEngine(module, "HepJamesRandom", func, ps_func, "random_seed");
       wcalc->SetName(func);
       wcalc->Configure(p, engine);
-      Weight_t* winfo=new Weight_t();
-      winfo->fWeightCalcType=func_type;
-      winfo->fWeightCalc=wcalc;
-      winfo->fNmultisims=ps_func.get<int>("number_of_multisims");
-
-      fWeightCalcMap.emplace(func, winfo);
+      AddWeightCalc(func, func_type, wcalc, ps_func.get<int>("number_of_multisims"));
 }
 
     _configured = true;
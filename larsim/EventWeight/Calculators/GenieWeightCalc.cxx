@@ -13,12 +13,17 @@
 
 #include "CLHEP/Random/RandGaussQ.h"
 
+#include "nugen/EventGeneratorBase/GENIE/GENIE2ART.h"
 #include "nugen/NuReweight/art/NuReweight.h" //GENIEReweight.h"
 
+#include "Framework/EventGen/EventRecord.h"
+
 #include "nusimdata/SimulationBase/MCFlux.h"
 #include "nusimdata/SimulationBase/MCTruth.h"
 #include "nusimdata/SimulationBase/GTruth.h"
 
+#include <memory>
+
 namespace evwgh {
   class GenieWeightCalc : public WeightCalc
   {
@@ -28,6 +33,9 @@ namespace evwgh {
                    CLHEP::HepRandomEngine& engine) override;
     std::vector<std::vector<double> > GetWeight(art::Event & e) override;
 
+    // GENIE reweighting uses global state (e.g. the particle database)
+    bool IsThreadSafe() const override { return false; }
+
   private:
     // The reweighting utility class:
     std::vector<rwgt::NuReweight> reweightVector;
@@ -359,10 +367,14 @@ namespace evwgh {
     std::vector<std::vector<double> >weight(mclist.size());
     for ( unsigned int inu=0; inu<mclist.size();inu++) {
       weight[inu].resize(reweightVector.size());
+      // NuReweight::CalcWeight() would rebuild the GENIE record for each
+      // universe: convert the interaction once and reweight that record
+      std::unique_ptr<genie::EventRecord> const record
+        { evgb::RetrieveGHEP(*mclist[inu], *glist[inu]) };
       for (unsigned int i_weight = 0;
 	   i_weight < reweightVector.size();
 	   i_weight ++){
-        weight[inu][i_weight]= reweightVector[i_weight].CalcWeight(*mclist[inu],*glist[inu]);
+        weight[inu][i_weight]= reweightVector[i_weight].CalculateWeight(*record);
       }
     }
     return weight;
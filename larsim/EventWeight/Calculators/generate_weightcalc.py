@@ -58,6 +58,9 @@ namespace evwgh {
        %(funcname)sWeightCalc();
        void Configure(fhicl::ParameterSet const& p);
        std::vector<std::vector<double> > GetWeight(art::Event & e);
+       // return true only if GetWeight() can run concurrently with the
+       // other calculators (no shared or global state is modified)
+       bool IsThreadSafe() const override { return false; }
      private:
        CLHEP::RandGaussQ *fGaussRandom;
        
@@ -17,16 +17,24 @@
 //
 // 10/28/2019 Wenqiang Gu (wgu@bnl.gov)
 //            Add the Space Charge Effect (SCE) if the option is enabled
+//
+// Deposits whose charge and light can't arrive in the readout window can be
+// dropped, configured by the optional "DepositTimeWindow" table (see
+// sim::DepositTimeWindow); the default maximum delay is the longest of the
+// drift time (plus 10%) and of the scintillation light delay.
 ////////////////////////////////////////////////////////////////////////
 
 // LArSoft includes
 #include "larcore/CoreUtils/ServiceUtil.h"
+#include "larcore/Geometry/Geometry.h"
+#include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardataobj/Simulation/SimEnergyDeposit.h"
 #include "larevt/SpaceChargeServices/SpaceChargeService.h"
 #include "larsim/IonizationScintillation/ISCalc.h"
 #include "larsim/IonizationScintillation/ISCalcCorrelated.h"
 #include "larsim/IonizationScintillation/ISCalcNESTLAr.h"
 #include "larsim/IonizationScintillation/ISCalcSeparate.h"
+#include "larsim/Simulation/DepositTimeWindow.h"
 #include "nurandom/RandomUtils/NuRandomService.h"
 
 // Framework includes
@@ -37,6 +45,7 @@
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "fhiclcpp/ParameterSet.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream> // std::stringstream, std::stringbuf
 #include <stdio.h>
@@ -59,6 +68,7 @@ namespace larg4 {
     string Instances;
     std::vector<string> instanceNames;
     bool fSavePriorSCE;
+    sim::DepositTimeWindow fTimeWindow; // drops deposits out of the readout window
   };
 
   //......................................................................
@@ -71,6 +81,7 @@ namespace larg4 {
         pset.get<string>("Instances", "LArG4DetectorServicevolTPCActive"),
       }
     , fSavePriorSCE{pset.get<bool>("SavePriorSCE",  false)}
+    , fTimeWindow{pset.get<fhicl::ParameterSet>("DepositTimeWindow", fhicl::ParameterSet{})}
   {
     std::cout << "IonAndScint Module Construct" << std::endl;
 
@@ -113,6 +124,16 @@ namespace larg4 {
       fISAlg = std::make_unique<ISCalcNESTLAr>(fEngine);
     else
       mf::LogWarning("IonAndScint") << "No ISCalculation set, this can't be good.";
+
+    // the deposits feed both the charge and the light simulation
+    if (fTimeWindow.Enabled()) {
+      auto const detProp =
+        art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataForJob();
+      art::ServiceHandle<geo::Geometry const> geom;
+      fTimeWindow.SetDefaultMaxDelay(
+        std::max(1.1 * sim::DepositTimeWindow::MaxDriftTime(*geom, detProp),
+                 sim::DepositTimeWindow::DefaultLightDelay));
+    }
   }
 
   //......................................................................
@@ -120,6 +141,7 @@ namespace larg4 {
   IonAndScint::endJob()
   {
     std::cout << "IonAndScint endJob." << std::endl;
+    fTimeWindow.PrintSummary("IonAndScint");
   }
 
   //......................................................................
@@ -137,8 +159,11 @@ namespace larg4 {
     }
 
     auto sce = lar::providerFrom<spacecharge::SpaceChargeService>();
+    auto const clockData =
+      art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(event);
     auto const detProp =
-      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(event);
+      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(event, clockData);
+    fTimeWindow.SetEvent(clockData, detProp);
 
     auto simedep = std::make_unique<std::vector<sim::SimEnergyDeposit>>();
     auto simedep1 = std::make_unique<std::vector<sim::SimEnergyDeposit>>(); // for prior-SCE depos
@@ -161,6 +186,8 @@ namespace larg4 {
                 << ", instance name: " << edeps.provenance()->productInstanceName() << std::endl;
 
       for (sim::SimEnergyDeposit const& edepi : *edeps) {
+        if (!fTimeWindow.Accept(edepi)) continue;
+
         auto const isCalcData = fISAlg->CalcIonAndScint(detProp, edepi);
 
         int ph_num = round(isCalcData.numPhotons);
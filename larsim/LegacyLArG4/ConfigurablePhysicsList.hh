@@ -17,6 +17,13 @@
 // using the name by which the builder will be referenced in the config
 // file.  Physics builders to be enabled are specified in the LArG4 config.
 //
+// Regions of the detector (e.g. rock, cryostat walls) can be given their
+// own production cuts and user limits (ProductionRegions parameter of
+// LArG4Parameters); they are created in SetCuts(). Electromagnetic showers
+// can also be parameterized in them (EMShowerParameterization).
+// A region includes all the daughters of its volumes: volumes containing
+// a TPC active volume are rejected, so that the active LAr keeps the
+// default cuts.
 //
 
 #ifndef TConfigurablePhysicsList_h
@@ -26,6 +33,8 @@
 #include "Geant4/G4VModularPhysicsList.hh"
 #include "Geant4/globals.hh"
 
+class G4LogicalVolume;
+
 namespace larg4 {
 
   template <class T>
@@ -37,6 +46,13 @@ namespace larg4 {
     std::vector<std::string> EnabledPhysics;
     std::vector<std::string> GetDefaultSettings();
     virtual void SetCuts();
+
+  private:
+    /// Creates the regions configured in `sim::LArG4Parameters`, with their cuts and limits.
+    void SetRegionCuts();
+
+    /// Returns the first TPC active volume among the descendents of `volume` (or `volume`).
+    static G4LogicalVolume const* FindActiveVolume(G4LogicalVolume const& volume);
   };
 
 }
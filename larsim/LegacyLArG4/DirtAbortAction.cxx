@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  DirtAbortAction.cxx
+/// \brief Abort Geant4 events whose particles can't reach the detector.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include "larsim/LegacyLArG4/DirtAbortAction.h"
+
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include "Geant4/G4Event.hh"
+#include "Geant4/G4OpticalPhoton.hh"
+#include "Geant4/G4ParticleDefinition.hh"
+#include "Geant4/G4RunManager.hh"
+#include "Geant4/G4Step.hh"
+#include "Geant4/G4StepPoint.hh"
+#include "Geant4/G4SystemOfUnits.hh"
+#include "Geant4/G4ThreeVector.hh"
+#include "Geant4/G4Track.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+namespace larg4 {
+
+  //----------------------------------------------------------------------------
+  DirtAbortAction::DirtAbortAction(std::vector<geo::BoxBoundedGeo> volumes, Reach_t const& reach)
+    : fVolumes(std::move(volumes)), fReach(reach)
+  {}
+
+  //----------------------------------------------------------------------------
+  void
+  DirtAbortAction::BeginOfEventAction(const G4Event*)
+  {
+    // the primary particles are stacked (and classified) after this call
+    fReached = false;
+    fAborted = false;
+    fPending.clear();
+  }
+
+  //----------------------------------------------------------------------------
+  void
+  DirtAbortAction::TrackClassified(G4Track const& track,
+                                   G4ClassificationOfNewTrack classification)
+  {
+    if (fReached || fAborted) return;
+
+    // postponed tracks belong to the next event;
+    // primaries are all assumed to be able to reach until they are tracked
+    bool const stacked = (classification == fUrgent) || (classification == fWaiting);
+    fPending.classified(
+      track.GetTrackID(), stacked, (track.GetParentID() == 0) || MayReach(track));
+  }
+
+  //----------------------------------------------------------------------------
+  void
+  DirtAbortAction::PreTrackingAction(const G4Track* track)
+  {
+    if (fReached || fAborted) return;
+
+    fPending.released(track->GetTrackID());
+
+    // the secondaries of a track which may reach are stacked after it ends,
+    // and the check is repeated at the start of the next track
+    if ((track->GetParentID() == 0) || MayReach(*track)) return;
+    AbortIfUnreachable();
+  }
+
+  //----------------------------------------------------------------------------
+  void
+  DirtAbortAction::SteppingAction(const G4Step* step)
+  {
+    if (fReached) return;
+
+    for (G4StepPoint const* point : {step->GetPreStepPoint(), step->GetPostStepPoint()}) {
+      G4ThreeVector const& pos = point->GetPosition();
+      if (!Contains(pos.x() / CLHEP::cm, pos.y() / CLHEP::cm, pos.z() / CLHEP::cm)) continue;
+      fReached = true;
+      return;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  bool
+  DirtAbortAction::Contains(double x, double y, double z) const
+  {
+    for (geo::BoxBoundedGeo const& volume : fVolumes)
+      if (volume.ContainsPosition(geo::Point_t{x, y, z})) return true;
+    return false;
+  }
+
+  //----------------------------------------------------------------------------
+  bool
+  DirtAbortAction::MayReach(G4Track const& track) const
+  {
+    G4ParticleDefinition const* def = track.GetDefinition();
+    if (def == G4OpticalPhoton::OpticalPhotonDefinition()) return false;
+    switch (std::abs(def->GetPDGEncoding())) {
+    case 12:
+    case 14:
+    case 16: return false; // neutrinos
+    default: break;
+    }
+
+    double const reach = fReach.margin + ((def->GetPDGCharge() != 0.) ?
+                                            fReach.chargedPerGeV * track.GetKineticEnergy() / CLHEP::GeV :
+                                            fReach.neutral);
+
+    // distance from the closest volume
+    G4ThreeVector const& pos = track.GetPosition();
+    double const point[3] = {pos.x() / CLHEP::cm, pos.y() / CLHEP::cm, pos.z() / CLHEP::cm};
+    for (geo::BoxBoundedGeo const& volume : fVolumes) {
+      double const min[3] = {volume.MinX(), volume.MinY(), volume.MinZ()};
+      double const max[3] = {volume.MaxX(), volume.MaxY(), volume.MaxZ()};
+      double d2 = 0.;
+      for (int i = 0; i < 3; ++i) {
+        double const d = std::max({min[i] - point[i], 0., point[i] - max[i]});
+        d2 += d * d;
+      }
+      if (d2 <= reach * reach) return true;
+    }
+    return false;
+  }
+
+  //----------------------------------------------------------------------------
+  void
+  DirtAbortAction::AbortIfUnreachable()
+  {
+    if (!fPending.empty()) return;
+
+    MF_LOG_DEBUG("DirtAbortAction")
+      << "No particle may reach the volumes of interest: aborting the event.";
+    fAborted = true;
+    G4RunManager::GetRunManager()->AbortEvent();
+  }
+
+  //----------------------------------------------------------------------------
+  DirtAbortStackingAction::DirtAbortStackingAction(DirtAbortAction& abortAction,
+                                                   std::unique_ptr<G4UserStackingAction> stacking)
+    : fAbortAction(abortAction), fStacking(std::move(stacking))
+  {}
+
+  //----------------------------------------------------------------------------
+  G4ClassificationOfNewTrack
+  DirtAbortStackingAction::ClassifyNewTrack(const G4Track* track)
+  {
+    G4ClassificationOfNewTrack const classification =
+      fStacking ? fStacking->ClassifyNewTrack(track) : fUrgent;
+    fAbortAction.TrackClassified(*track, classification);
+    return classification;
+  }
+
+  //----------------------------------------------------------------------------
+  void
+  DirtAbortStackingAction::NewStage()
+  {
+    // the wrapped action may reclassify the stacked tracks via the manager
+    if (fStacking) fStacking->NewStage();
+  }
+
+  //----------------------------------------------------------------------------
+  void
+  DirtAbortStackingAction::PrepareNewEvent()
+  {
+    if (!fStacking) return;
+    // the stack manager is assigned to this action only
+    fStacking->SetStackManager(stackManager);
+    fStacking->PrepareNewEvent();
+  }
+
+} // namespace larg4
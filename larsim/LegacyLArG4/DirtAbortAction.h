@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  DirtAbortAction.h
+/// \brief Abort Geant4 events whose particles can't reach the detector.
+///
+////////////////////////////////////////////////////////////////////////
+
+/// This class implements the g4b::UserAction interface to stop the
+/// simulation of interactions (typically neutrino interactions in the rock,
+/// "dirt") as soon as it is clear that none of their particles will reach
+/// the volumes of interest.
+///
+/// A particle is deemed able to reach the volumes if its distance from them
+/// is within its reach: a fixed margin plus, for charged particles, a range
+/// proportional to its kinetic energy, or a fixed reach for neutral ones.
+/// Neutrinos and optical photons never reach.
+///
+/// The action keeps track of the particles waiting on the Geant4 stacks
+/// which may reach the volumes; when none is left and nothing has entered
+/// the volumes yet, the event is aborted. The remaining stacked particles
+/// are not simulated, and `Aborted()` reports the event as such.
+///
+/// Particles are recorded when they are classified by the stacking action,
+/// so that those killed by the classification are not waited for. This
+/// requires `DirtAbortStackingAction` to be the stacking action of the run
+/// manager; it wraps the stacking action which would be used otherwise.
+
+#ifndef LArG4_DirtAbortAction_h
+#define LArG4_DirtAbortAction_h
+
+#include "larcorealg/Geometry/BoxBoundedGeo.h"
+#include "larsim/LegacyLArG4/ReachingTrackCounter.h"
+#include "nug4/G4Base/UserAction.h"
+
+#include "Geant4/G4ClassificationOfNewTrack.hh"
+#include "Geant4/G4UserStackingAction.hh"
+
+#include <memory>
+#include <vector>
+
+// Forward declarations.
+class G4Event;
+class G4Step;
+class G4Track;
+
+namespace larg4 {
+
+  class DirtAbortAction : public g4b::UserAction {
+  public:
+    /// Parameters of the reach of particles.
+    struct Reach_t {
+      double margin = 100.;           ///< reach of all particles [cm]
+      double chargedPerGeV = 500.;    ///< additional reach of charged particles [cm/GeV]
+      double neutral = 300.;          ///< additional reach of neutral particles [cm]
+    };
+
+    /**
+     * @brief Constructor.
+     * @param volumes the volumes particles must reach
+     * @param reach parameters of the reach of particles
+     */
+    DirtAbortAction(std::vector<geo::BoxBoundedGeo> volumes, Reach_t const& reach);
+
+    // UserActions method that we'll override, to obtain access to
+    // Geant4's events, tracks and steps
+    virtual void BeginOfEventAction(const G4Event*);
+    virtual void PreTrackingAction(const G4Track*);
+    virtual void SteppingAction(const G4Step*);
+
+    /// Records the stacking `classification` of a new or stacked `track`.
+    void TrackClassified(G4Track const& track, G4ClassificationOfNewTrack classification);
+
+    /// Returns whether the last event was aborted.
+    bool
+    Aborted() const
+    {
+      return fAborted;
+    }
+
+    /// Returns whether any particle of the last event entered the volumes.
+    bool
+    Reached() const
+    {
+      return fReached;
+    }
+
+  private:
+    std::vector<geo::BoxBoundedGeo> const fVolumes;
+    Reach_t const fReach;
+
+    bool fReached = false;              ///< whether a particle entered the volumes
+    bool fAborted = false;              ///< whether the event has been aborted
+    ReachingTrackCounter fPending; ///< stacked particles which may reach
+
+    /// Returns whether the point [cm] is in any of the volumes.
+    bool Contains(double x, double y, double z) const;
+
+    /// Returns whether the particle of the `track` may reach the volumes.
+    bool MayReach(G4Track const& track) const;
+
+    /// Aborts the event if no stacked particle may reach the volumes.
+    void AbortIfUnreachable();
+  };
+
+  /// Stacking action reporting all the classifications to a `DirtAbortAction`.
+  class DirtAbortStackingAction : public G4UserStackingAction {
+  public:
+    /**
+     * @brief Constructor.
+     * @param abortAction the action to report the classifications to
+     * @param stacking the stacking action to classify with (none: all urgent)
+     */
+    DirtAbortStackingAction(DirtAbortAction& abortAction,
+                            std::unique_ptr<G4UserStackingAction> stacking = nullptr);
+
+    G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track) override;
+    void NewStage() override;
+    void PrepareNewEvent() override;
+
+  private:
+    DirtAbortAction& fAbortAction;                    ///< action to report to
+    std::unique_ptr<G4UserStackingAction> fStacking; ///< wrapped stacking action
+  };
+
+} // namespace larg4
+
+#endif // LArG4_DirtAbortAction_h
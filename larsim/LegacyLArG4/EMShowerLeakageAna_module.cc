@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  EMShowerLeakageAna_module.cc
+/// \brief Energy flowing into the TPC active volumes, for the validation
+///        of the parameterized electromagnetic showers.
+///
+////////////////////////////////////////////////////////////////////////
+
+/// This analyzer records the particles which enter a TPC active volume
+/// from outside, with the point where they enter it and their kinetic
+/// energy there. Running it on the same sample simulated with and without
+/// `FastEMShowerMinEnergy` (see `EMShowerParameterization`) compares the
+/// leakage of the parameterized showers with the one of the full
+/// simulation: `emshowerleakage_full.fcl` and `emshowerleakage_fast.fcl`
+/// are the two jobs.
+///
+/// The trajectories of all the particles are needed: LArG4 must run with
+/// `KeepEMShowerDaughters`, `StoreTrajectories` and a zero
+/// `ParticleKineticEnergyCut`.
+///
+/// Configuration parameters:
+/// - *ParticleLabel* (input tag, default: `"largeant"`): the particles
+/// - *MaxLeakage* (real, default: `1`): upper limit of the energy
+///   histograms [GeV]
+
+// Framework includes
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "art_root_io/TFileService.h"
+#include "canvas/Utilities/InputTag.h"
+#include "fhiclcpp/ParameterSet.h"
+
+// LArSoft includes
+#include "larcore/Geometry/Geometry.h"
+#include "larcorealg/Geometry/BoxBoundedGeo.h"
+#include "nusimdata/SimulationBase/MCParticle.h"
+
+// ROOT includes
+#include "TH1.h"
+#include "TLorentzVector.h"
+#include "TTree.h"
+
+// C++ includes
+#include <vector>
+
+namespace larg4 {
+
+  class EMShowerLeakageAna : public art::EDAnalyzer {
+  public:
+    explicit EMShowerLeakageAna(fhicl::ParameterSet const& pset);
+
+    void beginJob() override;
+    void analyze(art::Event const& evt) override;
+
+  private:
+    art::InputTag const fParticleLabel; ///< particles from the simulation
+    double const fMaxLeakage;           ///< upper limit of the histograms [GeV]
+
+    std::vector<geo::BoxBoundedGeo> fActiveVolumes;
+
+    TH1D* fLeakage = nullptr;     ///< energy entering the volumes per event
+    TH1D* fEntryEnergy = nullptr; ///< kinetic energy of the entering particles
+    TH1D* fEntryX = nullptr;      ///< entry points, weighted by energy
+    TH1D* fEntryY = nullptr;
+    TH1D* fEntryZ = nullptr;
+
+    TTree* fTree = nullptr; ///< one entry per entering particle
+    Int_t fTEvent;
+    Int_t fTPdg;
+    Float_t fTEnergy;
+    Float_t fTEntry[3];
+
+    /// Returns whether the point [cm] is in any of the active volumes.
+    bool IsActive(TLorentzVector const& pos) const;
+  };
+
+  //----------------------------------------------------------------------------
+  EMShowerLeakageAna::EMShowerLeakageAna(fhicl::ParameterSet const& pset)
+    : EDAnalyzer(pset)
+    , fParticleLabel{pset.get<art::InputTag>("ParticleLabel", "largeant")}
+    , fMaxLeakage{pset.get<double>("MaxLeakage", 1.)}
+  {}
+
+  //----------------------------------------------------------------------------
+  void
+  EMShowerLeakageAna::beginJob()
+  {
+    art::ServiceHandle<geo::Geometry const> geom;
+    for (geo::TPCGeo const& tpc : geom->IterateTPCs())
+      fActiveVolumes.push_back(tpc.ActiveBoundingBox());
+
+    // the entry points span the active volumes
+    geo::BoxBoundedGeo box = fActiveVolumes.front();
+    for (geo::BoxBoundedGeo const& volume : fActiveVolumes)
+      box.ExtendToInclude(volume);
+
+    art::ServiceHandle<art::TFileService const> tfs;
+    fLeakage = tfs->make<TH1D>(
+      "leakage", "Energy entering the active volumes;energy [GeV];events", 200, 0., fMaxLeakage);
+    fEntryEnergy = tfs->make<TH1D>(
+      "entryEnergy", "Entering particles;kinetic energy [GeV];particles", 200, 0., fMaxLeakage);
+    fEntryX = tfs->make<TH1D>(
+      "entryX", "Entry points;x [cm];energy [GeV]", 200, box.MinX(), box.MaxX());
+    fEntryY = tfs->make<TH1D>(
+      "entryY", "Entry points;y [cm];energy [GeV]", 200, box.MinY(), box.MaxY());
+    fEntryZ = tfs->make<TH1D>(
+      "entryZ", "Entry points;z [cm];energy [GeV]", 200, box.MinZ(), box.MaxZ());
+
+    fTree = tfs->make<TTree>("entries", "Particles entering the active volumes");
+    fTree->Branch("event", &fTEvent, "event/I");
+    fTree->Branch("pdg", &fTPdg, "pdg/I");
+    fTree->Branch("energy", &fTEnergy, "energy/F");
+    fTree->Branch("entry", fTEntry, "entry[3]/F");
+  }
+
+  //----------------------------------------------------------------------------
+  void
+  EMShowerLeakageAna::analyze(art::Event const& evt)
+  {
+    auto const& particles = *evt.getValidHandle<std::vector<simb::MCParticle>>(fParticleLabel);
+
+    fTEvent = evt.event();
+    double leakage = 0.;
+    for (simb::MCParticle const& particle : particles) {
+      unsigned int const nPoints = particle.NumberTrajectoryPoints();
+      if ((nPoints == 0) || IsActive(particle.Position(0))) continue;
+
+      // the first trajectory point inside is where the particle enters
+      for (unsigned int i = 1; i < nPoints; ++i) {
+        TLorentzVector const& pos = particle.Position(i);
+        if (!IsActive(pos)) continue;
+
+        double const energy = particle.E(i) - particle.Mass();
+        leakage += energy;
+        fEntryEnergy->Fill(energy);
+        fEntryX->Fill(pos.X(), energy);
+        fEntryY->Fill(pos.Y(), energy);
+        fEntryZ->Fill(pos.Z(), energy);
+
+        fTPdg = particle.PdgCode();
+        fTEnergy = energy;
+        fTEntry[0] = pos.X();
+        fTEntry[1] = pos.Y();
+        fTEntry[2] = pos.Z();
+        fTree->Fill();
+        break;
+      }
+    }
+    fLeakage->Fill(leakage);
+  }
+
+  //----------------------------------------------------------------------------
+  bool
+  EMShowerLeakageAna::IsActive(TLorentzVector const& pos) const
+  {
+    geo::Point_t const point{pos.X(), pos.Y(), pos.Z()};
+    for (geo::BoxBoundedGeo const& volume : fActiveVolumes)
+      if (volume.ContainsPosition(point)) return true;
+    return false;
+  }
+
+} // namespace larg4
+
+DEFINE_ART_MODULE(larg4::EMShowerLeakageAna)
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  EMShowerParameterization.cxx
+/// \brief Parameterized electromagnetic showers in non-active material.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include "larsim/LegacyLArG4/EMShowerParameterization.h"
+#include "larsim/LegacyLArG4/EMShowerProfile.h"
+
+#include "Geant4/G4DynamicParticle.hh"
+#include "Geant4/G4Electron.hh"
+#include "Geant4/G4FastStep.hh"
+#include "Geant4/G4FastTrack.hh"
+#include "Geant4/G4Gamma.hh"
+#include "Geant4/G4LogicalVolume.hh"
+#include "Geant4/G4Material.hh"
+#include "Geant4/G4Navigator.hh"
+#include "Geant4/G4PhysicalConstants.hh"
+#include "Geant4/G4Positron.hh"
+#include "Geant4/G4Track.hh"
+#include "Geant4/G4TransportationManager.hh"
+#include "Geant4/G4VPhysicalVolume.hh"
+
+namespace {
+
+  /// Largest number of volumes crossed by a shower axis.
+  constexpr unsigned int MaxVolumeCrossings = 1000U;
+
+} // local namespace
+
+namespace larg4 {
+
+  //----------------------------------------------------------------------------
+  EMShowerParameterization::EMShowerParameterization(G4String const& name,
+                                                     G4Region* region,
+                                                     G4double minEnergy,
+                                                     G4double minLeakage)
+    : G4VFastSimulationModel(name, region), fMinEnergy{minEnergy}, fMinLeakage{minLeakage}
+  {}
+
+  //----------------------------------------------------------------------------
+  EMShowerParameterization::~EMShowerParameterization() = default;
+
+  //----------------------------------------------------------------------------
+  G4bool
+  EMShowerParameterization::IsApplicable(G4ParticleDefinition const& particle)
+  {
+    return (&particle == G4Electron::ElectronDefinition()) ||
+           (&particle == G4Positron::PositronDefinition()) ||
+           (&particle == G4Gamma::GammaDefinition());
+  }
+
+  //----------------------------------------------------------------------------
+  G4bool
+  EMShowerParameterization::ModelTrigger(G4FastTrack const& fastTrack)
+  {
+    G4Track const* track = fastTrack.GetPrimaryTrack();
+    if (track->GetKineticEnergy() < fMinEnergy) return false;
+    // showers in argon (e.g. around the active volume) are fully simulated,
+    // with their scintillation
+    return !IsActive(track->GetVolume()) && !IsArgon(track->GetMaterial());
+  }
+
+  //----------------------------------------------------------------------------
+  void
+  EMShowerParameterization::DoIt(G4FastTrack const& fastTrack, G4FastStep& fastStep)
+  {
+    G4Track const* track = fastTrack.GetPrimaryTrack();
+    G4double const energy = track->GetKineticEnergy();
+    G4ThreeVector const dir = track->GetMomentumDirection();
+
+    G4Material const* material = track->GetMaterial();
+    G4double const Z = material->GetTotNbOfElectPerVolume() / material->GetTotNbOfAtomsPerVolume();
+    EMShowerProfile const profile(energy / CLHEP::MeV,
+                                  EMShowerProfile::criticalEnergy(Z),
+                                  track->GetDefinition() == G4Gamma::GammaDefinition());
+
+    if (!fNavigator) {
+      fNavigator = std::make_unique<G4Navigator>();
+      fNavigator->SetWorldVolume(G4TransportationManager::GetTransportationManager()
+                                   ->GetNavigatorForTracking()
+                                   ->GetWorldVolume());
+    }
+
+    // follow the shower axis until it enters an active volume
+    G4ThreeVector pos = track->GetPosition();
+    G4double depth = 0.;  // radiation lengths
+    G4double length = 0.; // path length
+    G4double leakage = 0.;
+    G4VPhysicalVolume const* volume = fNavigator->LocateGlobalPointAndSetup(pos, &dir, false);
+    for (unsigned int crossing = 0; volume && (crossing < MaxVolumeCrossings); ++crossing) {
+      if (IsActive(volume)) {
+        leakage = energy * profile.leakageFraction(depth);
+        break;
+      }
+      if (energy * profile.leakageFraction(depth) < fMinLeakage) break;
+
+      G4double safety = 0.;
+      G4double const step = fNavigator->ComputeStep(pos, dir, kInfinity, safety);
+      if (step >= kInfinity) break;
+
+      depth += step / volume->GetLogicalVolume()->GetMaterial()->GetRadlen();
+      length += step;
+      pos += step * dir;
+      fNavigator->SetGeometricallyLimitedStep();
+      volume = fNavigator->LocateGlobalPointAndSetup(pos, &dir, true);
+    }
+    if (leakage < fMinLeakage) leakage = 0.;
+
+    fastStep.KillPrimaryTrack();
+    fastStep.ProposePrimaryTrackPathLength(0.);
+    fastStep.ProposeTotalEnergyDeposited(energy - leakage);
+    if (leakage > 0.) {
+      fastStep.SetNumberOfSecondaryTracks(1);
+      G4double const time = track->GetGlobalTime() + length / CLHEP::c_light;
+      fastStep.CreateSecondaryTrack(
+        G4DynamicParticle(G4Gamma::GammaDefinition(), dir, leakage), pos, time, false);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  bool
+  EMShowerParameterization::IsActive(G4VPhysicalVolume const* volume)
+  {
+    return volume && volume->GetName().contains("volTPCActive");
+  }
+
+  //----------------------------------------------------------------------------
+  bool
+  EMShowerParameterization::IsArgon(G4Material const* material)
+  {
+    // G4Material::GetZ() is only allowed for single element materials
+    return material && (material->GetNumberOfElements() == 1) && (material->GetZ() == 18.);
+  }
+
+} // namespace larg4
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  EMShowerParameterization.h
+/// \brief Parameterized electromagnetic showers in non-active material.
+///
+////////////////////////////////////////////////////////////////////////
+
+/// This Geant4 fast simulation model replaces the cascade of an electron,
+/// positron or photon above a threshold energy with the average longitudinal
+/// profile of its shower (see `EMShowerProfile`), instead of tracking all
+/// the shower particles down to the production cut. It is attached to the
+/// regions with `FastEMShowerMinEnergy` set (see `ProductionRegions` in
+/// `sim::LArG4Parameters`), typically rock, concrete and cryostat walls.
+/// Showers are never parameterized in argon, even if the region includes
+/// some, so that the LAr outside the active volumes keeps its full
+/// simulation and scintillation.
+///
+/// The shower axis is followed through the geometry, accumulating the depth
+/// in radiation lengths of each material crossed, until it enters an active
+/// TPC volume. The energy the profile leaks past that depth is emitted there
+/// as a single photon along the axis, if it is above a threshold; the rest
+/// is deposited where the shower starts. Showers whose axis leaves the world
+/// or runs out of energy deposit all their energy. Lateral spread and the
+/// fluctuations of the profile are not modelled.
+///
+/// This model is experimental and not part of any standard configuration:
+/// `EMShowerLeakageAna`, with the jobs `emshowerleakage_full.fcl` and
+/// `emshowerleakage_fast.fcl`, compares the energy and the entry points of
+/// its leakage with the full simulation, and that comparison has not been
+/// recorded yet.
+
+#ifndef LArG4_EMShowerParameterization_h
+#define LArG4_EMShowerParameterization_h
+
+#include "Geant4/G4VFastSimulationModel.hh"
+
+#include <memory>
+
+// Forward declarations.
+class G4Material;
+class G4Navigator;
+class G4Region;
+class G4VPhysicalVolume;
+
+namespace larg4 {
+
+  class EMShowerParameterization : public G4VFastSimulationModel {
+  public:
+    /**
+     * @brief Constructor: attaches the model to a region.
+     * @param name name of the model
+     * @param region the region where showers are parameterized
+     * @param minEnergy particles below this kinetic energy are simulated [MeV]
+     * @param minLeakage leaking energy below this is not emitted [MeV]
+     */
+    EMShowerParameterization(G4String const& name,
+                             G4Region* region,
+                             G4double minEnergy,
+                             G4double minLeakage);
+    ~EMShowerParameterization();
+
+    G4bool IsApplicable(G4ParticleDefinition const& particle) override;
+    G4bool ModelTrigger(G4FastTrack const& fastTrack) override;
+    void DoIt(G4FastTrack const& fastTrack, G4FastStep& fastStep) override;
+
+  private:
+    G4double fMinEnergy;  ///< smallest kinetic energy of parameterized particles
+    G4double fMinLeakage; ///< smallest leaking energy emitted
+
+    std::unique_ptr<G4Navigator> fNavigator; ///< navigator following the shower axes
+
+    /// Whether `volume` is an active TPC volume.
+    static bool IsActive(G4VPhysicalVolume const* volume);
+
+    /// Whether `material` is argon (liquid or gaseous).
+    static bool IsArgon(G4Material const* material);
+  };
+
+} // namespace larg4
+
+#endif // LArG4_EMShowerParameterization_h
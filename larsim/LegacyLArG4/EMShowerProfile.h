@@ -0,0 +1,120 @@
+/**
+ * @file   larsim/LegacyLArG4/EMShowerProfile.h
+ * @brief  Average longitudinal profile of electromagnetic showers.
+ * @see    larsim/LegacyLArG4/EMShowerParameterization.h
+ *
+ * The energy deposited by a shower of energy `E` at depth `t` (in radiation
+ * lengths) is described by a gamma distribution (Longo and Sestili):
+ *
+ *     dE/dt = E b (b t)^(a-1) exp(-b t) / Gamma(a)
+ *
+ * with `b` about 0.5 and the maximum at `tmax = (a-1)/b = ln(E/Ec) + C`,
+ * where `Ec` is the critical energy of the material, and `C` is -0.5 for
+ * showers started by electrons and +0.5 for the ones started by photons
+ * (Review of Particle Physics, "Passage of particles through matter").
+ *
+ * This is a header-only library.
+ */
+
+#ifndef LARSIM_LEGACYLARG4_EMSHOWERPROFILE_H
+#define LARSIM_LEGACYLARG4_EMSHOWERPROFILE_H
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace larg4 {
+
+  class EMShowerProfile {
+  public:
+    /**
+     * @brief Constructor.
+     * @param energy energy of the particle starting the shower
+     * @param criticalEnergy critical energy of the material (same unit)
+     * @param photon whether the shower is started by a photon
+     * @param b scale parameter of the profile
+     */
+    EMShowerProfile(double energy, double criticalEnergy, bool photon, double b = 0.5)
+      : fB{b}
+    {
+      double const tmax = std::log(energy / criticalEnergy) + (photon ? 0.5 : -0.5);
+      fA = 1.0 + fB * std::max(tmax, 0.0); // below Ec the profile is exponential
+    }
+
+    /// Shape parameter `a` of the profile.
+    double
+    shapeA() const
+    {
+      return fA;
+    }
+
+    /// Depth of the maximum of the profile [radiation lengths].
+    double
+    maximumDepth() const
+    {
+      return (fA - 1.0) / fB;
+    }
+
+    /// Fraction of the energy deposited beyond `depth` [radiation lengths].
+    double
+    leakageFraction(double depth) const
+    {
+      return (depth <= 0.0) ? 1.0 : 1.0 - regularizedGammaP(fA, fB * depth);
+    }
+
+    /// Critical energy [MeV] of a liquid or solid with mean atomic number `Z`.
+    static double
+    criticalEnergy(double Z)
+    {
+      return 610.0 / (Z + 1.24);
+    }
+
+    /// Regularized lower incomplete gamma function `P(a, x)`.
+    static double
+    regularizedGammaP(double a, double x)
+    {
+      if (x <= 0.0) return 0.0;
+      double const logPrefactor = a * std::log(x) - x - std::lgamma(a);
+      if (x < a + 1.0) {
+        // series expansion
+        double term = 1.0 / a;
+        double sum = term;
+        for (double n = 1.0; n < 1000.0; n += 1.0) {
+          term *= x / (a + n);
+          sum += term;
+          if (std::abs(term) < std::abs(sum) * Epsilon) break;
+        }
+        return sum * std::exp(logPrefactor);
+      }
+      // continued fraction for Q(a, x) (modified Lentz method)
+      double b = x + 1.0 - a;
+      double c = 1.0 / Tiny;
+      double d = 1.0 / b;
+      double h = d;
+      for (double n = 1.0; n < 1000.0; n += 1.0) {
+        double const an = -n * (n - a);
+        b += 2.0;
+        d = an * d + b;
+        if (std::abs(d) < Tiny) d = Tiny;
+        c = b + an / c;
+        if (std::abs(c) < Tiny) c = Tiny;
+        d = 1.0 / d;
+        double const delta = d * c;
+        h *= delta;
+        if (std::abs(delta - 1.0) < Epsilon) break;
+      }
+      return 1.0 - std::exp(logPrefactor) * h;
+    }
+
+  private:
+    static constexpr double Epsilon = 1e-12;
+    static constexpr double Tiny = std::numeric_limits<double>::min() / Epsilon;
+
+    double fA; ///< shape parameter
+    double fB; ///< scale parameter [1/radiation length]
+  }; // EMShowerProfile
+
+} // namespace larg4
+
+#endif // LARSIM_LEGACYLARG4_EMSHOWERPROFILE_H
@@ -8,7 +8,7 @@
 
 #include "Geant4/G4EmSaturation.hh"
 #include "Geant4/G4LossTableManager.hh"
-#include "Geant4/G4ParticleTypes.hh"
+#include "Geant4/G4Material.hh"
 
 #include "larcore/CoreUtils/ServiceUtil.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
@@ -118,58 +118,25 @@ namespace larg4 {
       << " recombination: " << fNumIonElectrons;
 
     // Now do the scintillation
-    G4MaterialPropertiesTable* mpt = step->GetTrack()->GetMaterial()->GetMaterialPropertiesTable();
-    if (!mpt)
+    G4Material const* material = step->GetTrack()->GetMaterial();
+    // the constants are read at the first step, after the material properties are loaded
+    if (!fScintProperties.Covers(material->GetIndex())) fScintProperties.Build();
+    ScintillationProperties::Material_t const& scintProps = fScintProperties[*material];
+    if (!scintProps.hasTable)
       throw cet::exception("ISCalculationSeparate")
         << "Cannot find materials property table"
-        << " for this step! " << step->GetTrack()->GetMaterial() << "\n";
+        << " for this step! " << material << "\n";
 
     // if not doing the scintillation by particle type, use the saturation
-    double scintYield = mpt->GetConstProperty("SCINTILLATIONYIELD");
+    double scintYield = scintProps.scintillationYield;
 
     if (fScintByParticleType) {
 
       MF_LOG_DEBUG("ISCalculationSeparate") << "scintillating by particle type";
 
-      // Get the definition of the current particle
-      G4ParticleDefinition* pDef = step->GetTrack()->GetDynamicParticle()->GetDefinition();
-
-      // Obtain the G4MaterialPropertyVectory containing the
-      // scintillation light yield as a function of the deposited
-      // energy for the current particle type
-
-      // Protons
-      if (pDef == G4Proton::ProtonDefinition()) {
-        scintYield = mpt->GetConstProperty("PROTONSCINTILLATIONYIELD");
-      }
-      // Muons
-      else if (pDef == G4MuonPlus::MuonPlusDefinition() ||
-               pDef == G4MuonMinus::MuonMinusDefinition()) {
-        scintYield = mpt->GetConstProperty("MUONSCINTILLATIONYIELD");
-      }
-      // Pions
-      else if (pDef == G4PionPlus::PionPlusDefinition() ||
-               pDef == G4PionMinus::PionMinusDefinition()) {
-        scintYield = mpt->GetConstProperty("PIONSCINTILLATIONYIELD");
-      }
-      // Kaons
-      else if (pDef == G4KaonPlus::KaonPlusDefinition() ||
-               pDef == G4KaonMinus::KaonMinusDefinition()) {
-        scintYield = mpt->GetConstProperty("KAONSCINTILLATIONYIELD");
-      }
-      // Alphas
-      else if (pDef == G4Alpha::AlphaDefinition()) {
-        scintYield = mpt->GetConstProperty("ALPHASCINTILLATIONYIELD");
-      }
-      // Electrons (must also account for shell-binding energy
-      // attributed to gamma from standard PhotoElectricEffect)
-      else if (pDef == G4Electron::ElectronDefinition() || pDef == G4Gamma::GammaDefinition()) {
-        scintYield = mpt->GetConstProperty("ELECTRONSCINTILLATIONYIELD");
-      }
-      // Default for particles not enumerated/listed above
-      else {
-        scintYield = mpt->GetConstProperty("ELECTRONSCINTILLATIONYIELD");
-      }
+      // Obtain the scintillation light yield for the current particle type
+      scintYield = scintProps.particleScintillationYield[ScintillationProperties::ParticleType(
+        step->GetTrack()->GetDynamicParticle()->GetDefinition())];
 
       // If the user has not specified yields for (p,d,t,a,carbon)
       // then these unspecified particles will default to the
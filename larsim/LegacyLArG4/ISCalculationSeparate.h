@@ -10,6 +10,7 @@
 #define LARG4_ISCALCULATIONSEPARATE_H
 
 #include "larsim/LegacyLArG4/ISCalculation.h"
+#include "larsim/LegacyLArG4/ScintillationProperties.h"
 
 // forward declarations
 class G4EmSaturation;
@@ -29,17 +30,18 @@ namespace larg4 {
     }
 
   private:
-    double fStepSize;              ///< maximum step to take
-    double fEfield;                ///< value of electric field from LArProperties service
-    double fGeVToElectrons;        ///< conversion factor from LArProperties service
-    double fRecombA;               ///< from LArG4Parameters service
-    double fRecombk;               ///< from LArG4Parameters service
-    double fModBoxA;               ///< from LArG4Parameters service
-    double fModBoxB;               ///< from LArG4Parameters service
-    bool fUseModBoxRecomb;         ///< from LArG4Parameters service
-    bool fScintByParticleType;     ///< from LArProperties service
-    double fScintYieldFactor;      ///< scintillation yield factor
-    G4EmSaturation* fEMSaturation; ///< pointer to EM saturation
+    double fStepSize;                         ///< maximum step to take
+    double fEfield;                           ///< value of electric field from LArProperties service
+    double fGeVToElectrons;                   ///< conversion factor from LArProperties service
+    double fRecombA;                          ///< from LArG4Parameters service
+    double fRecombk;                          ///< from LArG4Parameters service
+    double fModBoxA;                          ///< from LArG4Parameters service
+    double fModBoxB;                          ///< from LArG4Parameters service
+    bool fUseModBoxRecomb;                    ///< from LArG4Parameters service
+    bool fScintByParticleType;                ///< from LArProperties service
+    double fScintYieldFactor;                 ///< scintillation yield factor
+    G4EmSaturation* fEMSaturation;            ///< pointer to EM saturation
+    ScintillationProperties fScintProperties; ///< scintillation constants of each material
   };
 }
 #endif // LARG4_ISCALCULATIONSEPARATE_H
@@ -10,6 +10,7 @@
 #include "larsim/LegacyLArG4/ISCalculationNEST.h"
 #include "larsim/LegacyLArG4/ISCalculationSeparate.h"
 #include "larsim/Simulation/LArG4Parameters.h"
+#include "lardataalg/DetectorInfo/DetectorPropertiesData.h"
 
 // ROOT includes
 #include "TH1F.h"
@@ -18,24 +19,43 @@
 // Framework includes
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art_root_io/TFileService.h"
+#include "cetlib_except/exception.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 // C/C++ standard libraries
-#include <cassert>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "CLHEP/Units/SystemOfUnits.h"
+#include "Geant4/G4Material.hh"
 #include "Geant4/G4Step.hh"
+#include "Geant4/G4Track.hh"
 
 namespace larg4 {
 
-  static IonizationAndScintillation* gInstance = 0;
+  namespace {
+    // the calculator of each thread; they are all owned by gAllInstances
+    thread_local IonizationAndScintillation* gInstance = nullptr;
+
+    std::mutex gInstancesMutex;
+    std::vector<std::unique_ptr<IonizationAndScintillation>> gAllInstances;
+
+    // histograms are booked by the first calculator only
+    std::atomic<bool> gHistogramsBooked{false};
+  } // local namespace
 
   //......................................................................
   IonizationAndScintillation*
   IonizationAndScintillation::CreateInstance(detinfo::DetectorPropertiesData const& detProp,
                                              CLHEP::HepRandomEngine& engine)
   {
-    if (!gInstance) gInstance = new IonizationAndScintillation(detProp, engine);
+    if (gInstance) return gInstance;
+
+    std::lock_guard<std::mutex> lock(gInstancesMutex);
+    gAllInstances.emplace_back(new IonizationAndScintillation(detProp, engine));
+    gInstance = gAllInstances.back().get();
     return gInstance;
   }
 
@@ -43,9 +63,12 @@ namespace larg4 {
   IonizationAndScintillation*
   IonizationAndScintillation::Instance()
   {
-    // the instance must have been created already by CreateInstance()
-    assert(gInstance);
-    return gInstance;
+    if (gInstance) return gInstance;
+
+    // sharing another thread's calculator would share its random engine
+    throw cet::exception("IonizationAndScintillation")
+      << "No calculator in this thread: CreateInstance() must be called by each"
+         " thread, with its own random engine.\n";
   }
 
   //......................................................................
@@ -70,11 +93,19 @@ namespace larg4 {
     // Reset the values for the electrons, photons, and energy to 0
     // in the calculator
     fISCalc->Reset();
-    //set the current track and step number values to bogus so that it will run the first reset:
-    fStepNumber = -1;
-    fTrkID = -1;
 
-    // make the histograms
+    // the per-step histograms are a diagnostic; they cost a handful of
+    // Fill() calls for each step, so they are only made on request
+    // (TFileService is not thread-safe: only one calculator fills them)
+    fFillHistograms =
+      lgp->FillIonAndScintHistograms() && !gHistogramsBooked.exchange(true);
+    if (fFillHistograms) MakeHistograms();
+  }
+
+  //......................................................................
+  void
+  IonizationAndScintillation::MakeHistograms()
+  {
     art::ServiceHandle<art::TFileService const> tfs;
     fElectronsPerStep = tfs->make<TH1F>("electronsPerStep", ";Electrons;Steps", 500, 0., 5000.);
     fPhotonsPerStep = tfs->make<TH1F>("photonsPerStep", ";Photons;Steps", 500, 0., 5000.);
@@ -97,57 +128,73 @@ namespace larg4 {
   void
   IonizationAndScintillation::Reset(const G4Step* step)
   {
+    G4Track const* track = step->GetTrack();
+    int const stepNumber = track->GetCurrentStepNumber();
+    int const trackID = track->GetTrackID();
 
-    if (fStepNumber == step->GetTrack()->GetCurrentStepNumber() &&
-        fTrkID == step->GetTrack()->GetTrackID())
-      return;
+    if (fStepResult.stepNumber == stepNumber && fStepResult.trackID == trackID) return;
 
-    fStepNumber = step->GetTrack()->GetCurrentStepNumber();
-    fTrkID = step->GetTrack()->GetTrackID();
+    fStepResult = StepResult{};
+    fStepResult.stepNumber = stepNumber;
+    fStepResult.trackID = trackID;
 
     fStep = step;
 
     fISCalc->Reset();
 
-    // check the material for this step and be sure it is LAr
-    if (step->GetTrack()->GetMaterial()->GetName() != "LAr") return;
+    // check the material for this step and be sure it is LAr;
+    // the material table is complete by the time the first step is taken
+    if (!fLArMaterialResolved) {
+      fLArMaterial = G4Material::GetMaterial("LAr", false);
+      fLArMaterialResolved = true;
+    }
+    if (!fLArMaterial || track->GetMaterial() != fLArMaterial) return;
 
     // double check that the energy deposit is non-zero
     // then do the calculation if it is
-    if (step->GetTotalEnergyDeposit() > 0) {
-
-      fISCalc->CalculateIonizationAndScintillation(fStep);
-
-      MF_LOG_DEBUG("IonizationAndScintillation")
-        << "Step Size: " << fStep->GetStepLength() / CLHEP::cm
-        << "\nEnergy: " << fISCalc->EnergyDeposit()
-        << "\nElectrons: " << fISCalc->NumberIonizationElectrons()
-        << "\nPhotons: " << fISCalc->NumberScintillationPhotons();
-
-      G4ThreeVector totstep = fStep->GetPostStepPoint()->GetPosition();
-      totstep -= fStep->GetPreStepPoint()->GetPosition();
-
-      // Fill the histograms
-      fStepSize->Fill(totstep.mag() / CLHEP::cm);
-      fEnergyPerStep->Fill(fISCalc->EnergyDeposit());
-      fElectronsPerStep->Fill(fISCalc->NumberIonizationElectrons());
-      fPhotonsPerStep->Fill(fISCalc->NumberScintillationPhotons());
-      fElectronsVsPhotons->Fill(fISCalc->NumberScintillationPhotons(),
-                                fISCalc->NumberIonizationElectrons());
-      double const stepSize = totstep.mag() / CLHEP::cm;
-      if (stepSize > 0.0) {
-        fElectronsPerLength->Fill(fISCalc->NumberIonizationElectrons() * 1.e-3 / stepSize);
-        fPhotonsPerLength->Fill(fISCalc->NumberScintillationPhotons() * 1.e-3 / stepSize);
-      }
-      double const energyDep = fISCalc->EnergyDeposit();
-      if (energyDep) {
-        fElectronsPerEDep->Fill(fISCalc->NumberIonizationElectrons() * 1.e-3 / energyDep);
-        fPhotonsPerEDep->Fill(fISCalc->NumberScintillationPhotons() * 1.e-3 / energyDep);
-      }
-
-    } // end if the energy deposition is non-zero
-
-    return;
+    if (step->GetTotalEnergyDeposit() <= 0) return;
+
+    fISCalc->CalculateIonizationAndScintillation(fStep);
+
+    fStepResult.energyDeposit = fISCalc->EnergyDeposit();
+    fStepResult.visibleEnergyDeposit = fISCalc->VisibleEnergyDeposit();
+    fStepResult.numIonElectrons = fISCalc->NumberIonizationElectrons();
+    fStepResult.numScintPhotons = fISCalc->NumberScintillationPhotons();
+
+    MF_LOG_DEBUG("IonizationAndScintillation")
+      << "Step Size: " << fStep->GetStepLength() / CLHEP::cm
+      << "\nEnergy: " << fStepResult.energyDeposit
+      << "\nElectrons: " << fStepResult.numIonElectrons
+      << "\nPhotons: " << fStepResult.numScintPhotons;
+
+    if (fFillHistograms) FillHistograms();
+  }
+
+  //......................................................................
+  void
+  IonizationAndScintillation::FillHistograms() const
+  {
+    G4ThreeVector totstep = fStep->GetPostStepPoint()->GetPosition();
+    totstep -= fStep->GetPreStepPoint()->GetPosition();
+
+    double const stepSize = totstep.mag() / CLHEP::cm;
+    double const energyDep = fStepResult.energyDeposit;
+    double const electrons = fStepResult.numIonElectrons;
+    double const photons = fStepResult.numScintPhotons;
+
+    fStepSize->Fill(stepSize);
+    fEnergyPerStep->Fill(energyDep);
+    fElectronsPerStep->Fill(electrons);
+    fPhotonsPerStep->Fill(photons);
+    fElectronsVsPhotons->Fill(photons, electrons);
+    if (stepSize > 0.0) {
+      fElectronsPerLength->Fill(electrons * 1.e-3 / stepSize);
+      fPhotonsPerLength->Fill(photons * 1.e-3 / stepSize);
+    }
+    if (energyDep) {
+      fElectronsPerEDep->Fill(electrons * 1.e-3 / energyDep);
+      fPhotonsPerEDep->Fill(photons * 1.e-3 / energyDep);
+    }
   }
 
 } // namespace
@@ -13,6 +13,7 @@
 
 #include "larsim/LegacyLArG4/ISCalculation.h"
 
+class G4Material;
 class G4Step;
 class TH1F;
 class TH2F;
@@ -27,12 +28,18 @@ namespace detinfo {
 
 namespace larg4 {
 
-  // The Ionization and Scintillation singleton
+  // The Ionization and Scintillation calculator, one per thread
   class IonizationAndScintillation {
   public:
+    // Creates the calculator of the calling thread; each thread (including
+    // Geant4 worker threads) must call it with its own random engine.
+    // The detector properties are read only here: the calculator keeps the
+    // ones of the job (LArG4 passes DataForJob()), not the ones of each event
     static IonizationAndScintillation* CreateInstance(
       detinfo::DetectorPropertiesData const& detProp,
       CLHEP::HepRandomEngine& engine);
+    // Returns the calculator of the calling thread;
+    // throws cet::exception if the thread has not created one
     static IonizationAndScintillation* Instance();
 
     // Method to reset the internal variables held in the ISCalculation
@@ -42,22 +49,22 @@ namespace larg4 {
     double
     EnergyDeposit() const
     {
-      return fISCalc->EnergyDeposit();
+      return fStepResult.energyDeposit;
     }
     double
     VisibleEnergyDeposit() const
     {
-      return fISCalc->VisibleEnergyDeposit();
+      return fStepResult.visibleEnergyDeposit;
     }
     double
     NumberIonizationElectrons() const
     {
-      return fISCalc->NumberIonizationElectrons();
+      return fStepResult.numIonElectrons;
     }
     double
     NumberScintillationPhotons() const
     {
-      return fISCalc->NumberScintillationPhotons();
+      return fStepResult.numScintPhotons;
     }
     double
     StepSizeLimit() const
@@ -66,25 +73,40 @@ namespace larg4 {
     }
 
   private:
+    /// Results of the calculation for the last step seen, keyed by track and step number
+    struct StepResult {
+      int trackID{-1};                 ///< ID of the track the step belongs to
+      int stepNumber{-1};              ///< step number within the track
+      double energyDeposit{0.};        ///< total energy deposited in the step
+      double visibleEnergyDeposit{0.}; ///< energy deposit used for the photon yield
+      double numIonElectrons{0.};      ///< number of ionization electrons for this step
+      double numScintPhotons{0.};      ///< number of scintillation photons for this step
+    };
+
     IonizationAndScintillation(detinfo::DetectorPropertiesData const& detProp,
                                CLHEP::HepRandomEngine& engine);
 
+    void MakeHistograms();
+    void FillHistograms() const;
+
     std::unique_ptr<larg4::ISCalculation>
       fISCalc;                    ///< object to calculate ionization and scintillation
                                   ///< produced by an energy deposition
     std::string fISCalculator;    ///< name of calculator to use, NEST or Separate
     G4Step const* fStep{nullptr}; ///< pointer to the current G4 step
-    int fStepNumber{-1};          ///< last StepNumber checked
-    int fTrkID{-1};               ///< last TrkID checked
+    StepResult fStepResult;       ///< cached results for the last step checked
+    G4Material const* fLArMaterial{nullptr}; ///< the "LAr" material, looked up on first step
+    bool fLArMaterialResolved{false};        ///< whether fLArMaterial has been looked up
+    bool fFillHistograms{false};             ///< whether to fill the per-step histograms
 
     TH1F* fElectronsPerStep{nullptr};   ///< histogram of electrons per step
     TH1F* fStepSize{nullptr};           ///< histogram of the step sizes
     TH1F* fPhotonsPerStep{nullptr};     ///< histogram of the photons per step
     TH1F* fEnergyPerStep{nullptr};      ///< histogram of the energy deposited per step
-    TH1F* fElectronsPerLength;          ///< histogram of electrons per cm
-    TH1F* fPhotonsPerLength;            ///< histogram of photons per cm
-    TH1F* fElectronsPerEDep;            ///< histogram of electrons per MeV deposited
-    TH1F* fPhotonsPerEDep;              ///< histogram of photons per MeV deposited
+    TH1F* fElectronsPerLength{nullptr}; ///< histogram of electrons per cm
+    TH1F* fPhotonsPerLength{nullptr};   ///< histogram of photons per cm
+    TH1F* fElectronsPerEDep{nullptr};   ///< histogram of electrons per MeV deposited
+    TH1F* fPhotonsPerEDep{nullptr};     ///< histogram of photons per MeV deposited
     TH2F* fElectronsVsPhotons{nullptr}; ///< histogram of electrons vs photons per step
     CLHEP::HepRandomEngine& fEngine;    ///< random engine (needed for NEST)
   };
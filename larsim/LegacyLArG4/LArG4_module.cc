@@ -23,9 +23,11 @@
 // C++ Includes
 #include <cassert>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <sys/stat.h>
+#include <utility>
 
 // Framework includes
 #include "art/Framework/Core/EDProducer.h"
@@ -48,6 +50,8 @@
 // LArSoft Includes
 #include "larcore/Geometry/Geometry.h"
 #include "larcorealg/CoreUtils/ParticleFilters.h" // util::PositionInVolumeFilter
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardataalg/MCDumpers/MCDumpers.h" // sim::dump namespace
@@ -59,17 +63,21 @@
 #include "larsim/LegacyLArG4/AllPhysicsLists.h"
 #include "larsim/LegacyLArG4/AuxDetReadout.h"
 #include "larsim/LegacyLArG4/AuxDetReadoutGeometry.h"
+#include "larsim/LegacyLArG4/DirtAbortAction.h"
 #include "larsim/LegacyLArG4/IonizationAndScintillation.h"
 #include "larsim/LegacyLArG4/LArStackingAction.h"
 #include "larsim/LegacyLArG4/LArVoxelReadout.h"
 #include "larsim/LegacyLArG4/LArVoxelReadoutGeometry.h"
 #include "larsim/LegacyLArG4/MaterialPropertyLoader.h"
+#include "larsim/LegacyLArG4/MergeSimChannels.h"
 #include "larsim/LegacyLArG4/OpDetPhotonTable.h"
 #include "larsim/LegacyLArG4/OpDetReadoutGeometry.h"
 #include "larsim/LegacyLArG4/OpDetSensitiveDetector.h"
 #include "larsim/LegacyLArG4/ParticleListAction.h"
+#include "larsim/LegacyLArG4/RegionStatisticsAction.h"
 #include "larsim/PhotonPropagation/PhotonVisibilityService.h"
 #include "larsim/Simulation/LArG4Parameters.h"
+#include "larsim/Utils/ParallelFor.h"
 #include "nug4/G4Base/UserActionManager.h"
 #include "nug4/ParticleNavigation/ParticleList.h"
 #include "nusimdata/SimulationBase/MCTruth.h"
@@ -84,9 +92,6 @@
 //For energy depositions
 #include "lardataobj/Simulation/SimEnergyDeposit.h"
 
-// Boost includes
-#include "boost/algorithm/string.hpp"
-
 ///Geant4 interface
 namespace larg4 {
 
@@ -143,6 +148,10 @@ namespace larg4 {
    *   are stored, but minor filtering by geometry and by physics is possible.
    *   An association of them with the originating `simb::MCTruth` object is
    *   also produced.
+   * * with `AbortDirtEvents` set, a `bool` flag (instance name `DirtAborted`)
+   *   telling whether no interaction of the event reached the volumes of
+   *   interest, in which case their simulation was stopped early; it is
+   *   used by `simfilter::FilterNoDirtNeutrinos`.
    *
    *
    * Notes on the conventions
@@ -170,6 +179,9 @@ namespace larg4 {
    *   list, but _with its sign flipped_. Therefore, when tracking or
    *   backtracking (see above), comparisons should be performed using the
    *   absolute value of the `sim::IDE` (e.g. `std::abs(ide.trackID)`).
+   *   The same holds for particles dropped by the other retention options
+   *   (`ParticleEnergyCutsByPDG`, `MaxParticlesPerInteraction`); their saved
+   *   daughters have the saved ancestor as mother.
    *
    *
    * Timing
@@ -220,6 +232,42 @@ namespace larg4 {
    * - *KeepParticlesInVolumes* (list of strings, default: _empty_):
    *     list of volumes in which to keep `simb::MCParticle` objects (empty keeps all);
    *     requires `MakeMCParticles` being `true`
+   * - *ParticleEnergyCutsByPDG* (list of `[ PDG code, cut ]` pairs, default: _empty_):
+   *     minimum kinetic energy (GeV) for a secondary particle of the specified
+   *     type (absolute PDG code; `1000000000` stands for all nuclei) to be
+   *     saved as `simb::MCParticle`; other types use `ParticleKineticEnergyCut`
+   *     from `sim::LArG4Parameters`
+   * - *EnergyCutsByPDGOutsideActiveOnly* (flag, default: `false`): particles
+   *     starting in a TPC active volume are exempt from `ParticleEnergyCutsByPDG`
+   * - *TrajectoryTolerance* (real, default: `0`): trajectory points are
+   *     dropped while tracking, as long as the stored trajectory passes
+   *     within this distance (in centimeters) from them; `0` keeps all points
+   * - *SparsifyTrajectories* (flag, default: `false`): thin the trajectory of
+   *     each particle with `simb::MCParticle::SparsifyTrajectory()` when it
+   *     is stored, after the tracking; it can't be combined with a nonzero
+   *     `TrajectoryTolerance`, since the two thinnings would apply one after
+   *     the other
+   * - *MaxParticlesPerInteraction* (integer, default: `0`): maximum number of
+   *     secondary particles saved for each simulated interaction (`0`: no
+   *     limit); primary particles are always saved
+   * - *AbortDirtEvents* (flag, default: `false`): stop the simulation of an
+   *     interaction as soon as none of its stacked particles may reach the
+   *     volumes of interest (see `larg4::DirtAbortAction`); a particle may
+   *     reach them if it is within `DirtAbortMargin`, plus
+   *     `DirtAbortChargedRangePerGeV` times its kinetic energy if charged or
+   *     `DirtAbortNeutralReach` if neutral
+   * - *DirtAbortVolume* (string, default: `"TPCActive"`): volumes of
+   *     interest, either the active volumes of the TPC (`"TPCActive"`) or the
+   *     cryostats (`"Cryostat"`)
+   * - *DirtAbortMargin* (real, default: `100`): reach of any particle [cm]
+   * - *DirtAbortChargedRangePerGeV* (real, default: `500`): additional reach
+   *     of charged particles per GeV of kinetic energy [cm/GeV]
+   * - *DirtAbortNeutralReach* (real, default: `300`): additional reach of
+   *     neutral particles [cm]
+   * - *SimChannelThreads* (integer, default: `1`): number of threads used
+   *     at the end of each event to collect the `sim::SimChannel` of the
+   *     TPCs and merge the channels they share, as TBB tasks within the
+   *     threads of the job (`0`: no further limit)
    * - *GeantCommandFile* (string, _required_):
    *     G4 macro file to pass to `G4Helper` for setting G4 command
    * - *Seed* (integer, not defined by default): if defined, override the seed for
@@ -322,10 +370,14 @@ namespace larg4 {
     void produce(art::Event& evt) override;
     void beginJob() override;
     void beginRun(art::Run& run) override;
+    void endJob() override;
 
     std::unique_ptr<g4b::G4Helper> fG4Help{nullptr}; ///< G4 interface object
     larg4::ParticleListAction* fparticleListAction{
       nullptr}; ///< Geant4 user action to particle information.
+    larg4::DirtAbortAction* fDirtAbortAction{nullptr}; ///< Early abort of dirt events (optional).
+    larg4::RegionStatisticsAction* fRegionStatisticsAction{
+      nullptr}; ///< Counts per production region (if any is configured).
 
     std::string fG4PhysListName; ///< predefined physics list to use if not making a custom one
     std::string fG4MacroPath;    ///< directory path for Geant4 macro file to be
@@ -345,6 +397,16 @@ namespace larg4 {
 
     bool fSparsifyTrajectories; ///< Sparsify MCParticle Trajectories
 
+    /// Particle retention rules, except for the active volumes (set in `beginJob()`).
+    ParticleListAction::RetentionPolicy_t fRetentionPolicy;
+    bool fEnergyCutsOutsideActiveOnly; ///< Particles in active volume exempt from PDG cuts
+
+    bool fAbortDirtEvents;               ///< Whether to stop dirt interactions early
+    std::string fDirtAbortVolume;        ///< Volumes dirt particles must reach
+    DirtAbortAction::Reach_t fDirtReach; ///< Reach of particles for the dirt abort
+
+    unsigned int fSimChannelThreads; ///< Threads collecting the SimChannels of the TPCs
+
     CLHEP::HepRandomEngine& fEngine; ///< Random-number engine for IonizationAndScintillation
                                      ///< initialization
 
@@ -360,43 +422,6 @@ namespace larg4 {
 
 } // namespace LArG4
 
-namespace {
-
-  // ---------------------------------------------------------------------------
-  /**
-   * @brief Moves data from `source` to the end of `dest`.
-   * @tparam T type of values in the containers
-   * @param dest collection to append data to
-   * @param source collection to take data from
-   * @return a reference to `dest`
-   *
-   * The data contained in `source` is moved (appended) to the end of `dest`.
-   *
-   * The data is moved from source element by element; as an exception, if
-   * `dest` is still empty, the data is moved in a block.
-   *
-   * The `source` collection is always returned depleted as after being "moved
-   * away" (i.e. after `auto temp = std::move(source);`): that means that the
-   * only thing that can be done with it according to C++ standard is to
-   * destruct it.
-   *
-   */
-  template <typename T>
-  std::vector<T>&
-  append(std::vector<T>& dest, std::vector<T>&& source)
-  {
-    if (empty(dest))
-      dest = std::move(source);
-    else {
-      dest.insert(dest.end(), std::move_iterator{begin(source)}, std::move_iterator{end(source)});
-      source = std::vector<T>{}; // ensure the old memory is released
-    }
-    return dest;
-  }
-  // ---------------------------------------------------------------------------
-
-} // local namespace
-
 namespace larg4 {
 
   //----------------------------------------------------------------------
@@ -412,6 +437,10 @@ namespace larg4 {
     , fOffPlaneMargin(pset.get<double>("ChargeRecoveryMargin", 0.0))
     , fKeepParticlesInVolumes(pset.get<std::vector<std::string>>("KeepParticlesInVolumes", {}))
     , fSparsifyTrajectories(pset.get<bool>("SparsifyTrajectories", false))
+    , fEnergyCutsOutsideActiveOnly(pset.get<bool>("EnergyCutsByPDGOutsideActiveOnly", false))
+    , fAbortDirtEvents(pset.get<bool>("AbortDirtEvents", false))
+    , fDirtAbortVolume(pset.get<std::string>("DirtAbortVolume", "TPCActive"))
+    , fSimChannelThreads(pset.get<unsigned int>("SimChannelThreads", 1U))
     , fEngine(art::ServiceHandle<rndm::NuRandomService> {}
                 ->createEngine(*this, "HepJamesRandom", "propagation", pset, "PropagationSeed"))
     , fDetProp{art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataForJob()}
@@ -431,6 +460,29 @@ namespace larg4 {
       }
     } // if
 
+    for (auto const& [pdgCode, cut] :
+         pset.get<std::vector<std::pair<int, double>>>("ParticleEnergyCutsByPDG", {}))
+      fRetentionPolicy.energyCutByPDG[pdgCode] = cut;
+    fRetentionPolicy.trajectoryTolerance = pset.get<double>("TrajectoryTolerance", 0.);
+    if (fSparsifyTrajectories && (fRetentionPolicy.trajectoryTolerance > 0.)) {
+      throw art::Exception(art::errors::Configuration)
+        << "Options `SparsifyTrajectories` and `TrajectoryTolerance` are alternative"
+        << " ways to thin the trajectories: only one of them can be set.\n";
+    }
+    fRetentionPolicy.maxParticles = pset.get<unsigned int>("MaxParticlesPerInteraction", 0U);
+
+    if (fAbortDirtEvents) {
+      if ((fDirtAbortVolume != "TPCActive") && (fDirtAbortVolume != "Cryostat")) {
+        throw art::Exception(art::errors::Configuration)
+          << "Option `DirtAbortVolume` must be either \"TPCActive\" or \"Cryostat\" (not \""
+          << fDirtAbortVolume << "\").\n";
+      }
+      fDirtReach.margin = pset.get<double>("DirtAbortMargin", fDirtReach.margin);
+      fDirtReach.chargedPerGeV =
+        pset.get<double>("DirtAbortChargedRangePerGeV", fDirtReach.chargedPerGeV);
+      fDirtReach.neutral = pset.get<double>("DirtAbortNeutralReach", fDirtReach.neutral);
+    }
+
     if (pset.has_key("Seed")) {
       throw art::Exception(art::errors::Configuration)
         << "The configuration of LArG4 module has the discontinued 'Seed' parameter.\n"
@@ -490,6 +542,7 @@ namespace larg4 {
     }
     if (!lgp->NoElectronPropagation()) produces<std::vector<sim::SimChannel>>();
     produces<std::vector<sim::AuxDetSimChannel>>();
+    if (fAbortDirtEvents) produces<bool>("DirtAborted");
 
     // constructor decides if initialized value is a path or an environment variable
     cet::search_path sp("FW_SEARCH_PATH");
@@ -525,8 +578,8 @@ namespace larg4 {
     // Intialize G4 physics and primary generator action
     fG4Help->InitPhysics();
 
-    // create the ionization and scintillation calculator;
-    // this is a singleton (!) so it does not make sense
+    // create the ionization and scintillation calculator of this thread;
+    // there is one per thread (not per TPC) so it does not make sense
     // to create it in LArVoxelReadoutGeometry
     IonizationAndScintillation::CreateInstance(detProp, fEngine);
 
@@ -560,17 +613,46 @@ namespace larg4 {
                                                         lgp->StoreTrajectories(),
                                                         lgp->KeepEMShowerDaughters(),
                                                         fMakeMCParticles);
+    if (fEnergyCutsOutsideActiveOnly) {
+      for (geo::TPCGeo const& tpc : geom->IterateTPCs())
+        fRetentionPolicy.exemptVolumes.push_back(tpc.ActiveBoundingBox());
+    }
+    fparticleListAction->SetRetentionPolicy(fRetentionPolicy);
     uaManager->AddAndAdoptAction(fparticleListAction);
 
+    if (fAbortDirtEvents) {
+      std::vector<geo::BoxBoundedGeo> volumes;
+      if (fDirtAbortVolume == "Cryostat") {
+        for (geo::CryostatGeo const& cryo : geom->IterateCryostats())
+          volumes.push_back(cryo.Boundaries());
+      }
+      else {
+        for (geo::TPCGeo const& tpc : geom->IterateTPCs())
+          volumes.push_back(tpc.ActiveBoundingBox());
+      }
+      fDirtAbortAction = new larg4::DirtAbortAction(std::move(volumes), fDirtReach);
+      uaManager->AddAndAdoptAction(fDirtAbortAction);
+    }
+
+    if (!lgp->ProductionRegions().empty()) {
+      fRegionStatisticsAction = new larg4::RegionStatisticsAction;
+      uaManager->AddAndAdoptAction(fRegionStatisticsAction);
+    }
+
     // UserActionManager is now configured so continue G4 initialization
     fG4Help->SetUserAction();
 
     // With an enormous detector with lots of rock ala LAr34 (nee LAr20)
     // we need to be smarter about stacking.
-    if (fSmartStacking > 0) {
-      G4UserStackingAction* stacking_action = new LArStackingAction(fSmartStacking);
-      fG4Help->GetRunManager()->SetUserAction(stacking_action);
+    std::unique_ptr<G4UserStackingAction> stacking_action;
+    if (fSmartStacking > 0) stacking_action = std::make_unique<LArStackingAction>(fSmartStacking);
+
+    // the dirt abort action needs to know which tracks are stacked
+    if (fDirtAbortAction) {
+      stacking_action = std::make_unique<larg4::DirtAbortStackingAction>(
+        *fDirtAbortAction, std::move(stacking_action));
     }
+    if (stacking_action) fG4Help->GetRunManager()->SetUserAction(stacking_action.release());
   }
 
   void
@@ -582,6 +664,12 @@ namespace larg4 {
     fparticleListAction->ParticleFilter(CreateParticleVolumeFilter(volnameset));
   }
 
+  void
+  LArG4::endJob()
+  {
+    if (fRegionStatisticsAction) fRegionStatisticsAction->PrintSummary();
+  }
+
   std::unique_ptr<util::PositionInVolumeFilter>
   LArG4::CreateParticleVolumeFilter(std::set<std::string> const& vol_names) const
   {
@@ -666,9 +754,8 @@ namespace larg4 {
     art::ServiceHandle<sim::LArG4Parameters const> lgp;
     art::ServiceHandle<geo::Geometry const> geom;
 
-    // Clear the detected photon table
-    OpDetPhotonTable::Instance()->ClearTable(geom->NOpDets());
-    if (lgp->FillSimEnergyDeposits()) OpDetPhotonTable::Instance()->ClearEnergyDeposits();
+    // Clear the detected photon tables of all the threads
+    OpDetPhotonTable::ClearAllTables(geom->NOpDets(), lgp->FillSimEnergyDeposits());
 
     // reset the track ID offset as we have a new collection of interactions
     fparticleListAction->ResetTrackIDOffset();
@@ -685,6 +772,7 @@ namespace larg4 {
     }
 
     unsigned int nGeneratedParticles = 0;
+    unsigned int nInteractions = 0, nDirtAborted = 0;
 
     // Need to process Geant4 simulation for each interaction separately.
     for (size_t mcl = 0; mcl < mclists.size(); ++mcl) {
@@ -698,6 +786,8 @@ namespace larg4 {
 
         // The following tells Geant4 to track the particles in this interaction.
         fG4Help->G4Run(mct);
+        ++nInteractions;
+        if (fDirtAbortAction && fDirtAbortAction->Aborted()) ++nDirtAborted;
 
         if (!partCol) continue;
         assert(tpassn);
@@ -753,10 +843,13 @@ namespace larg4 {
     auto theOpDetDet = dynamic_cast<OpDetSensitiveDetector*>(
       sdManager->FindSensitiveDetector("OpDetSensitiveDetector"));
 
-    // Store the contents of the detected photon table
+    // Store the contents of the detected photon table,
+    // after collecting the photons detected in all the threads
     //
     if (theOpDetDet) {
 
+      OpDetPhotonTable::Instance()->MergeWorkerTables();
+
       if (!lgp->NoPhotonPropagation()) {
 
         for (int Reflected = 0; Reflected <= 1; Reflected++) {
@@ -780,21 +873,11 @@ namespace larg4 {
           else {
             MF_LOG_DEBUG("Optical") << "Storing OpDet Hit Collection in Event";
 
-            std::map<int, std::map<int, int>> ThePhotons =
-              OpDetPhotonTable::Instance()->GetLitePhotons(Reflected);
-
-            if (size(ThePhotons) > 0) {
-              LitePhotonCol->reserve(ThePhotons.size());
-              for (auto const& [opChannel, detectedPhotons] : ThePhotons) {
-                sim::SimPhotonsLite ph;
-                ph.OpChannel = opChannel;
-                ph.DetectedPhotons = detectedPhotons;
-                if (Reflected)
-                  LitePhotonColRefl->push_back(std::move(ph));
-                else
-                  LitePhotonCol->push_back(std::move(ph));
-              }
-            }
+            // the table already holds the photons in the form of the data product
+            if (Reflected)
+              *LitePhotonColRefl = OpDetPhotonTable::Instance()->YieldLitePhotons(true);
+            else
+              *LitePhotonCol = OpDetPhotonTable::Instance()->YieldLitePhotons(false);
           }
           if (Reflected)
             *cOpDetBacktrackerRecordColRefl =
@@ -806,14 +889,11 @@ namespace larg4 {
       } //end if no photon propagation
 
       if (lgp->FillSimEnergyDeposits()) {
-        // we steal the only existing copy of the energy deposit map. Oink!
-        auto edepMap = OpDetPhotonTable::Instance()->YieldSimEnergyDeposits();
-        for (auto& [volumeName, edepCol] : edepMap) {
-          // note: constant reference to a (smart) pointer to non-const data
-          auto const& destColl =
-            boost::contains(volumeName, "TPCActive") ? edepCol_TPCActive : edepCol_Other;
-          append(*destColl, std::move(edepCol));
-        } // for
+        // we steal the only existing copy of the energy deposits. Oink!
+        // They are in stepping order, with the volumes of a category mixed.
+        OpDetPhotonTable* table = OpDetPhotonTable::Instance();
+        *edepCol_TPCActive = table->YieldSimEnergyDeposits(OpDetPhotonTable::kTPCActive);
+        *edepCol_Other = table->YieldSimEnergyDeposits(OpDetPhotonTable::kOtherVolume);
       }
     } //end if theOpDetDet
 
@@ -824,13 +904,15 @@ namespace larg4 {
 
       std::set<LArVoxelReadout*> ReadoutList; // to be cleared later on
 
-      for (unsigned int c = 0; c < geom->Ncryostats(); ++c) {
-
-        // map to keep track of which channels we already have SimChannels for in scCol
-        // remake this map on each cryostat as channels ought not to be shared between
-        // cryostats, just between TPC's
+      // the readout of each TPC, and the channel map it is staged from
+      struct TPCReadout_t {
+        unsigned int cryostat;
+        unsigned int tpc;
+        LArVoxelReadout* readout;
+      };
+      std::vector<TPCReadout_t> TPCReadouts;
 
-        std::map<unsigned int, unsigned int> channelToscCol;
+      for (unsigned int c = 0; c < geom->Ncryostats(); ++c) {
 
         unsigned int ntpcs = geom->Cryostat(c).NTPC();
         for (unsigned int t = 0; t < ntpcs; ++t) {
@@ -861,48 +943,53 @@ namespace larg4 {
               << "Sensitive detector '" << sd->GetName() << "' is not a LArVoxelReadout object\n";
           }
 
-          LArVoxelReadout::ChannelMap_t& channels = larVoxelReadout->GetSimChannelMap(c, t);
-          if (!empty(channels)) {
-            MF_LOG_DEBUG("LArG4") << "now put " << channels.size() << " SimChannels from C=" << c
-                                  << " T=" << t << " into the event";
-          }
-
-          for (auto ch_pair : channels) {
-            sim::SimChannel& sc = ch_pair.second;
-
-            // push sc onto scCol but only if we haven't already put something in scCol for this channel.
-            // if we have, then merge the ionization deposits.  Skip the check if we only have one TPC
-
-            if (ntpcs > 1) {
-              unsigned int ichan = sc.Channel();
-              auto itertest = channelToscCol.find(ichan);
-              if (itertest == channelToscCol.end()) {
-                channelToscCol[ichan] = scCol->size();
-                scCol->emplace_back(std::move(sc));
-              }
-              else {
-                unsigned int idtest = itertest->second;
-                auto const& tdcideMap = sc.TDCIDEMap();
-                for (auto const& tdcide : tdcideMap) {
-                  for (auto const& ide : tdcide.second) {
-                    double xyz[3] = {ide.x, ide.y, ide.z};
-                    scCol->at(idtest).AddIonizationElectrons(
-                      ide.trackID, tdcide.first, ide.numElectrons, xyz, ide.energy);
-                  } // end loop to add ionization electrons to  scCol->at(idtest)
-                }   // end loop over tdc to vector<sim::IDE> map
-              }     // end if check to see if we've put SimChannels in for ichan yet or not
-            }
-            else {
-              scCol->emplace_back(std::move(sc));
-            } // end of check if we only have one TPC (skips check for multiple simchannels if we have just one TPC)
-          }   // end loop over simchannels for this TPC
+          TPCReadouts.push_back({c, t, larVoxelReadout});
 
           // mark it for clearing
-          ReadoutList.insert(const_cast<LArVoxelReadout*>(larVoxelReadout));
+          ReadoutList.insert(larVoxelReadout);
 
         } // end loop over tpcs
       }   // end loop over cryostats
 
+      // move the SimChannels of each TPC into its own staging collection;
+      // each TPC has its own channel map, so the TPCs are independent
+      std::vector<std::vector<sim::SimChannel>> TPCChannels(TPCReadouts.size());
+      larsim::Utils::ParallelFor(TPCReadouts.size(), fSimChannelThreads, [&TPCReadouts, &TPCChannels](std::size_t i) {
+        TPCReadout_t const& info = TPCReadouts[i];
+        LArVoxelReadout::ChannelMap_t& channels =
+          info.readout->GetSimChannelMap(info.cryostat, info.tpc);
+        std::vector<sim::SimChannel>& staged = TPCChannels[i];
+        staged.reserve(channels.size());
+        for (auto& ch_pair : channels)
+          staged.push_back(std::move(ch_pair.second));
+        channels.clear();
+      });
+
+      // merge the channels shared by the TPCs of the same cryostat
+      // (channels ought not to be shared between cryostats), and
+      // concatenate the cryostats in order
+      std::size_t iFirstTPC = 0;
+      for (unsigned int c = 0; c < geom->Ncryostats(); ++c) {
+        std::size_t const ntpcs = geom->Cryostat(c).NTPC();
+        std::vector<std::vector<sim::SimChannel>> cryoChannels{
+          std::make_move_iterator(TPCChannels.begin() + iFirstTPC),
+          std::make_move_iterator(TPCChannels.begin() + iFirstTPC + ntpcs)};
+        for (std::size_t t = 0; t < ntpcs; ++t) {
+          if (empty(cryoChannels[t])) continue;
+          MF_LOG_DEBUG("LArG4") << "now put " << cryoChannels[t].size()
+                                << " SimChannels from C=" << c << " T=" << t << " into the event";
+        }
+        iFirstTPC += ntpcs;
+
+        std::vector<sim::SimChannel> merged =
+          MergeSimChannels(std::move(cryoChannels), fSimChannelThreads);
+        if (empty(*scCol))
+          *scCol = std::move(merged);
+        else
+          scCol->insert(
+            scCol->end(), std::make_move_iterator(merged.begin()), std::make_move_iterator(merged.end()));
+      } // for cryostats
+
       for (LArVoxelReadout* larVoxelReadout : ReadoutList) {
         larVoxelReadout->ClearSimChannels();
       }
@@ -961,6 +1048,14 @@ namespace larg4 {
     if (!lgp->NoElectronPropagation()) evt.put(std::move(scCol));
 
     evt.put(std::move(adCol));
+    if (fAbortDirtEvents) {
+      bool const dirtAborted = (nInteractions > 0) && (nDirtAborted == nInteractions);
+      if (dirtAborted) {
+        mf::LogInfo("LArG4") << "None of the " << nInteractions
+                             << " interactions reached the detector: event marked as dirt";
+      }
+      evt.put(std::make_unique<bool>(dirtAborted), "DirtAborted");
+    }
     if (partCol) evt.put(std::move(partCol));
     if (tpassn) evt.put(std::move(tpassn));
     if (!lgp->NoPhotonPropagation()) {
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  MergeSimChannels.cxx
+/// \brief Parallel merging of the SimChannels of the TPCs of a cryostat.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include "larsim/LegacyLArG4/MergeSimChannels.h"
+#include "larsim/Utils/ParallelFor.h"
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+
+namespace larg4 {
+
+  //----------------------------------------------------------------------------
+  std::vector<sim::SimChannel>
+  MergeSimChannels(std::vector<std::vector<sim::SimChannel>> perTPC, unsigned int nThreads)
+  {
+    if (perTPC.empty()) return {};
+    if (perTPC.size() == 1U) return std::move(perTPC.front());
+
+    // group the SimChannels by channel, in order of first appearance;
+    // each group lists the SimChannels as (TPC, index in TPC)
+    using Position_t = std::pair<std::size_t, std::size_t>;
+    std::vector<std::vector<Position_t>> groups;
+    std::unordered_map<unsigned int, std::size_t> channelToGroup;
+    for (std::size_t iTPC = 0; iTPC < perTPC.size(); ++iTPC) {
+      std::vector<sim::SimChannel> const& channels = perTPC[iTPC];
+      for (std::size_t iChannel = 0; iChannel < channels.size(); ++iChannel) {
+        auto const [itGroup, isNew] =
+          channelToGroup.emplace(channels[iChannel].Channel(), groups.size());
+        if (isNew) groups.emplace_back();
+        groups[itGroup->second].emplace_back(iTPC, iChannel);
+      } // for channels in TPC
+    }   // for TPCs
+
+    // each group is merged into its first SimChannel;
+    // groups share no SimChannel, so they can be merged concurrently
+    std::vector<sim::SimChannel> result(groups.size());
+    larsim::Utils::ParallelFor(groups.size(), nThreads, [&perTPC, &groups, &result](std::size_t g) {
+      std::vector<Position_t> const& group = groups[g];
+      sim::SimChannel dest = std::move(perTPC[group.front().first][group.front().second]);
+      for (auto itPos = group.begin() + 1; itPos != group.end(); ++itPos) {
+        sim::SimChannel const& sc = perTPC[itPos->first][itPos->second];
+        for (auto const& tdcide : sc.TDCIDEMap()) {
+          for (auto const& ide : tdcide.second) {
+            double xyz[3] = {ide.x, ide.y, ide.z};
+            dest.AddIonizationElectrons(
+              ide.trackID, tdcide.first, ide.numElectrons, xyz, ide.energy);
+          }
+        }
+      } // for SimChannels in group
+      result[g] = std::move(dest);
+    });
+
+    return result;
+  }
+
+} // namespace larg4
@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  MergeSimChannels.h
+/// \brief Parallel merging of the SimChannels of the TPCs of a cryostat.
+///
+////////////////////////////////////////////////////////////////////////
+
+/// At the end of the event LArG4 collects the `sim::SimChannel` of each TPC
+/// from `LArVoxelReadout`. TPCs of the same cryostat may share channels,
+/// whose ionization deposits must be merged into a single `sim::SimChannel`.
+///
+/// `MergeSimChannels()` groups the SimChannels by channel in a single pass,
+/// then merges the groups as TBB tasks (see `larsim::Utils::ParallelFor()`),
+/// and returns the channels in the same order as a serial merge would:
+/// in order of first appearance, scanning the TPCs in order.
+
+#ifndef LArG4_MergeSimChannels_h
+#define LArG4_MergeSimChannels_h
+
+#include "lardataobj/Simulation/SimChannel.h"
+
+#include <vector>
+
+namespace larg4 {
+
+  /**
+   * @brief Merges the SimChannels of the TPCs of a cryostat.
+   * @param perTPC the SimChannels of each TPC, no more than one per channel
+   * @param nThreads maximum number of threads to use (`0`: no limit)
+   * @return one SimChannel per channel
+   *
+   * The content of `perTPC` is moved into the result.
+   */
+  std::vector<sim::SimChannel> MergeSimChannels(std::vector<std::vector<sim::SimChannel>> perTPC,
+                                                unsigned int nThreads = 1U);
+
+} // namespace larg4
+
+#endif // LArG4_MergeSimChannels_h
@@ -16,8 +16,17 @@
 
 #include "lardataobj/Simulation/SimEnergyDeposit.h"
 
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
 namespace larg4 {
-  OpDetPhotonTable * TheOpDetPhotonTable;
+  // each thread gets its own table; the tables are owned by fAllTables
+  thread_local OpDetPhotonTable * TheOpDetPhotonTable = nullptr;
+
+  std::vector<std::unique_ptr<OpDetPhotonTable>> OpDetPhotonTable::fAllTables;
+  std::mutex OpDetPhotonTable::fAllTablesMutex;
+  size_t OpDetPhotonTable::fNOpChannels = 0;
 
   //--------------------------------------------------
   OpDetPhotonTable::OpDetPhotonTable()
@@ -32,11 +41,93 @@ namespace larg4 {
   OpDetPhotonTable * OpDetPhotonTable::Instance(bool /*LitePhotons*/ )
   {
     if(!TheOpDetPhotonTable){
-      TheOpDetPhotonTable = new OpDetPhotonTable;
+      std::lock_guard<std::mutex> lock(fAllTablesMutex);
+      fAllTables.emplace_back(new OpDetPhotonTable);
+      TheOpDetPhotonTable = fAllTables.back().get();
+      // a table created in the middle of the job must accept any channel
+      TheOpDetPhotonTable->ClearTable(fNOpChannels);
     }
     return TheOpDetPhotonTable;
   }
 
+  //--------------------------------------------------
+  void OpDetPhotonTable::ClearAllTables(size_t nch, bool energyDeposits)
+  {
+    Instance(); // make sure the table of this thread exists
+    std::lock_guard<std::mutex> lock(fAllTablesMutex);
+    fNOpChannels = nch;
+    for (auto& table: fAllTables) {
+      table->ClearTable(nch);
+      table->ClearOpDetBacktrackerRecords();
+      if (energyDeposits) table->ClearEnergyDeposits();
+    }
+  }
+
+  //--------------------------------------------------
+  void OpDetPhotonTable::Merge(OpDetPhotonTable& other)
+  {
+    if (&other == this) return;
+
+    auto mergePhotons
+      = [](std::vector<sim::SimPhotons>& dest, std::vector<sim::SimPhotons>& src)
+      {
+        if (dest.size() < src.size()) {
+          size_t const first = dest.size();
+          dest.resize(src.size());
+          for (size_t i = first; i < dest.size(); ++i) dest[i].SetChannel(i);
+        }
+        for (size_t i = 0; i < src.size(); ++i) {
+          if (src[i].empty()) continue;
+          dest[i].insert(dest[i].end(),
+            std::make_move_iterator(src[i].begin()), std::make_move_iterator(src[i].end()));
+        }
+      };
+    mergePhotons(fDetectedPhotons, other.fDetectedPhotons);
+    mergePhotons(fReflectedDetectedPhotons, other.fReflectedDetectedPhotons);
+
+    auto mergeLitePhotons
+      = [](std::vector<sim::SimPhotonsLite>& dest, std::vector<sim::SimPhotonsLite>& src)
+      {
+        for (sim::SimPhotonsLite& photons: src) {
+          if (photons.DetectedPhotons.empty()) continue;
+          auto& destPhotons = LitePhotonsForOpChannel(dest, photons.OpChannel).DetectedPhotons;
+          if (destPhotons.empty()) {
+            std::swap(destPhotons, photons.DetectedPhotons);
+            continue;
+          }
+          for (auto const& [time, count]: photons.DetectedPhotons) destPhotons[time] += count;
+        }
+      };
+    mergeLitePhotons(fLitePhotons, other.fLitePhotons);
+    mergeLitePhotons(fReflectedLitePhotons, other.fReflectedLitePhotons);
+
+    for (auto& soc: other.YieldOpDetBacktrackerRecords())
+      AddOpDetBacktrackerRecord(std::move(soc), false);
+    for (auto& soc: other.YieldReflectedOpDetBacktrackerRecords())
+      AddOpDetBacktrackerRecord(std::move(soc), true);
+
+    for (size_t category = 0; category < fSimEDepCol.size(); ++category) {
+      auto& dest = fSimEDepCol[category];
+      auto& edeps = other.fSimEDepCol[category];
+      if (dest.empty()) std::swap(dest, edeps);
+      else {
+        dest.insert(dest.end(),
+          std::make_move_iterator(edeps.begin()), std::make_move_iterator(edeps.end()));
+      }
+    }
+    other.ClearEnergyDeposits();
+
+    other.ClearTable(other.fDetectedPhotons.size());
+  }
+
+  //--------------------------------------------------
+  void OpDetPhotonTable::MergeWorkerTables()
+  {
+    // the content of the other tables is appended in their order of creation
+    std::lock_guard<std::mutex> lock(fAllTablesMutex);
+    for (auto& table: fAllTables) Merge(*table);
+  }
+
 
 
   //--------------------------------------------------
@@ -60,25 +151,59 @@ namespace larg4 {
   //--------------------------------------------------
   void OpDetPhotonTable::AddLitePhoton( int opchannel, int time, int nphotons, bool Reflected)
   {
-    if (!Reflected)
-      fLitePhotons[opchannel][time] += nphotons;
-    else
-      fReflectedLitePhotons[opchannel][time] += nphotons;
+    auto& LitePhotons = Reflected ? fReflectedLitePhotons : fLitePhotons;
+    LitePhotonsForOpChannel(LitePhotons, opchannel).DetectedPhotons[time] += nphotons;
   }
 
   //--------------------------------------------------
   void OpDetPhotonTable::AddPhoton(std::map<int, std::map<int, int>>* StepPhotonTable, bool Reflected)
   {
+    auto& LitePhotons = Reflected ? fReflectedLitePhotons : fLitePhotons;
     for(auto it = StepPhotonTable->begin(); it!=StepPhotonTable->end(); it++)
     {
+      auto& DetectedPhotons = LitePhotonsForOpChannel(LitePhotons, it->first).DetectedPhotons;
       for(auto in_it = it->second.begin(); in_it!=it->second.end(); in_it++)
-      {
-        if (!Reflected)
-          fLitePhotons[it->first][in_it->first]+= in_it->second;
-        else
-          fReflectedLitePhotons[it->first][in_it->first]+= in_it->second;
-      }
+        DetectedPhotons[in_it->first]+= in_it->second;
+    }
+  }
+
+  //--------------------------------------------------
+  sim::SimPhotonsLite& OpDetPhotonTable::LitePhotonsForOpChannel
+    (std::vector<sim::SimPhotonsLite>& LitePhotons, int opchannel)
+  {
+    if (opchannel < 0) {
+      std::cerr << "<<" << __PRETTY_FUNCTION__ << ">>"
+		<< "Invalid channel Number: " << opchannel
+		<< std::endl;
+      throw std::exception();
     }
+    // channels beyond the ones from ClearTable() are still accepted
+    if (static_cast<size_t>(opchannel) >= LitePhotons.size())
+      ResetLitePhotons(LitePhotons, opchannel + 1);
+    return LitePhotons[opchannel];
+  }
+
+  //--------------------------------------------------
+  void OpDetPhotonTable::ResetLitePhotons(std::vector<sim::SimPhotonsLite>& LitePhotons, size_t nch)
+  {
+    size_t const first = std::min(LitePhotons.size(), nch);
+    LitePhotons.resize(nch);
+    for (size_t i = first; i < nch; ++i) LitePhotons[i].OpChannel = i;
+  }
+
+  //--------------------------------------------------
+  std::vector<sim::SimPhotonsLite> OpDetPhotonTable::YieldLitePhotons(bool Reflected)
+  {
+    // channels without photons are not stored
+    auto& LitePhotons = Reflected ? fReflectedLitePhotons : fLitePhotons;
+    std::vector<sim::SimPhotonsLite> result;
+    std::swap(result, LitePhotons);
+    result.erase(
+      std::remove_if(result.begin(), result.end(),
+        [](sim::SimPhotonsLite const& photons){ return photons.DetectedPhotons.empty(); }),
+      result.end());
+    ResetLitePhotons(LitePhotons, fNOpChannels);
+    return result;
   }
 
   //--------------------------------------------------- cOpDetBacktrackerRecord population
@@ -121,6 +246,15 @@ namespace larg4 {
   }//END void OpDetPhotonTable::AdOpDetBacktrackerRecords
 
 
+  //--------------------------------------------------
+  void OpDetPhotonTable::ClearOpDetBacktrackerRecords()
+  {
+    cOpDetBacktrackerRecordsCol.clear();
+    cReflectedOpDetBacktrackerRecordsCol.clear();
+    cOpChannelToSOCMap.clear();
+    cReflectedOpChannelToSOCMap.clear();
+  }
+
   //--------------------------------------------------
   // cOpDetBacktrackerRecord return.
   std::vector<sim::OpDetBacktrackerRecord> OpDetPhotonTable::YieldOpDetBacktrackerRecords() {
@@ -167,12 +301,10 @@ namespace larg4 {
       //fDetectedPhotons.at(i).reserve(10000); // Just a guess on minimum # photons
     }
 
-    for(auto it=fLitePhotons.begin(); it!=fLitePhotons.end(); ++it)
-      (it->second).clear();
-    for(auto it=fReflectedLitePhotons.begin(); it!=fReflectedLitePhotons.end(); ++it)
-      (it->second).clear();
-    fLitePhotons.clear();
-    fReflectedLitePhotons.clear();
+    for (auto& LitePhotons: { &fLitePhotons, &fReflectedLitePhotons }) {
+      for (auto& photons: *LitePhotons) photons.DetectedPhotons.clear();
+      ResetLitePhotons(*LitePhotons, std::max(LitePhotons->size(), nch));
+    }
   }
 
   //--------------------------------------------------
@@ -205,9 +337,9 @@ namespace larg4 {
 					  float end_x,float end_y,float end_z,
 					  double start_time,double end_time,
 					  int trackid,int pdgcode,
-					  std::string const& vol)
+					  EnergyDepositCategory_t category)
   {
-    fSimEDepCol[vol].emplace_back(n_photon, n_elec, scint_yield,
+    fSimEDepCol.at(category).emplace_back(n_photon, n_elec, scint_yield,
 				  energy,
 				  geo::Point_t{start_x,start_y,start_z},
 				  geo::Point_t{end_x,end_y,end_z},
@@ -217,19 +349,22 @@ namespace larg4 {
 
   //--------------------------------------------------
   void OpDetPhotonTable::ClearEnergyDeposits()
-  { fSimEDepCol.clear(); }
+  { for (auto& edeps: fSimEDepCol) edeps.clear(); }
 
 
   //--------------------------------------------------
-  std::unordered_map< std::string,std::vector<sim::SimEnergyDeposit> > const& OpDetPhotonTable::GetSimEnergyDeposits() const
-  { return fSimEDepCol; }
+  std::vector<sim::SimEnergyDeposit> OpDetPhotonTable::YieldSimEnergyDeposits(EnergyDepositCategory_t category)
+  {
+    std::vector<sim::SimEnergyDeposit> data;
+    std::swap(data, fSimEDepCol.at(category));
+    return data;
+  }
 
   //--------------------------------------------------
-  std::unordered_map< std::string,std::vector<sim::SimEnergyDeposit> > OpDetPhotonTable::YieldSimEnergyDeposits()
+  OpDetPhotonTable::EnergyDepositCategory_t OpDetPhotonTable::EnergyDepositCategory
+    (std::string const& volumeName)
   {
-    auto data { std::move(fSimEDepCol) };
-    ClearEnergyDeposits();
-    return data;
+    return (volumeName.find("TPCActive") != std::string::npos)? kTPCActive: kOtherVolume;
   }
 
 
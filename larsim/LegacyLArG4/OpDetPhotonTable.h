@@ -29,13 +29,28 @@
 //
 // Ben Jones, MIT, 11/10/12
 //
+// Each thread stepping particles gets its own table from Instance(),
+// so that Geant4 worker threads never share the per-event state.
+// At the end of the event the tables of all the threads are reduced
+// into the one of the thread writing the data products, with
+// MergeWorkerTables().
+//
+// The lite photons and the energy deposits are accumulated directly in the
+// form of the data products (channel-indexed sim::SimPhotonsLite, and one
+// sim::SimEnergyDeposit collection per volume category), so that LArG4 can
+// move them into the event (YieldLitePhotons(), YieldSimEnergyDeposits()).
+// The energy deposits of a category are in the order they were stepped in
+// (by thread, when merged), no longer grouped by volume: deposits from
+// different volumes of the same category are interleaved.
 //
 //Changes have been made to this object to include the OpDetBacktrackerRecords for use in the photonbacktracker
 #ifndef OPDETPHOTONTABLE_h
 #define OPDETPHOTONTABLE_h 1
 
+#include <array>
 #include <map>
-#include <unordered_map>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 
@@ -47,9 +62,20 @@ namespace larg4 {
   class OpDetPhotonTable
     {
     public:
+      /// Categories of volumes, each with its own collection of energy deposits.
+      enum EnergyDepositCategory_t {
+        kTPCActive,           ///< TPC active volumes (name containing "TPCActive")
+        kOtherVolume,         ///< all other volumes
+        NEnergyDepositCategories
+      };
+
       ~OpDetPhotonTable();
+      /// Returns the table of the calling thread, creating it if needed.
       static OpDetPhotonTable * Instance(bool LitePhotons = false);
 
+      /// Clears the tables of all the threads (see ClearTable()).
+      static void ClearAllTables(size_t nch, bool energyDeposits = true);
+
       void AddPhoton( size_t opchannel, sim::OnePhoton&& photon, bool Reflected=false);
       void AddLitePhoton( int opchannel, int time, int nphotons, bool Reflected=false);
       void AddPhoton(std::map<int, std::map<int, int>>* StepPhotonTable, bool Reflected=false);
@@ -60,12 +86,20 @@ namespace larg4 {
       sim::SimPhotons&               GetPhotonsForOpChannel(size_t opchannel);
       sim::SimPhotons&               GetReflectedPhotonsForOpChannel(size_t opchannel);
 
-      std::map<int, std::map<int, int> >    GetLitePhotons(bool Reflected=false) { return (Reflected ? fReflectedLitePhotons : fLitePhotons ); }
-      std::map<int, std::map<int, int> >    GetReflectedLitePhotons()            { return GetLitePhotons(true); }
-      std::map<int, int>&                   GetLitePhotonsForOpChannel(int opchannel)          { return fLitePhotons[opchannel]; }
-      std::map<int, int>&                   GetReflectedLitePhotonsForOpChannel(int opchannel) { return fReflectedLitePhotons[opchannel]; }
+      /// Returns the lite photons, indexed by channel (channels may have no photon).
+      std::vector<sim::SimPhotonsLite>&     GetLitePhotons(bool Reflected=false) { return (Reflected ? fReflectedLitePhotons : fLitePhotons ); }
+      std::vector<sim::SimPhotonsLite>&     GetReflectedLitePhotons()            { return GetLitePhotons(true); }
+      std::map<int, int>&                   GetLitePhotonsForOpChannel(int opchannel)          { return LitePhotonsForOpChannel(fLitePhotons, opchannel).DetectedPhotons; }
+      std::map<int, int>&                   GetReflectedLitePhotonsForOpChannel(int opchannel) { return LitePhotonsForOpChannel(fReflectedLitePhotons, opchannel).DetectedPhotons; }
+      /// Yields the lite photons of the channels with photons, and resets them.
+      std::vector<sim::SimPhotonsLite>      YieldLitePhotons(bool Reflected=false);
       void ClearTable(size_t nch=0);
 
+      /// Moves the content of `other` into this table, leaving `other` empty.
+      void Merge(OpDetPhotonTable& other);
+      /// Merges the tables of all the other threads into this one.
+      void MergeWorkerTables();
+
       void AddOpDetBacktrackerRecord(sim::OpDetBacktrackerRecord soc, bool Reflected=false);
     //  std::vector<sim::OpDetBacktrackerRecord>& GetOpDetBacktrackerRecords(); //Replaced by YieldOpDetBacktrackerRecords()
       std::vector<sim::OpDetBacktrackerRecord> YieldOpDetBacktrackerRecords();
@@ -79,25 +113,51 @@ namespace larg4 {
 			    float end_x,float end_y,float end_z,
 			    double start_time,double end_time,
 			    int trackid,int pdgcode,
-			    std::string const& vol="EMPTY");
-      /// Returns the map of energy deposits by volume name.
-      std::unordered_map<std::string, std::vector<sim::SimEnergyDeposit> > const& GetSimEnergyDeposits() const;
-      /// Yields the map of energy deposits by volume name, and resets the internal one.
-      std::unordered_map<std::string, std::vector<sim::SimEnergyDeposit> > YieldSimEnergyDeposits();
-      //std::vector<sim::SimEnergyDeposit> & GetSimEnergyDeposits();
+			    std::string const& vol="EMPTY")
+        { AddEnergyDeposit(n_photon, n_elec, scint_yield, energy,
+                           start_x, start_y, start_z, end_x, end_y, end_z,
+                           start_time, end_time, trackid, pdgcode,
+                           EnergyDepositCategory(vol)); }
+      /// Adds an energy deposit in a volume of the specified category.
+      void AddEnergyDeposit(int n_photon, int n_elec, double scint_yield,
+			    double energy,
+			    float start_x,float start_y, float start_z,
+			    float end_x,float end_y,float end_z,
+			    double start_time,double end_time,
+			    int trackid,int pdgcode,
+			    EnergyDepositCategory_t category);
+      /// Returns the energy deposits in volumes of the specified category,
+      /// in stepping order (not grouped by volume).
+      std::vector<sim::SimEnergyDeposit> const& GetSimEnergyDeposits(EnergyDepositCategory_t category) const
+        { return fSimEDepCol.at(category); }
+      /// Yields the energy deposits of the specified category, and resets them.
+      std::vector<sim::SimEnergyDeposit> YieldSimEnergyDeposits(EnergyDepositCategory_t category);
+
+      /// Returns the category of energy deposits in the volume with the specified name.
+      static EnergyDepositCategory_t EnergyDepositCategory(std::string const& volumeName);
 
     protected:
       OpDetPhotonTable();
 
     private:
 
+      /// Tables of all the threads; they live until the end of the job.
+      static std::vector<std::unique_ptr<OpDetPhotonTable>> fAllTables;
+      static std::mutex fAllTablesMutex;
+      static size_t fNOpChannels; ///< Channels in the tables, from ClearAllTables().
+
+      void ClearOpDetBacktrackerRecords();
       void AddOpDetBacktrackerRecord(std::vector< sim::OpDetBacktrackerRecord > & RecordsCol,
                                      std::map<int, int> &ChannelMap,
                                      sim::OpDetBacktrackerRecord soc);
+      /// Returns the lite photons of the channel, extending `LitePhotons` as needed.
+      static sim::SimPhotonsLite& LitePhotonsForOpChannel(std::vector<sim::SimPhotonsLite>& LitePhotons,
+                                                          int opchannel);
+      static void ResetLitePhotons(std::vector<sim::SimPhotonsLite>& LitePhotons, size_t nch);
 
 
-      std::map<int, std::map<int,int> >     fLitePhotons;
-      std::map<int, std::map<int,int> >     fReflectedLitePhotons;
+      std::vector<sim::SimPhotonsLite>      fLitePhotons;          ///< Indexed by channel.
+      std::vector<sim::SimPhotonsLite>      fReflectedLitePhotons; ///< Indexed by channel.
       std::vector< sim::OpDetBacktrackerRecord >      cOpDetBacktrackerRecordsCol; //analogous to scCol for electrons
       std::vector< sim::OpDetBacktrackerRecord >      cReflectedOpDetBacktrackerRecordsCol; //analogous to scCol for electrons
       std::map<int, int>  cOpChannelToSOCMap; //Where each OpChan is.
@@ -106,7 +166,8 @@ namespace larg4 {
       std::vector<sim::SimPhotons> fReflectedDetectedPhotons;
 
 
-      std::unordered_map<std::string, std::vector<sim::SimEnergyDeposit> > fSimEDepCol;
+      /// Energy deposits, by volume category.
+      std::array<std::vector<sim::SimEnergyDeposit>, NEnergyDepositCategories> fSimEDepCol;
 
 
     };
@@ -12,15 +12,23 @@
 
 #include "larsim/LegacyLArG4/OpDetSensitiveDetector.h"
 #include "Geant4/G4SDManager.hh"
+#include "Geant4/G4Step.hh"
+#include "Geant4/G4Track.hh"
 #include "lardataobj/Simulation/SimPhotons.h"
 #include "larsim/LegacyLArG4/OpDetLookup.h"
 #include "larsim/LegacyLArG4/OpDetPhotonTable.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace {
 
   /// Converts a photon `energy` [eV] into its Wavelength [nm]
   constexpr double Wavelength(double energy);
 
+  /// Number of photons the track of `step` stands for (its weight, if biased).
+  int PhotonCount(G4Step const& step);
+
 } // local namespace
 
 namespace larg4 {
@@ -50,7 +58,7 @@ namespace larg4 {
     bool const reflected = Wavelength(energy) > 200.0; // nm
 
     // Add this photon to the detected photons table
-    fThePhotonTable->AddLitePhoton(OpDet, static_cast<int>(time), 1, reflected);
+    fThePhotonTable->AddLitePhoton(OpDet, static_cast<int>(time), PhotonCount(*aStep), reflected);
 
   } // OpDetSensitiveDetector::AddLitePhoton()
 
@@ -85,7 +93,9 @@ namespace larg4 {
     ThePhoton.FinalLocalPosition = {
       localPosition.x() / CLHEP::cm, localPosition.y() / CLHEP::cm, localPosition.z() / CLHEP::cm};
 
-    // Add this photon to the detected photons table
+    // Add this photon to the detected photons table, once per unit of weight
+    for (int i = PhotonCount(*aStep); i > 1; --i)
+      fThePhotonTable->AddPhoton(OpDet, sim::OnePhoton(ThePhoton));
     fThePhotonTable->AddPhoton(OpDet, std::move(ThePhoton));
 
   } // OpDetSensitiveDetector::AddPhoton()
@@ -132,6 +142,13 @@ namespace {
 
   } // Wavelength()
 
+  int
+  PhotonCount(G4Step const& step)
+  {
+    // weights from OpRussianRoulette are integral
+    return std::max(1, static_cast<int>(std::lround(step.GetTrack()->GetWeight())));
+  } // PhotonCount()
+
 } // local namespace
 
 //--------------------------------------------------------
@@ -14,6 +14,8 @@
 //
 // Photons stepping into the volume are stopped and killed and their trackID,
 // 4 position and 4 momentum are stored in the relevant SimPhotons.
+// Photons carrying a weight (see OpRussianRoulette) are stored as many
+// times as their weight.
 //
 // Ben Jones, MIT, 06/04/2010
 //
@@ -130,6 +130,7 @@
 #include "larsim/LegacyLArG4/OpDetPhotonTable.h"
 #include "larsim/LegacyLArG4/OpFastScintillation.hh"
 #include "larsim/LegacyLArG4/ParticleListAction.h"
+#include "larsim/LegacyLArG4/ScintillationTimeBinning.h"
 #include "larsim/PhotonPropagation/PhotonVisibilityService.h"
 #include "larsim/Simulation/LArG4Parameters.h"
 
@@ -140,6 +141,7 @@
 
 // support libraries
 #include "cetlib_except/exception.h"
+#include "CLHEP/Random/RandBinomial.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 #include "TMath.h"
@@ -185,6 +187,7 @@ namespace larg4 {
     , fUseNhitsModel(fPVS && fPVS->UseNhitsModel())
     // for now, limit to the active volume only if semi-analytic model is used
     , fOnlyActiveVolume(usesSemiAnalyticModel())
+    , fBinnedLitePhotons(useBinnedLitePhotons())
   {
     SetProcessSubType(25); // TODO: unhardcode
     fTrackSecondariesFirst = false;
@@ -523,6 +526,15 @@ namespace larg4 {
   {
     if (step.GetTotalEnergyDeposit() <= 0) return;
 
+    G4VPhysicalVolume const* volume = step.GetPreStepPoint()->GetPhysicalVolume();
+    auto iCategory = fEDepCategories.find(volume);
+    if (iCategory == fEDepCategories.end()) {
+      iCategory =
+        fEDepCategories
+          .emplace(volume, OpDetPhotonTable::EnergyDepositCategory(volume->GetName()))
+          .first;
+    }
+
     OpDetPhotonTable::Instance()->AddEnergyDeposit(
       -1,
       -1,
@@ -539,7 +551,7 @@ namespace larg4 {
       //step.GetTrack()->GetTrackID(),
       ParticleListAction::GetCurrentTrackID(),
       step.GetTrack()->GetParticleDefinition()->GetPDGEncoding(),
-      step.GetPreStepPoint()->GetPhysicalVolume()->GetName());
+      iCategory->second);
   }
 
   bool OpFastScintillation::RecordPhotonsProduced(const G4Step& aStep,
@@ -568,12 +580,12 @@ namespace larg4 {
     //G4double      t0 = pPreStepPoint->GetGlobalTime() - fGlobalTimeOffset;
     G4double t0 = pPreStepPoint->GetGlobalTime();
 
-    G4MaterialPropertiesTable* aMaterialPropertiesTable = aMaterial->GetMaterialPropertiesTable();
+    // materials may have been added after the table was built
+    if (!fScintProperties.Covers(materialIndex)) fScintProperties.Build();
+    ScintillationProperties::Material_t const& scintProps = fScintProperties[materialIndex];
 
-    G4MaterialPropertyVector* Fast_Intensity =
-      aMaterialPropertiesTable->GetProperty("FASTCOMPONENT");
-    G4MaterialPropertyVector* Slow_Intensity =
-      aMaterialPropertiesTable->GetProperty("SLOWCOMPONENT");
+    bool const Fast_Intensity = scintProps.hasFastComponent;
+    bool const Slow_Intensity = scintProps.hasSlowComponent;
 
     if (!Fast_Intensity && !Slow_Intensity) return 1;
 
@@ -592,50 +604,15 @@ namespace larg4 {
       // The scintillation response is a function of the energy
       // deposited by particle types.
 
-      // Get the definition of the current particle
-      G4ParticleDefinition* pDef = aParticle->GetDefinition();
+      // Get the yield ratio for the current particle type
+      YieldRatio = scintProps.particleYieldRatio[ScintillationProperties::ParticleType(
+        aParticle->GetDefinition())];
 
-      // Obtain the G4MaterialPropertyVectory containing the
-      // scintillation light yield as a function of the deposited
-      // energy for the current particle type
-
-      // Protons
-      if (pDef == G4Proton::ProtonDefinition()) {
-        YieldRatio = aMaterialPropertiesTable->GetConstProperty("PROTONYIELDRATIO");
-      }
-      // Muons
-      else if (pDef == G4MuonPlus::MuonPlusDefinition() ||
-               pDef == G4MuonMinus::MuonMinusDefinition()) {
-        YieldRatio = aMaterialPropertiesTable->GetConstProperty("MUONYIELDRATIO");
-      }
-      // Pions
-      else if (pDef == G4PionPlus::PionPlusDefinition() ||
-               pDef == G4PionMinus::PionMinusDefinition()) {
-        YieldRatio = aMaterialPropertiesTable->GetConstProperty("PIONYIELDRATIO");
-      }
-      // Kaons
-      else if (pDef == G4KaonPlus::KaonPlusDefinition() ||
-               pDef == G4KaonMinus::KaonMinusDefinition()) {
-        YieldRatio = aMaterialPropertiesTable->GetConstProperty("KAONYIELDRATIO");
-      }
-      // Alphas
-      else if (pDef == G4Alpha::AlphaDefinition()) {
-        YieldRatio = aMaterialPropertiesTable->GetConstProperty("ALPHAYIELDRATIO");
-      }
-      // Electrons (must also account for shell-binding energy
-      // attributed to gamma from standard PhotoElectricEffect)
-      else if (pDef == G4Electron::ElectronDefinition() || pDef == G4Gamma::GammaDefinition()) {
-        YieldRatio = aMaterialPropertiesTable->GetConstProperty("ELECTRONYIELDRATIO");
-      }
-      // Default for particles not enumerated/listed above
-      else {
-        YieldRatio = aMaterialPropertiesTable->GetConstProperty("ELECTRONYIELDRATIO");
-      }
       // If the user has not specified yields for (p,d,t,a,carbon)
       // then these unspecified particles will default to the
       // electron's scintillation yield
       if (YieldRatio == 0) {
-        YieldRatio = aMaterialPropertiesTable->GetConstProperty("ELECTRONYIELDRATIO");
+        YieldRatio = scintProps.particleYieldRatio[ScintillationProperties::kElectron];
       }
     }
 
@@ -685,36 +662,38 @@ namespace larg4 {
       if (scnt == 1) {
         if (nscnt == 1) {
           if (Fast_Intensity) {
-            ScintillationTime = aMaterialPropertiesTable->GetConstProperty("FASTTIMECONSTANT");
+            ScintillationTime = scintProps.fastTimeConstant;
             if (fFiniteRiseTime) {
-              ScintillationRiseTime =
-                aMaterialPropertiesTable->GetConstProperty("FASTSCINTILLATIONRISETIME");
+              ScintillationRiseTime = scintProps.fastRiseTime;
             }
             ScintillationIntegral =
               (G4PhysicsOrderedFreeVector*)((*theFastIntegralTable)(materialIndex));
           }
           if (Slow_Intensity) {
-            ScintillationTime = aMaterialPropertiesTable->GetConstProperty("SLOWTIMECONSTANT");
+            ScintillationTime = scintProps.slowTimeConstant;
             if (fFiniteRiseTime) {
-              ScintillationRiseTime =
-                aMaterialPropertiesTable->GetConstProperty("SLOWSCINTILLATIONRISETIME");
+              ScintillationRiseTime = scintProps.slowRiseTime;
             }
             ScintillationIntegral =
               (G4PhysicsOrderedFreeVector*)((*theSlowIntegralTable)(materialIndex));
           }
         } //endif nscnt=1
         else {
-          if (YieldRatio == 0)
-            YieldRatio = aMaterialPropertiesTable->GetConstProperty("YIELDRATIO");
+          if (YieldRatio == 0) {
+            if (!scintProps.hasYieldRatio)
+              throw cet::exception("OpFastScintillation")
+                << "Material '" << aMaterial->GetName()
+                << "' has two scintillation components but no YIELDRATIO\n";
+            YieldRatio = scintProps.yieldRatio;
+          }
 
           if (ExcitationRatio == 1.0) { Num = std::min(YieldRatio, 1.0) * MeanNumberOfPhotons; }
           else {
             Num = std::min(ExcitationRatio, 1.0) * MeanNumberOfPhotons;
           }
-          ScintillationTime = aMaterialPropertiesTable->GetConstProperty("FASTTIMECONSTANT");
+          ScintillationTime = scintProps.fastTimeConstant;
           if (fFiniteRiseTime) {
-            ScintillationRiseTime =
-              aMaterialPropertiesTable->GetConstProperty("FASTSCINTILLATIONRISETIME");
+            ScintillationRiseTime = scintProps.fastRiseTime;
           }
           ScintillationIntegral =
             (G4PhysicsOrderedFreeVector*)((*theFastIntegralTable)(materialIndex));
@@ -723,10 +702,9 @@ namespace larg4 {
 
       else {
         Num = MeanNumberOfPhotons - Num;
-        ScintillationTime = aMaterialPropertiesTable->GetConstProperty("SLOWTIMECONSTANT");
+        ScintillationTime = scintProps.slowTimeConstant;
         if (fFiniteRiseTime) {
-          ScintillationRiseTime =
-            aMaterialPropertiesTable->GetConstProperty("SLOWSCINTILLATIONRISETIME");
+          ScintillationRiseTime = scintProps.slowRiseTime;
         }
         ScintillationIntegral =
           (G4PhysicsOrderedFreeVector*)((*theSlowIntegralTable)(materialIndex));
@@ -814,13 +792,47 @@ namespace larg4 {
             Edeposited = aStep.GetTotalEnergyDeposit();
           }
 
+          //We need to split the energy up by the number of photons so that we never try to write a 0 energy.
+          Edeposited = Edeposited / double(NPhotons);
+
+          if (fBinnedLitePhotons) {
+            // only the number of photons in each tick is stored:
+            // fill the lite photons and the BTR once per tick
+            auto const fillTick = [&](int tick, int count) {
+              tmpOpDetBTRecord.AddScintillationPhotons(
+                thisG4TrackID, tick, count, xyzPos, Edeposited * count);
+              fst->AddLitePhoton(OpChannel, tick, count, Reflected);
+            };
+            G4double const decayTime = ScintillationTime / CLHEP::ns;
+            if (scinttime::expectedBinsVisited(NPhotons, decayTime) < NPhotons) {
+              auto const binomial = [](int n, double p) {
+                return static_cast<int>(CLHEP::RandBinomial::shoot(G4Random::getTheEngine(), n, p));
+              };
+              scinttime::binPhotonTimes(NPhotons,
+                                        (t0 + step_transit_time(aStep)) / CLHEP::ns,
+                                        ScintillationRiseTime / CLHEP::ns,
+                                        decayTime,
+                                        binomial,
+                                        fillTick);
+            }
+            else {
+              // few photons on a long emission profile: sampling each is cheaper
+              std::map<int, int> tickCounts;
+              for (G4int i = 0; i < NPhotons; ++i) {
+                G4double const Time = t0 + scint_time(aStep, ScintillationTime, ScintillationRiseTime);
+                ++tickCounts[static_cast<int>(Time)];
+              }
+              for (auto const [tick, count] : tickCounts)
+                fillTick(tick, count);
+            }
+            fst->AddOpDetBacktrackerRecord(tmpOpDetBTRecord, Reflected);
+            continue;
+          }
+
           // Get the transport time distribution
           arrival_time_dist.resize(NPhotons);
           propagationTime(arrival_time_dist, x0, OpChannel, Reflected);
 
-          //We need to split the energy up by the number of photons so that we never try to write a 0 energy.
-          Edeposited = Edeposited / double(NPhotons);
-
           // Loop through the photons
           for (G4int i = 0; i < NPhotons; ++i) {
             //std::cout<<"VUV time correction: "<<arrival_time_dist[i]<<std::endl;
@@ -871,6 +883,9 @@ namespace larg4 {
   {
     if (theFastIntegralTable && theSlowIntegralTable) return;
 
+    // the scintillation constants of each material, for the steps
+    fScintProperties.Build();
+
     const G4MaterialTable* theMaterialTable = G4Material::GetMaterialTable();
     G4int numOfMaterials = G4Material::GetNumberOfMaterials();
 
@@ -1008,14 +1023,20 @@ namespace larg4 {
   }
 
   G4double
-  OpFastScintillation::scint_time(const G4Step& aStep,
-                                  G4double ScintillationTime,
-                                  G4double ScintillationRiseTime) const
+  OpFastScintillation::step_transit_time(const G4Step& aStep) const
   {
     G4StepPoint const* pPreStepPoint = aStep.GetPreStepPoint();
     G4StepPoint const* pPostStepPoint = aStep.GetPostStepPoint();
     G4double avgVelocity = (pPreStepPoint->GetVelocity() + pPostStepPoint->GetVelocity()) / 2.;
-    G4double deltaTime = aStep.GetStepLength() / avgVelocity;
+    return aStep.GetStepLength() / avgVelocity;
+  }
+
+  G4double
+  OpFastScintillation::scint_time(const G4Step& aStep,
+                                  G4double ScintillationTime,
+                                  G4double ScintillationRiseTime) const
+  {
+    G4double deltaTime = step_transit_time(aStep);
     if (ScintillationRiseTime == 0.0) {
       deltaTime = deltaTime - ScintillationTime * std::log(G4UniformRand());
     }
@@ -1494,6 +1515,21 @@ namespace larg4 {
     return fUseNhitsModel;
   } // OpFastScintillation::usesSemiAnalyticModel()
 
+  // ---------------------------------------------------------------------------
+  bool
+  OpFastScintillation::useBinnedLitePhotons() const
+  {
+    art::ServiceHandle<sim::LArG4Parameters const> lgp;
+    if (!bPropagate || !lgp->UseLitePhotons() || !lgp->UseBinnedLitePhotons()) return false;
+    if (fPVS->IncludePropTime() || fPVS->IncludeParPropTime()) {
+      mf::LogWarning("OpFastScintillation")
+        << "Binned lite photons are not supported with a propagation time model:"
+        << " photon times will be sampled one by one.";
+      return false;
+    }
+    return true;
+  } // OpFastScintillation::useBinnedLitePhotons()
+
   // ---------------------------------------------------------------------------
   void
   OpFastScintillation::detectedDirectHits(std::map<size_t, int>& DetectedNum,
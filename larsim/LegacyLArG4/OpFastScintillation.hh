@@ -85,6 +85,8 @@
 
 #include "larcorealg/Geometry/BoxBoundedGeo.h"
 #include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+#include "larsim/LegacyLArG4/OpDetPhotonTable.h"
+#include "larsim/LegacyLArG4/ScintillationProperties.h"
 #include "larsim/PhotonPropagation/PhotonVisibilityTypes.h" // phot::MappedT0s_t
 
 #include "Geant4/G4ForceCondition.hh"
@@ -101,11 +103,13 @@
 #include "TVector3.h"
 
 #include <memory> // std::unique_ptr
+#include <unordered_map>
 
 class G4EmSaturation;
 class G4Step;
 class G4Track;
 class G4VParticleChange;
+class G4VPhysicalVolume;
 namespace CLHEP {
   class RandGeneral;
 }
@@ -291,6 +295,8 @@ namespace larg4 {
 
     G4bool scintillationByParticleType;
 
+    ScintillationProperties fScintProperties; // scintillation constants of each material
+
   private:
 
     struct OpticalDetector {
@@ -303,6 +309,10 @@ namespace larg4 {
     /// Returns whether the semi-analytic visibility parametrization is being used.
     bool usesSemiAnalyticModel() const;
 
+    /// Returns whether lite photon counts can be drawn per tick
+    /// (requested, and no propagation time model).
+    bool useBinnedLitePhotons() const;
+
     int VUVHits(const double Nphotons_created,
                 geo::Point_t const& ScintPoint,
                 OpticalDetector const& opDet) const;
@@ -317,6 +327,9 @@ namespace larg4 {
     G4double single_exp(const G4double t, const G4double tau2) const;
     G4double bi_exp(const G4double t, const G4double tau1, const G4double tau2) const;
 
+    // time taken by the particle to cross the step
+    G4double step_transit_time(const G4Step& aStep) const;
+
     G4double scint_time(const G4Step& aStep,
                         G4double ScintillationTime,
                         G4double ScintillationRiseTime) const;
@@ -422,6 +435,10 @@ namespace larg4 {
 
     void ProcessStep(const G4Step& step);
 
+    /// Category of the energy deposits in each volume, resolved when first met.
+    std::unordered_map<G4VPhysicalVolume const*, OpDetPhotonTable::EnergyDepositCategory_t>
+      fEDepCategories;
+
     bool const bPropagate; ///< Whether propagation of photons is enabled.
 
     /// Photon visibility service instance.
@@ -431,6 +448,8 @@ namespace larg4 {
     bool const fUseNhitsModel = false;
     /// Whether photon propagation is performed only from active volumes
     bool const fOnlyActiveVolume = false;
+    /// Whether lite photon counts are drawn per tick rather than per photon.
+    bool const fBinnedLitePhotons = false;
     /// Allows running even if light on cryostats `C:1` and higher is not supported.
     /// Currently hard coded "no"
     bool const fOnlyOneCryostat = false;
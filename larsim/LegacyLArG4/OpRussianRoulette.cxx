@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  OpRussianRoulette.cxx
+/// \brief Russian roulette biasing of optical photons
+///
+/// See comments in OpRussianRoulette.hh
+////////////////////////////////////////////////////////////////////////
+
+#include "Geant4/G4OpProcessSubType.hh"
+#include "Geant4/G4Step.hh"
+#include "Geant4/G4StepPoint.hh"
+#include "Geant4/G4SystemOfUnits.hh"
+#include "Geant4/G4Track.hh"
+#include "Geant4/G4VProcess.hh"
+#include "Geant4/Randomize.hh"
+
+#include "larsim/LegacyLArG4/OpRussianRoulette.hh"
+
+#include <cfloat>
+#include <utility>
+
+namespace larg4 {
+
+  OpRussianRoulette::OpRussianRoulette(OpticalRouletteMap map,
+                                       G4double minPathLength,
+                                       G4int minScatters,
+                                       const G4String& processName)
+    : G4VDiscreteProcess(processName, fOptical)
+    , fMap(std::move(map))
+    , fMinPathLength(minPathLength)
+    , fMinScatters(minScatters)
+  {}
+
+  //--------------------------------------------------
+  G4VParticleChange*
+  OpRussianRoulette::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
+  {
+    aParticleChange.Initialize(aTrack);
+
+    if (aTrack.GetCurrentStepNumber() == 1) {
+      fNScatters = 0;
+      fPlayed = false;
+    }
+    if (fPlayed) return G4VDiscreteProcess::PostStepDoIt(aTrack, aStep);
+
+    G4StepPoint const* postStepPoint = aStep.GetPostStepPoint();
+    G4VProcess const* stepProcess = postStepPoint->GetProcessDefinedStep();
+    if (stepProcess && (stepProcess->GetProcessSubType() == fOpRayleigh)) ++fNScatters;
+
+    bool const due = (aTrack.GetTrackLength() >= fMinPathLength) ||
+                     ((fMinScatters > 0) && (fNScatters >= fMinScatters));
+    // photons in a sensitive volume are being recorded: leave them alone
+    if (!due || aStep.GetPreStepPoint()->GetSensitiveDetector())
+      return G4VDiscreteProcess::PostStepDoIt(aTrack, aStep);
+
+    fPlayed = true;
+    G4ThreeVector const& pos = postStepPoint->GetPosition();
+    unsigned int const weight = fMap.survivalWeight(pos.x() / cm, pos.y() / cm, pos.z() / cm);
+    if (weight > 1U) {
+      if (G4UniformRand() * weight < 1.)
+        aParticleChange.ProposeWeight(aTrack.GetWeight() * weight);
+      else
+        aParticleChange.ProposeTrackStatus(fStopAndKill);
+    }
+
+    return G4VDiscreteProcess::PostStepDoIt(aTrack, aStep);
+  }
+
+  //--------------------------------------------------
+  G4double
+  OpRussianRoulette::GetMeanFreePath(const G4Track&, G4double, G4ForceCondition* condition)
+  {
+    *condition = Forced;
+
+    return DBL_MAX;
+  }
+
+}
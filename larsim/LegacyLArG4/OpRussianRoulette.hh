@@ -0,0 +1,77 @@
+/**
+ * @file   larsim/LegacyLArG4/OpRussianRoulette.hh
+ * @brief  Russian roulette biasing of optical photons in full optical simulation.
+ * @see    larsim/LegacyLArG4/OpRussianRoulette.cxx
+ */
+
+#ifndef OpRussianRoulette_h
+#define OpRussianRoulette_h 1
+
+#include "Geant4/G4ForceCondition.hh"
+#include "Geant4/G4OpticalPhoton.hh"
+#include "Geant4/G4ProcessType.hh"
+#include "Geant4/G4String.hh"
+#include "Geant4/G4Types.hh"
+#include "Geant4/G4VDiscreteProcess.hh"
+
+#include "larsim/LegacyLArG4/OpticalRouletteMap.h"
+
+class G4ParticleDefinition;
+class G4Step;
+class G4Track;
+class G4VParticleChange;
+
+namespace larg4 {
+
+  /**
+   * @brief Discrete process killing optical photons unlikely to be detected.
+   * @see `OpticalRouletteMap`
+   *
+   * Once an optical photon has travelled `minPathLength`, or has been
+   * Rayleigh-scattered `minScatters` times, it is played at Russian roulette
+   * with the survival probability of its position in the map. A photon
+   * surviving with probability `1/k` has its weight multiplied by `k`;
+   * `OpDetSensitiveDetector` records each detected photon as many times as
+   * its weight. Each photon is played at most once, and never while inside
+   * a sensitive volume.
+   *
+   * Like `OpBoundaryProcessSimple`, the process never limits the step but
+   * is forced to act after each of them. It is loaded by
+   * `larg4::OpticalPhysics` when `sim::LArG4Parameters::UseOpticalRoulette()`
+   * is set.
+   */
+  class OpRussianRoulette : public G4VDiscreteProcess {
+  public:
+    OpRussianRoulette(OpticalRouletteMap map,
+                      G4double minPathLength,
+                      G4int minScatters,
+                      const G4String& processName = "OpRoulette");
+
+    // Returns true -> 'is applicable' only for an optical photon.
+    G4bool IsApplicable(const G4ParticleDefinition& aParticleType) override;
+
+    // Returns infinity, forcing the DoIt at every step.
+    G4double GetMeanFreePath(const G4Track&, G4double, G4ForceCondition* condition) override;
+
+    // Plays the roulette when the photon is due.
+    G4VParticleChange* PostStepDoIt(const G4Track& aTrack, const G4Step& aStep) override;
+
+  private:
+    OpticalRouletteMap const fMap;
+    G4double const fMinPathLength; ///< path length before the roulette [Geant4 units]
+    G4int const fMinScatters;      ///< scatters before the roulette (`0`: no limit)
+
+    // state of the photon being tracked (photons are tracked one at a time)
+    G4int fNScatters = 0;
+    G4bool fPlayed = false;
+  };
+
+  inline G4bool
+  OpRussianRoulette::IsApplicable(const G4ParticleDefinition& aParticleType)
+  {
+    return (&aParticleType == G4OpticalPhoton::OpticalPhoton());
+  }
+
+}
+
+#endif /* OpRussianRoulette_h */
@@ -65,16 +65,22 @@
 #include "Geant4/G4ProcessManager.hh"
 #include "Geant4/G4Proton.hh"
 #include "Geant4/G4Scintillation.hh"
+#include "Geant4/G4SystemOfUnits.hh"
 #include "Geant4/G4Triton.hh"
 
+#include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "larcore/CoreUtils/ServiceUtil.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardata/DetectorInfoServices/LArPropertiesService.h"
 #include "lardataalg/DetectorInfo/DetectorProperties.h"
 #include "lardataalg/DetectorInfo/LArProperties.h"
 #include "larsim/LegacyLArG4/OpBoundaryProcessSimple.hh"
+#include "larsim/LegacyLArG4/OpRussianRoulette.hh"
+#include "larsim/Simulation/LArG4Parameters.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include <utility>
+
 //Register optical physics in custom physics list
 
 namespace larg4 {
@@ -143,6 +149,19 @@ namespace larg4 {
       fTheBoundaryProcess_g4 = new G4OpBoundaryProcess();
     fTheWLSProcess = new G4OpWLS();
 
+    art::ServiceHandle<sim::LArG4Parameters const> lgp;
+    if (lgp->UseOpticalRoulette()) {
+      OpticalRouletteMap map{lgp->OpticalRouletteRegions(),
+                             lgp->OpticalRouletteVisibilityScale(),
+                             lgp->OpticalRouletteMinSurvival()};
+      mf::LogInfo("OpticalPhysics")
+        << "Russian roulette of optical photons after " << lgp->OpticalRouletteMinPathLength()
+        << " cm or " << lgp->OpticalRouletteMinScatters() << " scatters";
+      fTheRouletteProcess = new OpRussianRoulette(std::move(map),
+                                                  lgp->OpticalRouletteMinPathLength() * CLHEP::cm,
+                                                  lgp->OpticalRouletteMinScatters());
+    }
+
     fTheCerenkovProcess->SetMaxNumPhotonsPerStep(700);
     fTheCerenkovProcess->SetMaxBetaChangePerStep(10.0);
     fTheCerenkovProcess->SetTrackSecondariesFirst(false);
@@ -186,6 +205,7 @@ namespace larg4 {
         else
           pmanager->AddDiscreteProcess(fTheBoundaryProcess_g4);
         pmanager->AddDiscreteProcess(fTheWLSProcess);
+        if (fTheRouletteProcess) pmanager->AddDiscreteProcess(fTheRouletteProcess);
       }
     }
   }
@@ -74,6 +74,7 @@ namespace detinfo {
 namespace larg4 {
 
   class OpBoundaryProcessSimple;
+  class OpRussianRoulette;
 
   class OpticalPhysics : public G4VPhysicsConstructor {
   public:
@@ -93,6 +94,7 @@ namespace larg4 {
     OpBoundaryProcessSimple* fTheBoundaryProcess;
     G4OpBoundaryProcess* fTheBoundaryProcess_g4;
     G4OpWLS* fTheWLSProcess;
+    OpRussianRoulette* fTheRouletteProcess = nullptr;
   };
 
 }
@@ -0,0 +1,131 @@
+/**
+ * @file   larsim/LegacyLArG4/OpticalRouletteMap.h
+ * @brief  Coarse visibility map steering the Russian roulette of photons.
+ * @see    larsim/LegacyLArG4/OpRussianRoulette.hh
+ *
+ * Photons in regions from which little light reaches the optical detectors
+ * are played at Russian roulette: they survive with a probability `1/k` and
+ * the survivors count as `k` photons. Using integral weights keeps the
+ * detected photon counts integral and their expectation unchanged.
+ *
+ * This is a header-only library.
+ */
+
+#ifndef LARSIM_LEGACYLARG4_OPTICALROULETTEMAP_H
+#define LARSIM_LEGACYLARG4_OPTICALROULETTEMAP_H
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace larg4 {
+
+  /**
+   * @brief Survival probabilities of optical photons by region.
+   *
+   * Each region is a box with a coarse visibility (the fraction of the
+   * photons emitted there which are detected by any optical detector).
+   * The survival probability in a region is its visibility divided by
+   * `visibilityScale`, bounded between `minSurvival` and `1`; outside all
+   * regions photons always survive. When regions overlap, the first one
+   * in the list applies.
+   */
+  class OpticalRouletteMap {
+  public:
+    /// A region with its visibility.
+    struct Region_t {
+      double min[3]; ///< lower corner of the box [cm]
+      double max[3]; ///< upper corner of the box [cm]
+      double visibility;
+
+      bool
+      contains(double x, double y, double z) const
+      {
+        return (x >= min[0]) && (x < max[0]) && (y >= min[1]) && (y < max[1]) &&
+               (z >= min[2]) && (z < max[2]);
+      }
+    }; // Region_t
+
+    OpticalRouletteMap() = default;
+
+    /**
+     * @brief Constructor.
+     * @param regions one entry per region: `{ x1, x2, y1, y2, z1, z2, visibility }`
+     * @param visibilityScale visibility at and above which photons always survive
+     * @param minSurvival smallest survival probability
+     * @throw std::runtime_error on malformed parameters
+     */
+    OpticalRouletteMap(std::vector<std::vector<double>> const& regions,
+                       double visibilityScale,
+                       double minSurvival)
+      : fVisibilityScale{visibilityScale}, fMinSurvival{minSurvival}
+    {
+      if (fVisibilityScale <= 0.)
+        throw std::runtime_error("OpticalRouletteMap: visibility scale must be positive");
+      if (fMinSurvival <= 0. || fMinSurvival > 1.)
+        throw std::runtime_error("OpticalRouletteMap: minimum survival must be in ]0,1]");
+      for (auto const& params : regions) {
+        if (params.size() != 7U) {
+          throw std::runtime_error("OpticalRouletteMap: region with " +
+                                   std::to_string(params.size()) +
+                                   " parameters (expected 7: x1 x2 y1 y2 z1 z2 visibility)");
+        }
+        Region_t region;
+        for (int i = 0; i < 3; ++i) {
+          region.min[i] = std::min(params[2 * i], params[2 * i + 1]);
+          region.max[i] = std::max(params[2 * i], params[2 * i + 1]);
+        }
+        region.visibility = params[6];
+        fRegions.push_back(region);
+      } // for
+    }
+
+    /// Returns whether the map would ever kill a photon.
+    bool
+    empty() const
+    {
+      return fRegions.empty();
+    }
+
+    /// Returns the survival probability of a photon at the point [cm].
+    double
+    survivalProbability(double x, double y, double z) const
+    {
+      for (Region_t const& region : fRegions) {
+        if (!region.contains(x, y, z)) continue;
+        return std::clamp(region.visibility / fVisibilityScale, fMinSurvival, 1.);
+      }
+      return 1.;
+    }
+
+    /**
+     * @brief Returns the weight of a photon surviving at the point [cm].
+     *
+     * The survival probability is rounded so that this weight is integral:
+     * the photon survives with probability `1 / survivalWeight()`.
+     */
+    unsigned int
+    survivalWeight(double x, double y, double z) const
+    {
+      return weightFor(survivalProbability(x, y, z));
+    }
+
+    /// Returns the integral weight closest to `1 / survival`.
+    static unsigned int
+    weightFor(double survival)
+    {
+      return static_cast<unsigned int>(std::max(1.0, std::round(1.0 / survival)));
+    }
+
+  private:
+    std::vector<Region_t> fRegions;
+    double fVisibilityScale = 1.;
+    double fMinSurvival = 1.;
+  }; // OpticalRouletteMap
+
+} // namespace larg4
+
+#endif // LARSIM_LEGACYLARG4_OPTICALROULETTEMAP_H
@@ -28,6 +28,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
 
 //const G4bool debug = false; // unused
 
@@ -65,6 +66,17 @@ namespace larg4 {
     , fKeepEMShowerDaughters(keepEMShowerDaughters)
   {}
 
+  //----------------------------------------------------------------------------
+  void
+  ParticleListAction::SetRetentionPolicy(RetentionPolicy_t policy)
+  {
+    fPolicy = std::move(policy);
+    fThinning = TrajectoryThinning{fPolicy.trajectoryTolerance};
+    fEnergyCuts.clear();
+    for (auto const& [pdgCode, cut] : fPolicy.energyCutByPDG)
+      fEnergyCuts[std::abs(pdgCode)] = cut * CLHEP::GeV;
+  }
+
   //----------------------------------------------------------------------------
   // Begin the event
   void
@@ -76,6 +88,7 @@ namespace larg4 {
     fParentIDMap.clear();
     fCurrentTrackID = sim::NoParticleId;
     fCurrentPdgCode = 0;
+    fNStoredParticles = 0;
   }
 
   //-------------------------------------------------------------
@@ -104,6 +117,37 @@ namespace larg4 {
     return parentid;
   }
 
+  //----------------------------------------------------------------------------
+  G4double
+  ParticleListAction::EnergyCut(int pdgCode, G4ThreeVector const& position) const
+  {
+    if (fEnergyCuts.empty()) return fenergyCut;
+
+    int const key = (std::abs(pdgCode) >= 1000000000) ? 1000000000 : std::abs(pdgCode);
+    auto const iCut = fEnergyCuts.find(key);
+    if (iCut == fEnergyCuts.end()) return fenergyCut;
+
+    geo::Point_t const start{
+      position.x() / CLHEP::cm, position.y() / CLHEP::cm, position.z() / CLHEP::cm};
+    for (geo::BoxBoundedGeo const& box : fPolicy.exemptVolumes)
+      if (box.ContainsPosition(start)) return fenergyCut;
+
+    return iCut->second;
+  }
+
+  //----------------------------------------------------------------------------
+  void
+  ParticleListAction::DropCurrentParticle(int trackID, int parentID)
+  {
+    fCurrentParticle.clear();
+
+    // do add the particle to the parent id map though
+    // and set the current track id to be it's ultimate parent
+    fParentIDMap[trackID] = parentID;
+
+    fCurrentTrackID = -1 * this->GetParentage(trackID);
+  }
+
   //----------------------------------------------------------------------------
   // Create our initial simb::MCParticle object and add it to the sim::ParticleList.
   void
@@ -121,6 +165,9 @@ namespace larg4 {
     fCurrentTrackID = trackID;
     fCurrentPdgCode = pdgCode;
 
+    fPendingPoint.reset();
+    fThinning.clear();
+
     if (!fparticleList) {
       // the rest is about adding a new particle to the list: skip
       return; // note that fCurrentParticle is clear()'ed
@@ -198,17 +245,24 @@ namespace larg4 {
       // Check the energy of the particle.  If it falls below the energy
       // cut, don't add it to our list.
       G4double energy = track->GetKineticEnergy();
-      if (energy < fenergyCut) {
-        fCurrentParticle.clear();
-
-        // do add the particle to the parent id map though
-        // and set the current track id to be it's ultimate parent
-        fParentIDMap[trackID] = parentID;
-
-        fCurrentTrackID = -1 * this->GetParentage(trackID);
+      if (energy < EnergyCut(pdgCode, track->GetPosition())) {
+        DropCurrentParticle(trackID, parentID);
+        return;
+      }
 
+      // the same happens once the event has reached its quota of particles
+      if ((fPolicy.maxParticles > 0) && (fNStoredParticles >= fPolicy.maxParticles)) {
+        if (fNStoredParticles == fPolicy.maxParticles) {
+          MF_LOG_WARNING("ParticleListAction")
+            << "Reached the limit of " << fPolicy.maxParticles
+            << " stored particles in this event: the deposits of further secondary particles"
+            << " will be assigned to their stored ancestors.";
+          ++fNStoredParticles; // warn only once
+        }
+        DropCurrentParticle(trackID, parentID);
         return;
       }
+      ++fNStoredParticles;
 
       // check to see if the parent particle has been stored in the particle navigator
       // if not, then see if it is possible to walk up the fParentIDMap to find the
@@ -262,6 +316,8 @@ namespace larg4 {
     if (!fCurrentParticle.hasParticle()) return;
     assert(fparticleList);
 
+    FlushPendingPoint();
+
     // if we have found no reason to keep it, drop it!
     // (we might still need parentage information though)
     if (!fCurrentParticle.keep) {
@@ -511,14 +567,37 @@ namespace larg4 {
                                                 std::string const& process)
   {
 
-    // Add the first point in the trajectory.
-    fCurrentParticle.particle->AddTrajectoryPoint(pos, mom, process);
-
-    // also see if we can decide to keep the particle
+    // see if we can decide to keep the particle (also from thinned points)
     if (!fCurrentParticle.keep) fCurrentParticle.keep = fFilter->mustKeep(pos);
 
+    simb::MCParticle& particle = *fCurrentParticle.particle;
+    if (!fThinning.enabled() || (particle.NumberTrajectoryPoints() == 0)) {
+      particle.AddTrajectoryPoint(pos, mom, process);
+      return;
+    }
+
+    // the last point is held back until the next one shows whether
+    // the trajectory can go straight to it (within tolerance)
+    if (fPendingPoint) {
+      TVector3 const anchor = particle.Position(particle.NumberTrajectoryPoints() - 1).Vect();
+      if (!fThinning.drop(anchor, fPendingPoint->pos.Vect(), pos.Vect())) FlushPendingPoint();
+    }
+    fPendingPoint.reset(new TrajectoryPoint_t{pos, mom, process});
+
   } // ParticleListAction::AddPointToCurrentParticle()
 
   //----------------------------------------------------------------------------
+  void
+  ParticleListAction::FlushPendingPoint()
+  {
+    if (fPendingPoint && fCurrentParticle.hasParticle()) {
+      fCurrentParticle.particle->AddTrajectoryPoint(
+        fPendingPoint->pos, fPendingPoint->mom, fPendingPoint->process);
+    }
+    fPendingPoint.reset();
+    fThinning.clear();
+  } // ParticleListAction::FlushPendingPoint()
+
+  //----------------------------------------------------------------------------
 
 } // namespace LArG4
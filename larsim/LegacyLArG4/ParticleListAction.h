@@ -16,16 +16,21 @@
 #ifndef LArG4_ParticleListAction_h
 #define LArG4_ParticleListAction_h
 
+#include "Geant4/G4ThreeVector.hh"
 #include "Geant4/G4Types.hh"
 #include "TLorentzVector.h"
 
 #include "cetlib/exempt_ptr.h"
 #include "larcorealg/CoreUtils/ParticleFilters.h" // util::PositionInVolumeFilter
+#include "larcorealg/Geometry/BoxBoundedGeo.h"
+#include "larsim/LegacyLArG4/TrajectoryThinning.h"
 #include "nug4/G4Base/UserAction.h"
 #include "nusimdata/SimulationBase/simb.h" // simb::GeneratedParticleIndex_t
 
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 // Forward declarations.
 class G4Event;
@@ -92,6 +97,22 @@ namespace larg4 {
 
     }; // ParticleInfo_t
 
+    /// Additional rules on which particles and trajectory points are stored.
+    struct RetentionPolicy_t {
+      /// Minimum kinetic energy [GeV] by absolute PDG code (`1000000000` for
+      /// all nuclei); the cut from the constructor applies to the others.
+      std::map<int, double> energyCutByPDG;
+      /// Particles starting in these volumes are exempt from `energyCutByPDG`.
+      std::vector<geo::BoxBoundedGeo> exemptVolumes;
+      /// Trajectory points are dropped while tracking, as long as the stored
+      /// trajectory stays within this distance [cm] from them (`0` keeps all
+      /// points); see `TrajectoryThinning`.
+      double trajectoryTolerance = 0.;
+      /// Maximum number of secondary particles stored per Geant4 event
+      /// (`0`: no limit); primary particles are always stored.
+      unsigned int maxParticles = 0;
+    };
+
     // Standard constructors and destructors;
     ParticleListAction(double energyCut,
                        bool storeTrajectories = false,
@@ -106,6 +127,9 @@ namespace larg4 {
     virtual void PostTrackingAction(const G4Track*);
     virtual void SteppingAction(const G4Step*);
 
+    /// Sets the additional retention rules (by default, none).
+    void SetRetentionPolicy(RetentionPolicy_t policy);
+
     /// Grabs a particle filter
     void
     ParticleFilter(std::unique_ptr<util::PositionInVolumeFilter>&& filter)
@@ -163,6 +187,12 @@ namespace larg4 {
     // parentage of the provided trackid
     int GetParentage(int trackid) const;
 
+    /// Returns the energy cut for a particle starting at `position`.
+    G4double EnergyCut(int pdgCode, G4ThreeVector const& position) const;
+
+    /// Does not store the current track; its deposits go to its stored ancestor.
+    void DropCurrentParticle(int trackID, int parentID);
+
     G4double fenergyCut;             ///< The minimum energy for a particle to
                                      ///< be included in the list.
     ParticleInfo_t fCurrentParticle; ///< information about the particle currently being simulated
@@ -183,10 +213,28 @@ namespace larg4 {
     /// Map: particle track ID -> index of primary information in MC truth.
     std::map<int, GeneratedParticleIndex_t> fPrimaryTruthMap;
 
+    RetentionPolicy_t fPolicy;           ///< additional retention rules
+    std::map<int, G4double> fEnergyCuts; ///< `fPolicy.energyCutByPDG` in Geant4 units
+    unsigned int fNStoredParticles = 0;  ///< secondary particles stored in this event
+
+    /// A trajectory point not yet added to the current particle.
+    struct TrajectoryPoint_t {
+      TLorentzVector pos;
+      TLorentzVector mom;
+      std::string process;
+    };
+    /// Last point of the current particle, held back while thinning.
+    std::unique_ptr<TrajectoryPoint_t> fPendingPoint;
+    /// Points dropped since the last one added to the current particle.
+    TrajectoryThinning fThinning;
+
     /// Adds a trajectory point to the current particle, and runs the filter
     void AddPointToCurrentParticle(TLorentzVector const& pos,
                                    TLorentzVector const& mom,
                                    std::string const& process);
+
+    /// Adds the point held back by trajectory thinning, if any.
+    void FlushPendingPoint();
   };
 
 } // namespace LArG4
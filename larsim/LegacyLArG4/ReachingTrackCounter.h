@@ -0,0 +1,79 @@
+/**
+ * @file   larsim/LegacyLArG4/ReachingTrackCounter.h
+ * @brief  Bookkeeping of the stacked tracks which may reach some volumes.
+ * @see    larsim/LegacyLArG4/DirtAbortAction.h
+ *
+ * The Geant4 stacking action classifies every new track (primaries
+ * included) before it is put on a stack, and it may classify again the
+ * tracks already stacked when a new stage starts. A track leaves the stacks
+ * either when it is killed by a classification or when it is popped to be
+ * tracked. This class follows those transitions by track ID, so that the
+ * same track is never counted twice.
+ *
+ * This is a header-only library.
+ */
+
+#ifndef LARSIM_LEGACYLARG4_REACHINGTRACKCOUNTER_H
+#define LARSIM_LEGACYLARG4_REACHINGTRACKCOUNTER_H
+
+// C/C++ standard libraries
+#include <cstddef>
+#include <unordered_set>
+
+namespace larg4 {
+
+  /// Set of the stacked tracks which may reach the volumes of interest.
+  class ReachingTrackCounter {
+  public:
+    /// Forgets all the tracks (at the beginning of a new event).
+    void
+    clear()
+    {
+      fPending.clear();
+    }
+
+    /**
+     * @brief Records the classification of a track by the stacking action.
+     * @param trackID ID of the classified track
+     * @param stacked whether the track is kept on a stack of this event
+     * @param mayReach whether the track may reach the volumes
+     *
+     * A track classified again replaces its previous classification.
+     */
+    void
+    classified(int trackID, bool stacked, bool mayReach)
+    {
+      if (stacked && mayReach)
+        fPending.insert(trackID);
+      else
+        fPending.erase(trackID);
+    }
+
+    /// Records that the track with `trackID` left the stacks to be tracked.
+    void
+    released(int trackID)
+    {
+      fPending.erase(trackID);
+    }
+
+    /// Returns whether no stacked track may reach the volumes.
+    bool
+    empty() const
+    {
+      return fPending.empty();
+    }
+
+    /// Returns the number of stacked tracks which may reach the volumes.
+    std::size_t
+    size() const
+    {
+      return fPending.size();
+    }
+
+  private:
+    std::unordered_set<int> fPending; ///< IDs of the pending tracks
+  }; // ReachingTrackCounter
+
+} // namespace larg4
+
+#endif // LARSIM_LEGACYLARG4_REACHINGTRACKCOUNTER_H
@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  RegionStatisticsAction.cxx
+/// \brief Count Geant4 steps and secondaries in each region.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include "larsim/LegacyLArG4/RegionStatisticsAction.h"
+
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include "Geant4/G4LogicalVolume.hh"
+#include "Geant4/G4Region.hh"
+#include "Geant4/G4Step.hh"
+#include "Geant4/G4StepPoint.hh"
+#include "Geant4/G4VPhysicalVolume.hh"
+
+#include <iomanip>
+#include <map>
+
+namespace larg4 {
+
+  //----------------------------------------------------------------------------
+  void
+  RegionStatisticsAction::SteppingAction(const G4Step* step)
+  {
+    G4VPhysicalVolume const* volume = step->GetPreStepPoint()->GetPhysicalVolume();
+    if (!volume) return;
+    G4Region const* region = volume->GetLogicalVolume()->GetRegion();
+
+    // consecutive steps are very often in the same region
+    if (region != fLastRegion) {
+      fLastRegion = region;
+      fLastCounts = &fCounts[region];
+    }
+    ++(fLastCounts->steps);
+    if (auto const* secondaries = step->GetSecondaryInCurrentStep())
+      fLastCounts->secondaries += secondaries->size();
+  }
+
+  //----------------------------------------------------------------------------
+  void
+  RegionStatisticsAction::PrintSummary() const
+  {
+    // sort by name for a stable output
+    std::map<std::string, Counts_t> byName;
+    for (auto const& [region, counts] : fCounts)
+      byName[region ? std::string(region->GetName()) : std::string("(none)")] = counts;
+
+    mf::LogInfo log("RegionStatisticsAction");
+    log << "Geant4 steps and secondaries per region:";
+    for (auto const& [name, counts] : byName) {
+      log << "\n  " << std::setw(32) << std::left << name << std::right << std::setw(16)
+          << counts.steps << " steps " << std::setw(16) << counts.secondaries << " secondaries";
+    }
+  }
+
+} // namespace larg4
@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  RegionStatisticsAction.h
+/// \brief Count Geant4 steps and secondaries in each region.
+///
+////////////////////////////////////////////////////////////////////////
+
+/// This class implements the g4b::UserAction interface to count, for each
+/// Geant4 region, the steps taken and the secondary particles produced in
+/// it. It helps tuning the production cuts and the user limits of the
+/// regions (see `ProductionRegions` in `sim::LArG4Parameters`).
+
+#ifndef LArG4_RegionStatisticsAction_h
+#define LArG4_RegionStatisticsAction_h
+
+#include "nug4/G4Base/UserAction.h"
+
+#include <string>
+#include <unordered_map>
+
+// Forward declarations.
+class G4Region;
+class G4Step;
+
+namespace larg4 {
+
+  class RegionStatisticsAction : public g4b::UserAction {
+  public:
+    /// Counters for a region.
+    struct Counts_t {
+      unsigned long long steps = 0ULL;       ///< steps started in the region
+      unsigned long long secondaries = 0ULL; ///< secondaries created in the region
+    };
+
+    // UserActions method that we'll override, to obtain access to
+    // Geant4's steps
+    virtual void SteppingAction(const G4Step*);
+
+    /// Prints the counts of all regions into the message facility.
+    void PrintSummary() const;
+
+  private:
+    std::unordered_map<G4Region const*, Counts_t> fCounts;
+
+    G4Region const* fLastRegion = nullptr; ///< region of the last step
+    Counts_t* fLastCounts = nullptr;       ///< counts of fLastRegion
+  };
+
+} // namespace larg4
+
+#endif // LArG4_RegionStatisticsAction_h
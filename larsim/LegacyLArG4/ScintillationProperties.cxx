@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  ScintillationProperties.cxx
+/// \brief Scintillation constants of each Geant4 material, by particle type
+////////////////////////////////////////////////////////////////////////
+
+#include "larsim/LegacyLArG4/ScintillationProperties.h"
+
+#include "Geant4/G4Material.hh"
+#include "Geant4/G4MaterialPropertiesTable.hh"
+#include "Geant4/G4ParticleTypes.hh"
+
+#include "cetlib_except/exception.h"
+
+#include <algorithm>
+#include <string>
+
+namespace {
+
+  /// Prefix of the per-particle constants, by particle type.
+  constexpr char const* ParticleTypeNames[larg4::ScintillationProperties::kNParticleTypes] =
+    {"PROTON", "MUON", "PION", "KAON", "ALPHA", "ELECTRON"};
+
+  /// Returns whether a constant property is defined.
+  bool
+  hasConstProperty(G4MaterialPropertiesTable* mpt, std::string const& key)
+  {
+    // querying a key unknown to Geant4 would print a warning
+    auto const& names = mpt->GetMaterialConstPropertyNames();
+    if (std::find(names.begin(), names.end(), key) == names.end()) return false;
+    return mpt->ConstPropertyExists(key.c_str());
+  }
+
+  /// Value of an optional constant property, or 0 if not defined.
+  double
+  constProperty(G4MaterialPropertiesTable* mpt, std::string const& key)
+  {
+    return hasConstProperty(mpt, key) ? mpt->GetConstProperty(key.c_str()) : 0.;
+  }
+
+  /// Value of a constant property, which must be defined.
+  double
+  requiredConstProperty(G4MaterialPropertiesTable* mpt,
+                        std::string const& key,
+                        G4Material const& material)
+  {
+    if (!hasConstProperty(mpt, key))
+      throw cet::exception("ScintillationProperties")
+        << "Material '" << material.GetName() << "' scintillates but its properties table has no "
+        << key << "\n";
+    return mpt->GetConstProperty(key.c_str());
+  }
+
+} // local namespace
+
+namespace larg4 {
+
+  //----------------------------------------------------------------------------
+  void
+  ScintillationProperties::Build()
+  {
+    const G4MaterialTable* theMaterialTable = G4Material::GetMaterialTable();
+
+    fMaterials.clear();
+    fMaterials.reserve(theMaterialTable->size());
+    for (G4Material const* material : *theMaterialTable)
+      fMaterials.push_back(ReadMaterial(*material));
+  }
+
+  //----------------------------------------------------------------------------
+  ScintillationProperties::Material_t const&
+  ScintillationProperties::operator[](G4Material const& material) const
+  {
+    return fMaterials[material.GetIndex()];
+  }
+
+  //----------------------------------------------------------------------------
+  ScintillationProperties::ParticleType_t
+  ScintillationProperties::ParticleType(G4ParticleDefinition const* pDef)
+  {
+    if (pDef == G4Proton::ProtonDefinition()) return kProton;
+    if (pDef == G4MuonPlus::MuonPlusDefinition() || pDef == G4MuonMinus::MuonMinusDefinition())
+      return kMuon;
+    if (pDef == G4PionPlus::PionPlusDefinition() || pDef == G4PionMinus::PionMinusDefinition())
+      return kPion;
+    if (pDef == G4KaonPlus::KaonPlusDefinition() || pDef == G4KaonMinus::KaonMinusDefinition())
+      return kKaon;
+    if (pDef == G4Alpha::AlphaDefinition()) return kAlpha;
+    // electrons (must also account for shell-binding energy attributed to
+    // gamma from standard PhotoElectricEffect) and all the other particles
+    return kElectron;
+  }
+
+  //----------------------------------------------------------------------------
+  ScintillationProperties::Material_t
+  ScintillationProperties::ReadMaterial(G4Material const& material)
+  {
+    Material_t props;
+    G4MaterialPropertiesTable* mpt = material.GetMaterialPropertiesTable();
+    if (!mpt) return props;
+
+    props.hasTable = true;
+    props.hasFastComponent = (mpt->GetProperty("FASTCOMPONENT") != nullptr);
+    props.hasSlowComponent = (mpt->GetProperty("SLOWCOMPONENT") != nullptr);
+    props.hasYieldRatio = hasConstProperty(mpt, "YIELDRATIO");
+    props.yieldRatio = constProperty(mpt, "YIELDRATIO");
+    props.fastRiseTime = constProperty(mpt, "FASTSCINTILLATIONRISETIME");
+    props.slowRiseTime = constProperty(mpt, "SLOWSCINTILLATIONRISETIME");
+    if (props.hasFastComponent || props.hasSlowComponent) {
+      props.scintillationYield = requiredConstProperty(mpt, "SCINTILLATIONYIELD", material);
+      if (props.hasFastComponent)
+        props.fastTimeConstant = requiredConstProperty(mpt, "FASTTIMECONSTANT", material);
+      if (props.hasSlowComponent)
+        props.slowTimeConstant = requiredConstProperty(mpt, "SLOWTIMECONSTANT", material);
+    }
+    else {
+      props.scintillationYield = constProperty(mpt, "SCINTILLATIONYIELD");
+    }
+    for (std::size_t type = 0; type < kNParticleTypes; ++type) {
+      std::string const particle = ParticleTypeNames[type];
+      props.particleScintillationYield[type] =
+        constProperty(mpt, particle + "SCINTILLATIONYIELD");
+      props.particleYieldRatio[type] = constProperty(mpt, particle + "YIELDRATIO");
+    }
+    return props;
+  }
+
+} // namespace larg4
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  ScintillationProperties.h
+/// \brief Scintillation constants of each Geant4 material, by particle type
+///
+/// The scintillation processes (OpFastScintillation) and the calculation of
+/// the number of photons (ISCalculationSeparate) need on every step yields,
+/// yield ratios, time constants and rise times from the material properties
+/// table, which are looked up by name. This table reads them once for all
+/// the materials, so that a step only reads an array.
+////////////////////////////////////////////////////////////////////////
+#ifndef LARG4_SCINTILLATIONPROPERTIES_H
+#define LARG4_SCINTILLATIONPROPERTIES_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// forward declarations
+class G4Material;
+class G4ParticleDefinition;
+
+namespace larg4 {
+
+  class ScintillationProperties {
+  public:
+    /// Particle types with their own scintillation yield and yield ratio.
+    enum ParticleType_t {
+      kProton,   ///< PROTON...
+      kMuon,     ///< MUON...
+      kPion,     ///< PION...
+      kKaon,     ///< KAON...
+      kAlpha,    ///< ALPHA...
+      kElectron, ///< ELECTRON...; also gamma and all the other particles
+      kNParticleTypes
+    };
+
+    /**
+     * @brief The constants of one material.
+     *
+     * A material scintillates if it has a fast or slow component. Its table
+     * must then define `SCINTILLATIONYIELD` and the time constants of its
+     * components, or `Build()` throws a `cet::exception`. The other constants
+     * are optional, and they are 0 when not in the table.
+     */
+    struct Material_t {
+      bool hasTable = false;          ///< whether the material has a properties table
+      bool hasFastComponent = false;  ///< whether FASTCOMPONENT is defined
+      bool hasSlowComponent = false;  ///< whether SLOWCOMPONENT is defined
+      bool hasYieldRatio = false;     ///< whether YIELDRATIO is defined
+      double scintillationYield = 0.; ///< SCINTILLATIONYIELD
+      double yieldRatio = 0.;         ///< YIELDRATIO
+      double fastTimeConstant = 0.;   ///< FASTTIMECONSTANT
+      double slowTimeConstant = 0.;   ///< SLOWTIMECONSTANT
+      double fastRiseTime = 0.;       ///< FASTSCINTILLATIONRISETIME
+      double slowRiseTime = 0.;       ///< SLOWSCINTILLATIONRISETIME
+      /// <particle>SCINTILLATIONYIELD, by particle type
+      std::array<double, kNParticleTypes> particleScintillationYield{};
+      /// <particle>YIELDRATIO, by particle type
+      std::array<double, kNParticleTypes> particleYieldRatio{};
+    };
+
+    /// Reads the constants of all the materials in the Geant4 material table.
+    /// @throw cet::exception if a scintillating material misses a constant
+    void Build();
+
+    /// Whether the material with index `materialIndex` is in the table.
+    bool
+    Covers(std::size_t materialIndex) const
+    {
+      return materialIndex < fMaterials.size();
+    }
+
+    /// Constants of the material with `materialIndex` (must be covered).
+    Material_t const&
+    operator[](std::size_t materialIndex) const
+    {
+      return fMaterials[materialIndex];
+    }
+
+    /// Constants of `material` (must be covered).
+    Material_t const& operator[](G4Material const& material) const;
+
+    /// Returns the scintillation particle type of a particle.
+    static ParticleType_t ParticleType(G4ParticleDefinition const* pDef);
+
+  private:
+    std::vector<Material_t> fMaterials; ///< constants, by material index
+
+    static Material_t ReadMaterial(G4Material const& material);
+  };
+
+} // namespace larg4
+
+#endif // LARG4_SCINTILLATIONPROPERTIES_H
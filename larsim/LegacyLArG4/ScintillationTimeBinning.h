@@ -0,0 +1,108 @@
+/**
+ * @file   larsim/LegacyLArG4/ScintillationTimeBinning.h
+ * @brief  Sampling of the number of scintillation photons in each time bin.
+ * @see    larsim/LegacyLArG4/OpFastScintillation.cxx
+ *
+ * When only the number of photons per time tick is stored (lite photons),
+ * the emission times of the photons detected by a channel need not be
+ * sampled one by one: the counts in each tick follow a multinomial
+ * distribution with the probabilities of the emission time profile.
+ *
+ * This is a header-only library.
+ */
+
+#ifndef LARSIM_LEGACYLARG4_SCINTILLATIONTIMEBINNING_H
+#define LARSIM_LEGACYLARG4_SCINTILLATIONTIMEBINNING_H
+
+// C/C++ standard libraries
+#include <cmath>
+
+namespace larg4 {
+  namespace scinttime {
+
+    /**
+     * @brief Probability for a photon to be emitted later than `t`.
+     * @param t time since the excitation
+     * @param riseTime rise time constant of the emission (`0` for none)
+     * @param decayTime decay time constant of the emission
+     *
+     * Without rise time, the emission time is exponentially distributed.
+     * With a rise time, its density is proportional to
+     * `exp(-t/decayTime) * (1 - exp(-t/riseTime))`, the profile sampled by
+     * `OpFastScintillation::sample_time()`.
+     */
+    inline double
+    emissionSurvival(double t, double riseTime, double decayTime)
+    {
+      if (t <= 0.) return 1.;
+      if (riseTime <= 0.) return std::exp(-t / decayTime);
+      double const r = riseTime / decayTime;
+      double const combinedTime = riseTime * decayTime / (riseTime + decayTime);
+      return (1. + r) * std::exp(-t / decayTime) - r * std::exp(-t / combinedTime);
+    }
+
+    /**
+     * @brief Expected number of bins visited by `binPhotonTimes()`.
+     * @param n number of photons
+     * @param decayTime decay time constant of the emission, in bin units
+     *
+     * The sampling stops at the bin of the latest photon, whose emission time
+     * is on average `decayTime * (ln(n) + 0.58)`. Binning is cheaper than
+     * sampling each photon when this is smaller than `n`.
+     */
+    inline double
+    expectedBinsVisited(int n, double decayTime)
+    {
+      return (n > 0) ? (1. + decayTime * (std::log(double(n)) + 0.5772)) : 0.;
+    }
+
+    /**
+     * @brief Distributes photons into unit time bins by emission time.
+     * @tparam Binomial callable `(int n, double p)` returning a binomial draw
+     * @tparam Fill callable `(int bin, int count)`
+     * @param n number of photons
+     * @param startTime time of the excitation
+     * @param riseTime rise time constant of the emission (`0` for none)
+     * @param decayTime decay time constant of the emission
+     * @param binomial random binomial generator
+     * @param fill called for each bin with at least one photon
+     *
+     * A photon emitted at time `t` is assigned to bin `static_cast<int>(t)`,
+     * like the lite photons stored one by one: times are truncated toward
+     * zero, so bin `k` covers `[ k, k + 1 )` for positive `k`, `( k - 1, k ]`
+     * for negative `k`, and bin `0` covers `( -1, 1 )`. The counts are drawn
+     * in time order as conditional binomials, with probability for a photon
+     * still to be assigned to be emitted before the end of the current bin;
+     * this samples exactly the multinomial distribution of the counts.
+     */
+    template <typename Binomial, typename Fill>
+    void
+    binPhotonTimes(int n,
+                   double startTime,
+                   double riseTime,
+                   double decayTime,
+                   Binomial&& binomial,
+                   Fill&& fill)
+    {
+      int bin = static_cast<int>(startTime);
+      double lowerSurvival = 1.;
+      while (n > 0) {
+        int const upperEdge = (bin < 0) ? bin : bin + 1;
+        double const upperSurvival =
+          emissionSurvival(upperEdge - startTime, riseTime, decayTime);
+        int const count = (upperSurvival <= 0. || lowerSurvival <= 0.) ?
+                            n :
+                            binomial(n, 1. - upperSurvival / lowerSurvival);
+        if (count > 0) {
+          fill(bin, count);
+          n -= count;
+        }
+        lowerSurvival = upperSurvival;
+        ++bin;
+      } // while
+    }   // binPhotonTimes()
+
+  } // namespace scinttime
+} // namespace larg4
+
+#endif // LARSIM_LEGACYLARG4_SCINTILLATIONTIMEBINNING_H
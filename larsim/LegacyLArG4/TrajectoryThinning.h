@@ -0,0 +1,87 @@
+/**
+ * @file   larsim/LegacyLArG4/TrajectoryThinning.h
+ * @brief  Dropping of trajectory points while a particle is being tracked.
+ * @see    larsim/LegacyLArG4/ParticleListAction.h
+ *
+ * `ParticleListAction` holds back the last point of the current particle
+ * until the next one is known. The held-back point is dropped if the stored
+ * trajectory can go straight from the last stored point to the next one,
+ * passing within the tolerance from it and from all the points dropped since
+ * the last stored one; otherwise it is stored, and becomes the new anchor.
+ *
+ * This is a header-only library.
+ */
+
+#ifndef LARSIM_LEGACYLARG4_TRAJECTORYTHINNING_H
+#define LARSIM_LEGACYLARG4_TRAJECTORYTHINNING_H
+
+// ROOT libraries
+#include "TVector3.h"
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <vector>
+
+namespace larg4 {
+
+  /// Returns the distance of `p` from the segment between `a` and `b`.
+  inline double
+  distanceFromSegment(TVector3 const& p, TVector3 const& a, TVector3 const& b)
+  {
+    TVector3 const ab = b - a;
+    double const length2 = ab.Mag2();
+    if (length2 <= 0.) return (p - a).Mag();
+    double const u = std::clamp((p - a).Dot(ab) / length2, 0., 1.);
+    return (p - (a + u * ab)).Mag();
+  }
+
+  /// Decides which trajectory points of a particle can be dropped.
+  class TrajectoryThinning {
+  public:
+    /// Thinning within `tolerance` [cm]; `0` keeps all the points.
+    explicit TrajectoryThinning(double tolerance = 0.) : fTolerance(tolerance) {}
+
+    /// Returns whether any point may be dropped.
+    bool
+    enabled() const
+    {
+      return fTolerance > 0.;
+    }
+
+    /**
+     * @brief Decides whether a held-back point can be dropped.
+     * @param anchor the last stored point
+     * @param pending the held-back point
+     * @param next the point following `pending`
+     * @return whether `pending` can be dropped
+     *
+     * If the point can be dropped, it is remembered, and the following
+     * decisions will also require the trajectory to stay close to it.
+     * Otherwise, the caller stores `pending` and calls `clear()`.
+     */
+    bool
+    drop(TVector3 const& anchor, TVector3 const& pending, TVector3 const& next)
+    {
+      if (!enabled()) return false;
+      if (distanceFromSegment(pending, anchor, next) > fTolerance) return false;
+      for (TVector3 const& dropped : fDropped)
+        if (distanceFromSegment(dropped, anchor, next) > fTolerance) return false;
+      fDropped.push_back(pending);
+      return true;
+    }
+
+    /// Forgets the dropped points (a new anchor was stored).
+    void
+    clear()
+    {
+      fDropped.clear();
+    }
+
+  private:
+    double fTolerance;             ///< largest distance of a dropped point [cm]
+    std::vector<TVector3> fDropped; ///< points dropped since the anchor
+  }; // TrajectoryThinning
+
+} // namespace larg4
+
+#endif // LARSIM_LEGACYLARG4_TRAJECTORYTHINNING_H
@@ -0,0 +1,480 @@
+////////////////////////////////////////////////////////////////////////
+// Class:       CosmicRecycler
+// Module Type: filter (product mixing)
+// File:        CosmicRecycler_module.cc
+//
+// Overlays on each event simulated cosmic ray sub-events read from a pool
+// of already simulated events (the secondary input files), instead of
+// simulating fresh cosmic rays for each event.
+//
+// Each sub-event is moved with a detector symmetry (RecycledEventTransform)
+// drawn from a configured list, and shifted in time by a whole number of TPC
+// ticks, so that the SimChannel content stays on the TDC grid. The
+// MCTruths, MCParticles, SimEnergyDeposits and SimChannels of the sub-events
+// are remapped accordingly, and their track IDs are offset following the
+// MergeSimSources convention, with a different offset for each sub-event.
+// The generator particles in the MCTruths keep their track IDs. The
+// associations between MCTruths and MCParticles are carried over, so that
+// the output can be used with the backtracker like the one of LArG4.
+// Deposits shifted out of the TDC range of the readout window are dropped.
+//
+// Each pool event can be used at most MaxReuse times; the pool events used
+// in each event are stored as a list of art::EventID.
+//
+// Configuration:
+//   fileNames, readMode, ...: configuration of the pool, in the `mixHelper`
+//                             table, as for any art mixing module
+//   MCTruthTag, MCParticleTag, SimEnergyDepositTag, SimChannelTag: products
+//                             to recycle; an empty tag skips that product.
+//                             MCParticles require MCTruths; the associations
+//                             between them are read with MCParticleTag
+//   NumberOfCosmicEvents:     sub-events overlaid on each event
+//   TrackIDOffset:            track ID offset of the first sub-event
+//   TrackIDStride:            additional offset of each following sub-event
+//   TimeShiftRange:           [ min, max ] time shift [ns]
+//   Transforms:               list of { MirrorX MirrorZ Translation } tables;
+//                             a sub-event gets one of them at random
+//   WireTolerance:            largest mismatch of a wire image [cm]
+//   MaxUnmappedChannels:      largest number of channels allowed without image
+//   MaxReuse:                 largest number of uses of a pool event (0: any)
+////////////////////////////////////////////////////////////////////////
+
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Core/PtrRemapper.h"
+#include "art/Framework/IO/ProductMix/MixHelper.h"
+#include "art/Framework/Modules/MixFilter.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/SubRun.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "art_root_io/RootIOPolicy.h"
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Utilities/InputTag.h"
+#include "cetlib_except/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include "CLHEP/Random/RandFlat.h"
+#include "CLHEP/Random/RandomEngine.h"
+
+#include "TLorentzVector.h"
+#include "TVector3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "larcore/Geometry/Geometry.h"
+#include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+#include "lardataobj/Simulation/GeneratedParticleInfo.h"
+#include "lardataobj/Simulation/SimChannel.h"
+#include "lardataobj/Simulation/SimEnergyDeposit.h"
+#include "nurandom/RandomUtils/NuRandomService.h"
+#include "nusimdata/SimulationBase/MCParticle.h"
+#include "nusimdata/SimulationBase/MCTruth.h"
+#include "RecycledEventTransform.h"
+
+namespace sim {
+  class CosmicRecyclerDetail;
+}
+
+namespace {
+  using TruthParticleAssns_t = art::Assns<simb::MCTruth, simb::MCParticle, sim::GeneratedParticleInfo>;
+}
+
+class sim::CosmicRecyclerDetail {
+public:
+  CosmicRecyclerDetail(fhicl::ParameterSet const& p, art::MixHelper& helper);
+
+  // Mixing hooks.
+  size_t nSecondaries() const { return fNCosmicEvents; }
+  void startEvent(art::Event const& e);
+  void processEventIDs(art::EventIDSequence const& seq);
+  void finalizeEvent(art::Event& e);
+  void endSubRun(art::SubRun& sr);
+
+  // Mixing functions.
+  bool mixMCTruths(std::vector<std::vector<simb::MCTruth> const*> const& in,
+                   std::vector<simb::MCTruth>& out,
+                   art::PtrRemapper const&);
+  bool mixMCParticles(std::vector<std::vector<simb::MCParticle> const*> const& in,
+                      std::vector<simb::MCParticle>& out,
+                      art::PtrRemapper const&);
+  bool mixSimEnergyDeposits(std::vector<std::vector<sim::SimEnergyDeposit> const*> const& in,
+                            std::vector<sim::SimEnergyDeposit>& out,
+                            art::PtrRemapper const&);
+  bool mixSimChannels(std::vector<std::vector<sim::SimChannel> const*> const& in,
+                      std::vector<sim::SimChannel>& out,
+                      art::PtrRemapper const&);
+  bool mixTruthParticleAssns(std::vector<TruthParticleAssns_t const*> const& in,
+                             TruthParticleAssns_t& out,
+                             art::PtrRemapper const& remap);
+
+private:
+
+  /// How a sub-event is placed into the current event.
+  struct SubEvent_t {
+    RecycledEventTransform const* transform = nullptr;
+    int    tickShift = 0;      ///< time shift [TPC ticks]
+    double timeShift = 0.;     ///< time shift [ns]
+    int    trackIDOffset = 0;
+  };
+
+  size_t                    fNCosmicEvents;
+  int                       fTrackIDOffset;
+  int                       fTrackIDStride;
+  int                       fMinTickShift;
+  int                       fMaxTickShift;
+  double                    fTickPeriod;    ///< TPC tick period [ns]
+  long                      fEndTDC;        ///< TDC past the end of the readout window
+  unsigned int              fMaxReuse;
+
+  std::vector<RecycledEventTransform> fTransforms;
+
+  CLHEP::HepRandomEngine&   fEngine;
+
+  std::vector<SubEvent_t>   fSubEvents;     ///< placement of the current sub-events
+  std::vector<size_t>       fTruthOffsets;    ///< first mixed MCTruth of each sub-event
+  std::vector<size_t>       fParticleOffsets; ///< first mixed MCParticle of each sub-event
+  art::EventIDSequence      fCurrentIDs;    ///< pool events of the current event
+  std::map<art::EventID, unsigned int> fUseCount;
+  unsigned long             fNDroppedIDEs = 0;
+
+  static int OffsetTrackID(int trackID, int offset)
+    { return (trackID >= 0)? trackID + offset : trackID - offset; }
+
+  TLorentzVector Position(TLorentzVector const& x, SubEvent_t const& sub) const;
+  TLorentzVector Momentum(TLorentzVector const& p, SubEvent_t const& sub) const;
+  simb::MCParticle Transformed(simb::MCParticle const& p, SubEvent_t const& sub,
+                               int trackIDOffset) const;
+
+};
+
+
+sim::CosmicRecyclerDetail::CosmicRecyclerDetail(fhicl::ParameterSet const& p,
+                                                art::MixHelper& helper)
+  : fNCosmicEvents(p.get<size_t>("NumberOfCosmicEvents", 1))
+  , fTrackIDOffset(p.get<int>("TrackIDOffset", 10000000))
+  , fTrackIDStride(p.get<int>("TrackIDStride", 1000000))
+  , fMaxReuse(p.get<unsigned int>("MaxReuse", 0))
+  , fEngine(helper.createEngine(0, "HepJamesRandom", "recycle"))
+{
+  art::ServiceHandle<rndm::NuRandomService>()
+    ->registerAndSeedEngine(fEngine, "HepJamesRandom", "recycle", p, "Seed");
+
+  // time shifts are whole TPC ticks, so that they apply to the SimChannel TDCs
+  auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataForJob();
+  fTickPeriod = clockData.TPCClock().TickPeriod() * 1000.;
+  auto const detProp = art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataForJob();
+  fEndTDC = (long) std::ceil(clockData.TPCTick2TDC(detProp.NumberTimeSamples()));
+
+  std::vector<double> const timeShiftRange
+    = p.get< std::vector<double> >("TimeShiftRange", {0., 0.});
+  if(timeShiftRange.size() != 2 || timeShiftRange[0] > timeShiftRange[1])
+    throw cet::exception("CosmicRecycler") << "TimeShiftRange must be [ min, max ].\n";
+  fMinTickShift = (int) std::ceil(timeShiftRange[0] / fTickPeriod);
+  fMaxTickShift = (int) std::floor(timeShiftRange[1] / fTickPeriod);
+  if(fMinTickShift > fMaxTickShift)
+    throw cet::exception("CosmicRecycler")
+      << "TimeShiftRange [ " << timeShiftRange[0] << ", " << timeShiftRange[1]
+      << " ] ns includes no whole TPC tick (" << fTickPeriod << " ns).\n";
+
+  // the transforms, validated against the geometry
+  geo::GeometryCore const& geom = *(art::ServiceHandle<geo::Geometry const>());
+  double const tolerance = p.get<double>("WireTolerance", 0.01);
+  size_t const maxUnmapped = p.get<size_t>("MaxUnmappedChannels", 0);
+  auto const transformConfigs
+    = p.get< std::vector<fhicl::ParameterSet> >("Transforms", {fhicl::ParameterSet{}});
+  if(transformConfigs.empty())
+    throw cet::exception("CosmicRecycler") << "At least one entry in Transforms is required.\n";
+  for(fhicl::ParameterSet const& config : transformConfigs){
+    std::vector<double> const translation
+      = config.get< std::vector<double> >("Translation", {0., 0., 0.});
+    if(translation.size() != 3)
+      throw cet::exception("CosmicRecycler") << "Translation must have three components.\n";
+    fTransforms.emplace_back(geom,
+                             config.get<bool>("MirrorX", false),
+                             config.get<bool>("MirrorZ", false),
+                             geo::Vector_t{translation[0], translation[1], translation[2]},
+                             tolerance);
+    if(fTransforms.back().NUnmappedChannels() > maxUnmapped)
+      throw cet::exception("CosmicRecycler")
+        << "Transform #" << (fTransforms.size() - 1) << " leaves "
+        << fTransforms.back().NUnmappedChannels()
+        << " channels without image (MaxUnmappedChannels: " << maxUnmapped
+        << "): it is not a symmetry of this detector.\n";
+  }
+
+  auto const truthTag = p.get<art::InputTag>("MCTruthTag", "generator");
+  auto const mcpTag = p.get<art::InputTag>("MCParticleTag", "largeant");
+  auto const edepTag = p.get<art::InputTag>("SimEnergyDepositTag", "");
+  auto const scTag = p.get<art::InputTag>("SimChannelTag", "largeant");
+
+  // MCParticles without their MCTruths would break the backtracking
+  if(!mcpTag.label().empty() && truthTag.label().empty())
+    throw cet::exception("CosmicRecycler")
+      << "MCParticleTag requires MCTruthTag, to associate the recycled particles to their truth.\n";
+
+  // the associations are remapped after the collections they point to
+  if(!truthTag.label().empty())
+    helper.declareMixOp(truthTag, &CosmicRecyclerDetail::mixMCTruths, *this);
+  if(!mcpTag.label().empty()){
+    helper.declareMixOp(mcpTag, &CosmicRecyclerDetail::mixMCParticles, *this);
+    helper.declareMixOp(mcpTag, &CosmicRecyclerDetail::mixTruthParticleAssns, *this);
+  }
+  if(!edepTag.label().empty())
+    helper.declareMixOp(edepTag, &CosmicRecyclerDetail::mixSimEnergyDeposits, *this);
+  if(!scTag.label().empty())
+    helper.declareMixOp(scTag, &CosmicRecyclerDetail::mixSimChannels, *this);
+
+  helper.produces<art::EventIDSequence>();
+}
+
+void sim::CosmicRecyclerDetail::startEvent(art::Event const&)
+{
+  fSubEvents.resize(fNCosmicEvents);
+  for(size_t i=0; i<fNCosmicEvents; i++){
+    SubEvent_t& sub = fSubEvents[i];
+    sub.transform = &fTransforms[CLHEP::RandFlat::shootInt(&fEngine, (long) fTransforms.size())];
+    sub.tickShift = (int) CLHEP::RandFlat::shootInt(&fEngine, fMinTickShift, fMaxTickShift + 1);
+    sub.timeShift = sub.tickShift * fTickPeriod;
+    sub.trackIDOffset = fTrackIDOffset + (int) i * fTrackIDStride;
+  }
+}
+
+void sim::CosmicRecyclerDetail::processEventIDs(art::EventIDSequence const& seq)
+{
+  fCurrentIDs = seq;
+  for(art::EventID const& id : seq){
+    unsigned int const count = ++fUseCount[id];
+    if(fMaxReuse > 0 && count > fMaxReuse)
+      throw cet::exception("CosmicRecycler")
+        << "Pool event " << id << " would be used " << count << " times, more than MaxReuse ("
+        << fMaxReuse << "): the pool is too small for this job.\n";
+  }
+}
+
+void sim::CosmicRecyclerDetail::finalizeEvent(art::Event& e)
+{
+  e.put(std::make_unique<art::EventIDSequence>(std::move(fCurrentIDs)));
+  fCurrentIDs.clear();
+}
+
+void sim::CosmicRecyclerDetail::endSubRun(art::SubRun&)
+{
+  unsigned int maxCount = 0;
+  for(auto const& [id, count] : fUseCount) maxCount = std::max(maxCount, count);
+  mf::LogInfo("CosmicRecycler")
+    << fUseCount.size() << " pool events used so far, up to " << maxCount << " times each; "
+    << fNDroppedIDEs << " IDEs dropped (out of the readout window TDC range or without image channel).";
+}
+
+TLorentzVector sim::CosmicRecyclerDetail::Position(TLorentzVector const& x,
+                                                   SubEvent_t const& sub) const
+{
+  geo::Point_t const pos = sub.transform->Position({x.X(), x.Y(), x.Z()});
+  return {pos.X(), pos.Y(), pos.Z(), x.T() + sub.timeShift};
+}
+
+TLorentzVector sim::CosmicRecyclerDetail::Momentum(TLorentzVector const& p,
+                                                   SubEvent_t const& sub) const
+{
+  geo::Vector_t const mom = sub.transform->Direction({p.Px(), p.Py(), p.Pz()});
+  return {mom.X(), mom.Y(), mom.Z(), p.E()};
+}
+
+simb::MCParticle sim::CosmicRecyclerDetail::Transformed(simb::MCParticle const& p,
+                                                        SubEvent_t const& sub,
+                                                        int offset) const
+{
+
+  // primaries keep no mother
+  simb::MCParticle out(OffsetTrackID(p.TrackId(), offset),
+                       p.PdgCode(),
+                       p.Process(),
+                       (p.Mother() == 0)? 0 : OffsetTrackID(p.Mother(), offset),
+                       p.Mass(),
+                       p.StatusCode());
+
+  simb::MCTrajectory const& traj = p.Trajectory();
+  auto const& processes = traj.TrajectoryProcesses();
+  auto itProcess = processes.begin();
+  for(size_t i=0; i<p.NumberTrajectoryPoints(); i++){
+    TLorentzVector const pos = Position(p.Position(i), sub);
+    TLorentzVector const mom = Momentum(p.Momentum(i), sub);
+    if(itProcess != processes.end() && itProcess->first == i){
+      out.AddTrajectoryPoint(pos, mom, traj.KeyToProcess(itProcess->second));
+      ++itProcess;
+    }
+    else out.AddTrajectoryPoint(pos, mom);
+  }
+
+  out.SetEndProcess(p.EndProcess());
+  TVector3 const& pol = p.Polarization();
+  geo::Vector_t const polImage = sub.transform->Direction({pol.X(), pol.Y(), pol.Z()});
+  out.SetPolarization(TVector3(polImage.X(), polImage.Y(), polImage.Z()));
+  out.SetRescatter(p.Rescatter());
+  out.SetWeight(p.Weight());
+  out.SetGvtx(Position(p.GetGvtx(), sub));
+  for(int i=0; i<p.NumberDaughters(); i++)
+    out.AddDaughter(OffsetTrackID(p.Daughter(i), offset));
+
+  return out;
+}
+
+bool sim::CosmicRecyclerDetail::mixMCTruths(
+  std::vector<std::vector<simb::MCTruth> const*> const& in,
+  std::vector<simb::MCTruth>& out,
+  art::PtrRemapper const&)
+{
+  fTruthOffsets.clear();
+  size_t n = 0;
+  for(auto const* truths : in){
+    fTruthOffsets.push_back(n);
+    n += truths->size();
+  }
+  out.reserve(n);
+
+  for(size_t i_sub=0; i_sub<in.size(); i_sub++){
+    SubEvent_t const& sub = fSubEvents[i_sub];
+    for(simb::MCTruth const& truth : *in[i_sub]){
+      simb::MCTruth moved;
+      moved.SetOrigin(truth.Origin());
+      for(int i=0; i<truth.NParticles(); i++)
+        moved.Add(Transformed(truth.GetParticle(i), sub, 0));
+      // the neutrino is rebuilt from the (moved) particles
+      if(truth.NeutrinoSet()){
+        simb::MCNeutrino const& nu = truth.GetNeutrino();
+        moved.SetNeutrino(nu.CCNC(), nu.Mode(), nu.InteractionType(), nu.Target(),
+                          nu.HitNuc(), nu.HitQuark(), nu.W(), nu.X(), nu.Y(), nu.QSqr());
+      }
+      out.push_back(std::move(moved));
+    }
+  }
+
+  return true;
+}
+
+bool sim::CosmicRecyclerDetail::mixMCParticles(
+  std::vector<std::vector<simb::MCParticle> const*> const& in,
+  std::vector<simb::MCParticle>& out,
+  art::PtrRemapper const&)
+{
+  fParticleOffsets.clear();
+  size_t n = 0;
+  for(auto const* particles : in){
+    fParticleOffsets.push_back(n);
+    n += particles->size();
+  }
+  out.reserve(n);
+
+  for(size_t i_sub=0; i_sub<in.size(); i_sub++){
+    SubEvent_t const& sub = fSubEvents[i_sub];
+    for(simb::MCParticle const& p : *in[i_sub])
+      out.push_back(Transformed(p, sub, sub.trackIDOffset));
+  }
+
+  return true;
+}
+
+bool sim::CosmicRecyclerDetail::mixTruthParticleAssns(
+  std::vector<TruthParticleAssns_t const*> const& in,
+  TruthParticleAssns_t& out,
+  art::PtrRemapper const& remap)
+{
+  // the particles keep their generator particle index in the MCTruth
+  for(size_t i_sub=0; i_sub<in.size(); i_sub++){
+    TruthParticleAssns_t const& assns = *in[i_sub];
+    for(size_t i=0; i<assns.size(); i++){
+      out.addSingle(remap(assns[i].first, fTruthOffsets[i_sub]),
+                    remap(assns[i].second, fParticleOffsets[i_sub]),
+                    assns.data(i));
+    }
+  }
+
+  return true;
+}
+
+bool sim::CosmicRecyclerDetail::mixSimEnergyDeposits(
+  std::vector<std::vector<sim::SimEnergyDeposit> const*> const& in,
+  std::vector<sim::SimEnergyDeposit>& out,
+  art::PtrRemapper const&)
+{
+  size_t n = 0;
+  for(auto const* edeps : in) n += edeps->size();
+  out.reserve(n);
+
+  for(size_t i_sub=0; i_sub<in.size(); i_sub++){
+    SubEvent_t const& sub = fSubEvents[i_sub];
+    for(sim::SimEnergyDeposit const& edep : *in[i_sub]){
+      out.emplace_back(edep.NumPhotons(),
+                       edep.NumElectrons(),
+                       edep.ScintYieldRatio(),
+                       edep.Energy(),
+                       sub.transform->Position(edep.Start()),
+                       sub.transform->Position(edep.End()),
+                       edep.StartT() + sub.timeShift,
+                       edep.EndT() + sub.timeShift,
+                       OffsetTrackID(edep.TrackID(), sub.trackIDOffset),
+                       edep.PdgCode());
+    }
+  }
+
+  return true;
+}
+
+bool sim::CosmicRecyclerDetail::mixSimChannels(
+  std::vector<std::vector<sim::SimChannel> const*> const& in,
+  std::vector<sim::SimChannel>& out,
+  art::PtrRemapper const&)
+{
+  // sub-events may share channels: merge them, sorted by channel
+  std::map<raw::ChannelID_t, sim::SimChannel> channels;
+
+  for(size_t i_sub=0; i_sub<in.size(); i_sub++){
+    SubEvent_t const& sub = fSubEvents[i_sub];
+    for(sim::SimChannel const& sc : *in[i_sub]){
+
+      raw::ChannelID_t const channel = sub.transform->Channel(sc.Channel());
+      if(channel == raw::InvalidChannelID){
+        for(auto const& tdcide : sc.TDCIDEMap()) fNDroppedIDEs += tdcide.second.size();
+        continue;
+      }
+      sim::SimChannel& merged = channels.try_emplace(channel, channel).first->second;
+
+      for(auto const& [tdc, ides] : sc.TDCIDEMap()){
+        long const shiftedTDC = (long) tdc + sub.tickShift;
+        if(shiftedTDC < 0 || shiftedTDC >= fEndTDC){
+          fNDroppedIDEs += ides.size();
+          continue;
+        }
+        for(sim::IDE const& ide : ides){
+          geo::Point_t const pos = sub.transform->Position({ide.x, ide.y, ide.z});
+          double const xyz[3] = {pos.X(), pos.Y(), pos.Z()};
+          merged.AddIonizationElectrons(OffsetTrackID(ide.trackID, sub.trackIDOffset),
+                                        (unsigned int) shiftedTDC,
+                                        ide.numElectrons,
+                                        xyz,
+                                        ide.energy);
+        }
+      }
+    }
+  }
+
+  out.reserve(channels.size());
+  for(auto& [channel, sc] : channels) out.push_back(std::move(sc));
+
+  return true;
+}
+
+namespace sim {
+  using CosmicRecycler = art::MixFilter<CosmicRecyclerDetail, art::RootIOPolicy>;
+}
+
+DEFINE_ART_MODULE(sim::CosmicRecycler)
@@ -0,0 +1,105 @@
+/*!
+ * Title:   RecycledEventTransform
+ *
+ * Description:
+ * A detector symmetry applied to a simulated event which is reused in another
+ * event. See RecycledEventTransform.h.
+ *
+*/
+
+#include <cmath>
+#include <optional>
+
+#include "larcorealg/Geometry/BoxBoundedGeo.h"
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+#include "larcorealg/Geometry/WireGeo.h"
+
+#include "RecycledEventTransform.h"
+
+sim::RecycledEventTransform::RecycledEventTransform(geo::GeometryCore const& geom,
+                                                   bool mirrorX,
+                                                   bool mirrorZ,
+                                                   geo::Vector_t const& translation,
+                                                   double tolerance)
+  : fMirrorX(mirrorX)
+  , fMirrorZ(mirrorZ)
+  , fTranslation(translation)
+{
+  // the symmetry centre is the one of the box including all active volumes
+  std::optional<geo::BoxBoundedGeo> active;
+  for(geo::CryostatGeo const& cryo : geom.IterateCryostats()){
+    for(geo::TPCGeo const& tpc : cryo.IterateTPCs()){
+      if(active) active->ExtendToInclude(tpc.ActiveBoundingBox());
+      else       active.emplace(tpc.ActiveBoundingBox());
+    }
+  }
+  if(active) fCenter = active->Center();
+
+  if(IsIdentity()) return;
+
+  fChannels.resize(geom.Nchannels(), raw::InvalidChannelID);
+  for(raw::ChannelID_t channel=0; channel<geom.Nchannels(); channel++){
+    std::vector<geo::WireID> const wires = geom.ChannelToWire(channel);
+    if(wires.empty()) continue;
+
+    geo::WireGeo const& wire = geom.Wire(wires.front());
+    bool const collection = (geom.SignalType(wires.front()) == geo::kCollection);
+    fChannels[channel] = WireImage(geom,
+                                   Position(wire.GetCenter<geo::Point_t>()),
+                                   Direction(wire.Direction<geo::Vector_t>()),
+                                   collection,
+                                   tolerance);
+    if(fChannels[channel] == raw::InvalidChannelID) ++fNUnmapped;
+  }
+}
+
+geo::Point_t sim::RecycledEventTransform::Position(geo::Point_t const& pos) const
+{
+  geo::Point_t image = pos;
+  if(fMirrorX) image.SetX(2.*fCenter.X() - pos.X());
+  if(fMirrorZ) image.SetZ(2.*fCenter.Z() - pos.Z());
+  return image + fTranslation;
+}
+
+geo::Vector_t sim::RecycledEventTransform::Direction(geo::Vector_t const& dir) const
+{
+  geo::Vector_t image = dir;
+  if(fMirrorX) image.SetX(-dir.X());
+  if(fMirrorZ) image.SetZ(-dir.Z());
+  return image;
+}
+
+raw::ChannelID_t sim::RecycledEventTransform::WireImage(geo::GeometryCore const& geom,
+                                                       geo::Point_t const& center,
+                                                       geo::Vector_t const& dir,
+                                                       bool collection,
+                                                       double tolerance) const
+{
+  geo::TPCGeo const* tpc = geom.PositionToTPCptr(center);
+  if(!tpc) return raw::InvalidChannelID;
+
+  for(unsigned int p=0; p<tpc->Nplanes(); p++){
+    geo::PlaneGeo const& plane = tpc->Plane(p);
+    if((geom.SignalType(plane.ID()) == geo::kCollection) != collection) continue;
+
+    // the image must lie on the plane, so that the drift time is the same
+    if(std::abs(plane.DistanceFromPlane(center)) > tolerance) continue;
+
+    // ... and be parallel to its wires (within tolerance at the wire ends)
+    geo::WireGeo const& planeWire = plane.Wire(0);
+    geo::Vector_t const planeDir = planeWire.Direction<geo::Vector_t>();
+    if(planeDir.Cross(dir).R() * planeWire.HalfL() > tolerance) continue;
+
+    // ... and on one of them
+    double const wireCoord = plane.WireCoordinate(center);
+    double const nearest = std::round(wireCoord);
+    if(std::abs(wireCoord - nearest) * plane.WirePitch() > tolerance) continue;
+    if(nearest < 0 || nearest >= plane.Nwires()) continue;
+
+    return geom.PlaneWireToChannel(geo::WireID(plane.ID(), (geo::WireID::WireID_t) nearest));
+  }
+  return raw::InvalidChannelID;
+}
@@ -0,0 +1,91 @@
+#ifndef RECYCLEDEVENTTRANSFORM_H
+#define RECYCLEDEVENTTRANSFORM_H
+
+/*!
+ * Title:   RecycledEventTransform
+ *
+ * Description:
+ * A detector symmetry applied to a simulated event which is reused (recycled)
+ * in another event: an optional mirroring about the centre of the active
+ * volumes in the drift (x) and beam (z) directions, followed by a translation.
+ * Vertical (y) mirroring is not offered, since it would turn downward-going
+ * cosmic rays upward.
+ *
+ * Since the ionization on a channel can't be moved to another one with a
+ * different geometry, the transform is validated against the geometry: each
+ * wire must be mapped onto a wire of the same signal type, parallel to it,
+ * lying on a plane (so that the drift time is unchanged). The image channel of
+ * each channel is tabulated; channels without an image are reported.
+ *
+*/
+
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace geo {
+  class GeometryCore;
+}
+
+namespace sim {
+
+  class RecycledEventTransform {
+
+  public:
+    /// Identity transform, without channel table.
+    RecycledEventTransform() = default;
+
+    /**
+     * @brief Constructor: builds the transform and its channel table.
+     * @param geom the detector geometry
+     * @param mirrorX mirror the drift coordinate about the active volume centre
+     * @param mirrorZ mirror the beam coordinate about the active volume centre
+     * @param translation translation applied after the mirroring [cm]
+     * @param tolerance largest mismatch between a wire image and a wire [cm]
+     */
+    RecycledEventTransform(geo::GeometryCore const& geom,
+                           bool mirrorX,
+                           bool mirrorZ,
+                           geo::Vector_t const& translation,
+                           double tolerance);
+
+    /// Whether the transform leaves everything unchanged.
+    bool IsIdentity() const { return !fMirrorX && !fMirrorZ && (fTranslation == geo::Vector_t{}); }
+
+    /// Image of a position.
+    geo::Point_t Position(geo::Point_t const& pos) const;
+
+    /// Image of a direction (or momentum).
+    geo::Vector_t Direction(geo::Vector_t const& dir) const;
+
+    /// Image of a channel; `raw::InvalidChannelID` if the channel has none.
+    raw::ChannelID_t Channel(raw::ChannelID_t channel) const
+      { return fChannels.empty() ? channel : fChannels[channel]; }
+
+    /// Number of channels with wires which have no image.
+    std::size_t NUnmappedChannels() const { return fNUnmapped; }
+
+  private:
+
+    bool          fMirrorX = false;
+    bool          fMirrorZ = false;
+    geo::Point_t  fCenter;      ///< centre of the active volumes [cm]
+    geo::Vector_t fTranslation; ///< translation after mirroring [cm]
+
+    std::vector<raw::ChannelID_t> fChannels; ///< image of each channel
+    std::size_t fNUnmapped = 0;              ///< channels without image
+
+    /// Image of the channel of a wire with the specified center and direction.
+    raw::ChannelID_t WireImage(geo::GeometryCore const& geom,
+                               geo::Point_t const& center,
+                               geo::Vector_t const& dir,
+                               bool collection,
+                               double tolerance) const;
+
+  }; //end RecycledEventTransform class
+
+} //end namespace sim
+
+#endif
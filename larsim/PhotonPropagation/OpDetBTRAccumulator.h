@@ -0,0 +1,149 @@
+/**
+ * @file   larsim/PhotonPropagation/OpDetBTRAccumulator.h
+ * @brief  Collects the backtracking information of detected photons by channel.
+ * @see    larsim/PhotonPropagation/PDFastSimPVS_module.cc
+ *         larsim/PhotonPropagation/PDFastSimPAR_module.cc
+ *
+ * The fast optical simulation detects photons from each energy deposit on
+ * many channels. Instead of creating a `sim::OpDetBacktrackerRecord` for each
+ * deposit and channel and merging it into the record of the channel, the
+ * photons are appended to a list per channel, and the records are built once
+ * at the end of the event.
+ *
+ * This is a header-only library.
+ */
+
+#ifndef LARSIM_PHOTONPROPAGATION_OPDETBTRACCUMULATOR_H
+#define LARSIM_PHOTONPROPAGATION_OPDETBTRACCUMULATOR_H
+
+// LArSoft libraries
+#include "lardataobj/Simulation/OpDetBacktrackerRecord.h"
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace phot {
+
+  /**
+   * @brief Accumulates the detected photons of each optical channel.
+   *
+   * Photons are added with `add()`, which appends them to the list of the
+   * channel (consecutive photons from the same track, position and time are
+   * merged). `makeRecords()` then creates one `sim::OpDetBacktrackerRecord`
+   * for each channel with photons, in channel order, adding the photons in
+   * time order; this gives the same content as adding each photon directly
+   * to the record of its channel.
+   *
+   * The lists keep their memory after `makeRecords()` and `reset()`, so that
+   * it is reused in the next event.
+   */
+  class OpDetBTRAccumulator {
+  public:
+    /// Constructor: no photons on `nChannels` channels.
+    explicit OpDetBTRAccumulator(std::size_t nChannels = 0) : fChannels(nChannels) {}
+
+    /// Removes all the photons and sets the number of channels.
+    void
+    reset(std::size_t nChannels)
+    {
+      clear();
+      fChannels.resize(nChannels);
+    }
+
+    /// Removes all the photons.
+    void
+    clear()
+    {
+      for (auto& entries : fChannels)
+        entries.clear();
+    }
+
+    /// Number of channels.
+    std::size_t
+    nChannels() const
+    {
+      return fChannels.size();
+    }
+
+    /// Number of entries collected on `channel` (after merging).
+    std::size_t
+    nEntries(std::size_t channel) const
+    {
+      return fChannels[channel].size();
+    }
+
+    /**
+     * @brief Adds photons detected on a channel.
+     * @param channel the optical channel (must be smaller than `nChannels()`)
+     * @param trackID the track which produced the photons
+     * @param time detection time [ns]
+     * @param nPhotons number of photons
+     * @param xyz position of the origin of the photons [cm]
+     * @param energy energy deposited for the photons [MeV]
+     */
+    void
+    add(std::size_t channel,
+        int trackID,
+        double time,
+        double nPhotons,
+        double const* xyz,
+        double energy)
+    {
+      std::vector<Entry_t>& entries = fChannels[channel];
+      if (!entries.empty()) {
+        Entry_t& last = entries.back();
+        if ((last.time == time) && (last.trackID == trackID) && (last.x == xyz[0]) &&
+            (last.y == xyz[1]) && (last.z == xyz[2])) {
+          last.nPhotons += nPhotons;
+          last.energy += energy;
+          return;
+        }
+      }
+      entries.push_back({time, trackID, nPhotons, energy, xyz[0], xyz[1], xyz[2]});
+    }
+
+    /// Returns the records of all the channels with photons, and clears them.
+    std::vector<sim::OpDetBacktrackerRecord>
+    makeRecords()
+    {
+      std::vector<sim::OpDetBacktrackerRecord> records;
+      for (std::size_t channel = 0; channel < fChannels.size(); ++channel) {
+        std::vector<Entry_t>& entries = fChannels[channel];
+        if (entries.empty()) continue;
+
+        // in time order the record appends each new time instead of inserting
+        // it; the relative order of photons at the same time is preserved
+        std::stable_sort(entries.begin(), entries.end(), [](Entry_t const& a, Entry_t const& b) {
+          return a.time < b.time;
+        });
+
+        sim::OpDetBacktrackerRecord record(channel);
+        for (Entry_t const& entry : entries) {
+          double const xyz[3] = {entry.x, entry.y, entry.z};
+          record.AddScintillationPhotons(entry.trackID, entry.time, entry.nPhotons, xyz,
+                                         entry.energy);
+        }
+        records.push_back(std::move(record));
+        entries.clear();
+      }
+      return records;
+    }
+
+  private:
+    /// Photons from a track at a position, detected at the same time.
+    struct Entry_t {
+      double time;     ///< detection time [ns]
+      int trackID;     ///< track which produced the photons
+      double nPhotons; ///< number of photons
+      double energy;   ///< energy deposited for the photons [MeV]
+      double x, y, z;  ///< position of the origin of the photons [cm]
+    };
+
+    std::vector<std::vector<Entry_t>> fChannels; ///< photons of each channel
+  };                                             // class OpDetBTRAccumulator
+
+} // namespace phot
+
+#endif // LARSIM_PHOTONPROPAGATION_OPDETBTRACCUMULATOR_H
@@ -24,6 +24,9 @@
 //  of the Geant4 step for a given optical channel.
 //  - other photon information is got from 'sim::SimEnergyDeposits'
 //  - add 'sim::OpDetBacktrackerRecord' to event
+// Deposits whose light can't arrive in the readout window can be skipped,
+// configured by the optional 'DepositTimeWindow' table (see
+// 'sim::DepositTimeWindow'; default maximum delay: 20 us).
 // Aug. 19 by Mu Wei
 ////////////////////////////////////////////////////////////////////////
 
@@ -47,15 +50,21 @@
 #include "larcorealg/CoreUtils/enumerate.h"
 #include "larcorealg/Geometry/CryostatGeo.h"
 #include "larcorealg/Geometry/OpDetGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
 #include "larcorealg/Geometry/geo_vectors_utils.h"         // geo::vect::fillCoords()
-#include "larcorealg/Geometry/geo_vectors_utils_TVector.h" // geo::vect::toTVector3()
+#include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardata/DetectorInfoServices/LArPropertiesService.h"
 #include "lardataobj/Simulation/OpDetBacktrackerRecord.h"
 #include "lardataobj/Simulation/SimEnergyDeposit.h"
 #include "lardataobj/Simulation/SimPhotons.h"
+#include "larsim/PhotonPropagation/OpDetBTRAccumulator.h"
 #include "larsim/PhotonPropagation/PhotonVisibilityService.h"
 #include "larsim/PhotonPropagation/PhotonVisibilityTypes.h" // phot::MappedT0s_t
+#include "larsim/PhotonPropagation/VISTimingTable.h"
+#include "larsim/PhotonPropagation/VisibilityGridCache.h"
 #include "larsim/PhotonPropagation/ScintTimeTools/ScintTime.h"
+#include "larsim/Simulation/DepositTimeWindow.h"
 #include "larsim/Simulation/LArG4Parameters.h"
 
 // Random numbers
@@ -86,8 +95,8 @@
 #include "Math/SpecFuncMathMore.h"
 #include "TLorentzVector.h"
 #include "TMath.h"
-#include "TVector3.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cmath>
@@ -255,18 +264,18 @@ namespace phot {
   public:
     explicit PDFastSimPAR(fhicl::ParameterSet const&);
     void produce(art::Event&) override;
+    void endJob() override;
 
     void Initialization();
 
     void getVUVTimes(std::vector<double>& arrivalTimes, const double distance_in_cm, const size_t angle_bin);
-    void getVISTimes(std::vector<double>& arrivalTimes, const TVector3 &ScintPoint, const TVector3 &OpDetPoint);
+    void getVISTimes(std::vector<double>& arrivalTimes,
+                     geo::Point_t const& ScintPoint,
+                     geo::Point_t const& OpDetPoint,
+                     geo::Point_t const& CathodeCentre);
 
     void generateParam(const size_t index, const size_t angle_bin);
 
-    void AddOpDetBTR(std::vector<sim::OpDetBacktrackerRecord>& opbtr,
-                     std::map<size_t, int>& ChannelMap,
-                     sim::OpDetBacktrackerRecord btr);
-
   private:
     // structure definition for solid angle of rectangle function
     struct Dims {
@@ -280,33 +289,50 @@ namespace phot {
       int type;
     };
 
-    void detectedDirectHits(std::map<size_t, int>& DetectedNumFast,
-                            std::map<size_t, int>& DetectedNumSlow,
-                            const double NumFast,
-                            const double NumSlow,
-                            geo::Point_t const& ScintPoint);
-    void detectedReflecHits(std::map<size_t, int>& ReflDetectedNumFast,
-                            std::map<size_t, int>& ReflDetectedNumSlow,
-                            const double NumFast,
-                            const double NumSlow,
-                            geo::Point_t const& ScintPoint);
-
-    void VUVHits(const double NumFast,
-                const double NumSlow,
-                geo::Point_t const& ScintPoint,
-                OpticalDetector const& opDet,
-                std::vector<int> &DetThis);
-
-    void VISHits(geo::Point_t const& ScintPoint,
-                OpticalDetector const& opDet,
-                const double cathode_hits_rec_fast,
-                const double cathode_hits_rec_slow,
-                geo::Point_t const& hotspot,
-                std::vector<int> &ReflDetThis);
+    // light collection properties of a single TPC (drift volume)
+    struct TPCOpticalInfo {
+      std::vector<size_t> opDets;  // optical detectors that can see light from this TPC
+      geo::Point_t cathodeCentre;  // x: TPC cathode; y, z: centre of the cryostat active volume
+      Dims cathodePlane;           // cathode dimensions, from the cryostat active volume
+    };
+
+    // semi-analytic fraction of the photons from a point that reaches each
+    // optical detector of a TPC, in the order of TPCOpticalInfo::opDets
+    struct PointVisibilities {
+      std::vector<double> direct;    // VUV light
+      std::vector<double> reflected; // visible light reflected off the cathode
+    };
+
+    void detectedHits(std::map<size_t, int>& DetectedNumFast,
+                      std::map<size_t, int>& DetectedNumSlow,
+                      const double NumFast,
+                      const double NumSlow,
+                      TPCOpticalInfo const& tpcInfo,
+                      std::vector<double> const& visibilities);
+
+    PointVisibilities const& pointVisibilities(geo::Point_t const& ScintPoint,
+                                               geo::TPCGeo const& tpc,
+                                               TPCOpticalInfo const& tpcInfo,
+                                               PointVisibilities& scratch);
+    void fillVisibilities(PointVisibilities& visibilities,
+                          geo::Point_t const& ScintPoint,
+                          TPCOpticalInfo const& tpcInfo);
+
+    double VUVVisibility(geo::Point_t const& ScintPoint,
+                         OpticalDetector const& opDet,
+                         TPCOpticalInfo const& tpcInfo);
+
+    double cathodeVisibility(geo::Point_t const& ScintPoint, TPCOpticalInfo const& tpcInfo);
+
+    double VISVisibility(geo::Point_t const& ScintPoint,
+                         OpticalDetector const& opDet,
+                         TPCOpticalInfo const& tpcInfo,
+                         geo::Point_t const& hotspot);
 
     void propagationTime(std::vector<double>& arrival_time_dist,
                          geo::Point_t const& x0,
                          const size_t OpChannel,
+                         TPCOpticalInfo const& tpcInfo,
                          bool Reflected = false); // const;
 
     double interpolate(const std::vector<double>& xData,
@@ -337,8 +363,8 @@ namespace phot {
     std::unique_ptr<CLHEP::RandPoissonQ> fRandPoissPhot;
     CLHEP::HepRandomEngine& fScintTimeEngine;
 
-    std::map<size_t, int> PDChannelToSOCMapDirect; // Where each OpChan is.
-    std::map<size_t, int> PDChannelToSOCMapReflect; // Where each OpChan is.
+    OpDetBTRAccumulator fBTRsDirect; // Detected direct photons of each OpChan.
+    OpDetBTRAccumulator fBTRsReflect; // Detected reflected photons of each OpChan.
     size_t nOpChannels;
 
     // For VUV transport time parametrization
@@ -352,10 +378,8 @@ namespace phot {
 
     // For VIS transport time parameterisation
     double fvis_vmean, fangle_bin_timing_vis;
-    std::vector<double> fdistances_refl;
-    std::vector<double> fradial_distances_refl;
-    std::vector<std::vector<std::vector<double>>> fcut_off_pars;
-    std::vector<std::vector<std::vector<double>>> ftau_pars;
+    // cut-off and tau of the smearing, by angle, cathode and radial distance
+    phot::VISTimingTable fVISTimingTable;
 
     // For VUV semi-analytic hits
     double fdelta_angulo_vuv;
@@ -384,13 +408,12 @@ namespace phot {
     std::vector<std::vector<std::vector<double>>> fvispars_dome;
 
     // geometry properties
-    double fplane_depth, fcathode_zdimension, fcathode_ydimension;
-    TVector3 fcathode_centre;
     std::vector<geo::BoxBoundedGeo> const fActiveVolumes;
+    // per-TPC light collection properties, indexed by cryostat and TPC number
+    std::vector<std::vector<TPCOpticalInfo>> fTPCOpticalInfo;
 
     // Optical detector properties for semi-analytic hits
     double fradius;
-    Dims fcathode_plane;
     int fL_abs_vuv;
     std::vector<geo::Point_t> fOpDetCenter;
     std::vector<int> fOpDetType;
@@ -400,15 +423,21 @@ namespace phot {
     // Photon visibility service instance.
     PhotonVisibilityService const* const fPVS;
 
+    // Optional cache of visibilities on a grid of scintillation points
+    double const fVisibilityGridStep; // cell size [cm]; 0 disables the cache
+    std::unique_ptr<VisibilityGridCache<PointVisibilities>> fVisibilityCache;
+
+    // Skips deposits whose light can't arrive in the readout window
+    sim::DepositTimeWindow fTimeWindow;
+
     /// Whether photon propagation is performed only from active volumes
     bool const fOnlyActiveVolume = true; // PAR fast sim currently only for active volume
-    /// Allows running even if light on cryostats `C:1` and higher is not supported.
-    /// Currently hard coded "no"
-    bool const fOnlyOneCryostat = false;
     /// Whether the cathodes are fully opaque; currently hard coded "true".
     bool const fOpaqueCathode = true;
+    /// Optical detectors closer than this to a cathode are seen from both its sides [cm]
+    double const fCathodeOpDetTolerance;
 
-    bool isOpDetInSameTPC(geo::Point_t const& ScintPoint, geo::Point_t const& OpDetPoint) const;
+    void fillTPCOpticalInfo(geo::GeometryCore const& geom);
     bool isScintInActiveVolume(geo::Point_t const& ScintPoint);
 
     static std::vector<geo::BoxBoundedGeo> extractActiveVolumes(geo::GeometryCore const& geom);
@@ -429,9 +458,23 @@ namespace phot {
                                                                                  "SeedScintTime"))
     , fActiveVolumes{extractActiveVolumes(*(lar::providerFrom<geo::Geometry>()))}
     , fPVS(art::ServiceHandle<PhotonVisibilityService const>().get())
+    , fVisibilityGridStep{pset.get<double>("VisibilityGridStep", 0.)}
+    , fCathodeOpDetTolerance{pset.get<double>("CathodeOpDetTolerance", 10.)}
   {
     std::cout << "PDFastSimPAR Module Construct" << std::endl;
 
+    fTimeWindow = sim::DepositTimeWindow(
+      pset.get<fhicl::ParameterSet>("DepositTimeWindow", fhicl::ParameterSet{}));
+    fTimeWindow.SetDefaultMaxDelay(sim::DepositTimeWindow::DefaultLightDelay);
+
+    if (fVisibilityGridStep > 0.) {
+      fVisibilityCache = std::make_unique<VisibilityGridCache<PointVisibilities>>(
+        pset.get<std::size_t>("VisibilityGridMaxCells", 1000000));
+      mf::LogInfo("PDFastSimPAR") << "Caching visibilities on a " << fVisibilityGridStep
+                                  << " cm grid, up to " << fVisibilityCache->capacity()
+                                  << " cells";
+    }
+
     Initialization();
     art::ServiceHandle<sim::LArG4Parameters const> lgp;
     if (lgp->UseLitePhotons())
@@ -467,16 +510,15 @@ namespace phot {
                                  << "EventID: " << event.event();
 
     art::ServiceHandle<sim::LArG4Parameters const> lgp;
+    geo::GeometryCore const& geom = *(lar::providerFrom<geo::Geometry>());
 
     nOpChannels = fPVS->NOpChannels();
 
     auto phot = std::make_unique<std::vector<sim::SimPhotons>>();
     auto phlit = std::make_unique<std::vector<sim::SimPhotonsLite>>();
-    auto opbtr = std::make_unique<std::vector<sim::OpDetBacktrackerRecord>>();
 
     auto phot_ref = std::make_unique<std::vector<sim::SimPhotons>>();
     auto phlit_ref = std::make_unique<std::vector<sim::SimPhotonsLite>>();
-    auto opbtr_ref = std::make_unique<std::vector<sim::OpDetBacktrackerRecord>>();
 
     auto& dir_photcol(*phot);
     auto& ref_photcol(*phot_ref);
@@ -493,6 +535,8 @@ namespace phot {
         dir_phlitcol[i].OpChannel  = i;
         ref_phlitcol[i].OpChannel  = i;
     }
+    fBTRsDirect.reset(nOpChannels);
+    fBTRsReflect.reset(nOpChannels);
 
     art::Handle<std::vector<sim::SimEnergyDeposit>> edepHandle;
     if (!event.getByLabel(simTag, edepHandle)) {
@@ -500,6 +544,14 @@ namespace phot {
       return;
     }
 
+    if (fTimeWindow.Enabled()) {
+      auto const clockData =
+        art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(event);
+      fTimeWindow.SetEvent(
+        clockData,
+        art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(event, clockData));
+    }
+
     auto const& edeps = edepHandle;
 
     int num_points = 0;
@@ -508,7 +560,10 @@ namespace phot {
     int num_fastdp = 0;
     int num_slowdp = 0;
 
+    PointVisibilities scratchVisibilities;
+
     for (auto const& edepi : *edeps) {
+      if (!fTimeWindow.Accept(edepi)) continue;
       num_points++;
 
       int trackID = edepi.TrackID();
@@ -519,23 +574,35 @@ namespace phot {
 
       if (fOnlyActiveVolume && !isScintInActiveVolume(ScintPoint)) continue;
 
+      // the semi-analytic model is parametrised per drift volume
+      geo::TPCGeo const* tpc = geom.PositionToTPCptr(ScintPoint);
+      if (!tpc) continue;
+      geo::TPCID const& tpcid = tpc->ID();
+      TPCOpticalInfo const& tpcInfo = fTPCOpticalInfo[tpcid.Cryostat][tpcid.TPC];
+
       double nphot_fast = edepi.NumFPhotons();
       double nphot_slow = edepi.NumSPhotons();
 
       num_fastph += nphot_fast;
       num_slowph += nphot_slow;
 
-      // direct light
       std::map<size_t, int> DetectedNumFast;
       std::map<size_t, int> DetectedNumSlow;
-      if (nphot_fast > 0 || (nphot_slow > 0 && fDoSlowComponent))
-        detectedDirectHits(DetectedNumFast, DetectedNumSlow, nphot_fast, nphot_slow, ScintPoint);
-
-      // reflected light, if enabled
       std::map<size_t, int> ReflDetectedNumFast;
       std::map<size_t, int> ReflDetectedNumSlow;
-      if (fStoreReflected && (nphot_fast > 0 || (nphot_slow > 0 && fDoSlowComponent)))
-        detectedReflecHits(ReflDetectedNumFast, ReflDetectedNumSlow, nphot_fast, nphot_slow, ScintPoint);
+      if (nphot_fast > 0 || (nphot_slow > 0 && fDoSlowComponent)) {
+        PointVisibilities const& visibilities =
+          pointVisibilities(ScintPoint, *tpc, tpcInfo, scratchVisibilities);
+
+        // direct light
+        detectedHits(DetectedNumFast, DetectedNumSlow, nphot_fast, nphot_slow,
+                     tpcInfo, visibilities.direct);
+
+        // reflected light, if enabled
+        if (fStoreReflected)
+          detectedHits(ReflDetectedNumFast, ReflDetectedNumSlow, nphot_fast, nphot_slow,
+                       tpcInfo, visibilities.reflected);
+      }
 
       // propagation time
       std::vector<double> transport_time;
@@ -546,9 +613,7 @@ namespace phot {
         // only do the reflected loop if including reflected light
         if (Reflected && !fStoreReflected) continue;
 
-        for (size_t channel = 0; channel < nOpChannels; channel++) {
-
-          if (fOpaqueCathode && !isOpDetInSameTPC(ScintPoint, fOpDetCenter[channel])) continue;
+        for (size_t const channel : tpcInfo.opDets) {
 
           int ndetected_fast = DetectedNumFast[channel];
           int ndetected_slow = DetectedNumSlow[channel];
@@ -560,12 +625,12 @@ namespace phot {
           // calculate propagation time, does not matter whether fast or slow photon
           transport_time.resize(ndetected_fast + ndetected_slow);
           if (fPVS->IncludePropTime() && (ndetected_fast > 0 || (ndetected_slow > 0 && fDoSlowComponent)))
-            propagationTime(transport_time, ScintPoint, channel, Reflected);
+            propagationTime(transport_time, ScintPoint, channel, tpcInfo, Reflected);
 
           // SimPhotonsLite case
           if (lgp->UseLitePhotons()) {
 
-            sim::OpDetBacktrackerRecord tmpbtr(channel);
+            OpDetBTRAccumulator& btrs = Reflected ? fBTRsReflect : fBTRsDirect;
 
             if (ndetected_fast > 0) {
               int n = ndetected_fast;
@@ -576,7 +641,7 @@ namespace phot {
                 auto time = static_cast<int>(edepi.StartT() + fScintTime->GetScintTime() + transport_time[i]);
                 if (Reflected) ++ref_phlitcol[channel].DetectedPhotons[time];
                 else ++dir_phlitcol[channel].DetectedPhotons[time];
-                tmpbtr.AddScintillationPhotons(trackID, time, 1, pos, edeposit);
+                btrs.add(channel, trackID, time, 1, pos, edeposit);
               }
             }
 
@@ -588,12 +653,9 @@ namespace phot {
                 auto time = static_cast<int>(edepi.StartT() + fScintTime->GetScintTime() + transport_time[ndetected_fast + i]);
                 if (Reflected) ++ref_phlitcol[channel].DetectedPhotons[time];
                 else ++dir_phlitcol[channel].DetectedPhotons[time];
-                tmpbtr.AddScintillationPhotons(trackID, time, 1, pos, edeposit);
+                btrs.add(channel, trackID, time, 1, pos, edeposit);
               }
             }
-
-            if (Reflected) AddOpDetBTR(*opbtr_ref, PDChannelToSOCMapReflect, tmpbtr);
-            else AddOpDetBTR(*opbtr, PDChannelToSOCMapDirect, tmpbtr);
           }
           // SimPhotons case
           else {
@@ -638,16 +700,21 @@ namespace phot {
                                  << ", total slow photons: " << num_slowph
                                  << "\ndetected fast photons: " << num_fastdp
                                  << ", detected slow photons: " << num_slowdp;
-
-    PDChannelToSOCMapDirect.clear();
-    PDChannelToSOCMapReflect.clear();
+    if (fVisibilityCache) {
+      mf::LogTrace("PDFastSimPAR") << "Visibility cache: " << fVisibilityCache->size()
+                                   << " cells, " << fVisibilityCache->hits() << " hits, "
+                                   << fVisibilityCache->misses() << " misses";
+    }
 
     if (lgp->UseLitePhotons()) {
         event.put(move(phlit));
-        event.put(move(opbtr));
+        event.put(std::make_unique<std::vector<sim::OpDetBacktrackerRecord>>(
+          fBTRsDirect.makeRecords()));
         if (fPVS->StoreReflected()) {
             event.put(move(phlit_ref), "Reflected");
-            event.put(move(opbtr_ref), "Reflected");
+            event.put(std::make_unique<std::vector<sim::OpDetBacktrackerRecord>>(
+                        fBTRsReflect.makeRecords()),
+                      "Reflected");
         }
     }
     else {
@@ -662,30 +729,9 @@ namespace phot {
 
   //......................................................................
   void
-  PDFastSimPAR::AddOpDetBTR(std::vector<sim::OpDetBacktrackerRecord>& opbtr,
-                            std::map<size_t, int>& ChannelMap,
-                            sim::OpDetBacktrackerRecord btr
-                            )
+  PDFastSimPAR::endJob()
   {
-    size_t iChan = btr.OpDetNum();
-    auto channelPosition = ChannelMap.find(iChan);
-
-    if (channelPosition == ChannelMap.end()) {
-      ChannelMap[iChan] = opbtr.size();
-      opbtr.emplace_back(std::move(btr));
-    }
-    else {
-      unsigned int idtest = channelPosition->second;
-      auto const& timePDclockSDPsMap = btr.timePDclockSDPsMap();
-
-      for (auto const& timePDclockSDP : timePDclockSDPsMap) {
-        for (auto const& sdp : timePDclockSDP.second) {
-          double xyz[3] = {sdp.x, sdp.y, sdp.z};
-          opbtr.at(idtest).AddScintillationPhotons(
-            sdp.trackID, timePDclockSDP.first, sdp.numPhotons, xyz, sdp.energy);
-        }
-      }
-    }
+    fTimeWindow.PrintSummary("PDFastSimPAR");
   }
 
   //......................................................................
@@ -708,29 +754,6 @@ namespace phot {
       }
     } // local scope
 
-    if (geom.Ncryostats() > 1U) {
-      if (fOnlyOneCryostat) {
-        mf::LogWarning("PDFastSimPAR")
-          << std::string(80, '=') << "\nA detector with " << geom.Ncryostats()
-          << " cryostats is configured"
-          << " , and semi-analytic model is requested for scintillation photon propagation."
-          << " THIS CONFIGURATION IS NOT SUPPORTED and it is open to bugs"
-          << " (e.g. scintillation may be detected only in cryostat #0)."
-          << "\nThis would be normally a fatal error, but it has been forcibly overridden."
-          << "\n"
-          << std::string(80, '=');
-      }
-      else {
-        throw art::Exception(art::errors::Configuration)
-          << "Photon propagation via semi-analytic model is not supported yet"
-          << " on detectors with more than one cryostat.";
-      }
-    }
-
-    fcathode_centre = {geom.TPC(0, 0).GetCathodeCenter().X(),
-                       fActiveVolumes[0].CenterY(),
-                       fActiveVolumes[0].CenterZ()};
-
     for (size_t const i : util::counter(fPVS->NOpChannels())) {
       geo::OpDetGeo const& opDet = geom.OpDetGeoFromOpDet(i);
       fOpDetCenter.push_back(opDet.GetCenter());
@@ -752,6 +775,8 @@ namespace phot {
       }
     }
 
+    fillTPCOpticalInfo(geom);
+
     if (fPVS->IncludePropTime()) {
       std::cout << "Using parameterisation of timings." << std::endl;
       // VUV time parapetrization
@@ -782,13 +807,28 @@ namespace phot {
       // VIS time parameterisation
       if (fPVS->StoreReflected()) {
         // load parameters
-        fPVS->LoadTimingsForVISPar(fdistances_refl,
-                                   fradial_distances_refl,
-                                   fcut_off_pars,
-                                   ftau_pars,
+        std::vector<double> distances_refl;
+        std::vector<double> radial_distances_refl;
+        std::vector<std::vector<std::vector<double>>> cut_off_pars;
+        std::vector<std::vector<std::vector<double>>> tau_pars;
+        fPVS->LoadTimingsForVISPar(distances_refl,
+                                   radial_distances_refl,
+                                   cut_off_pars,
+                                   tau_pars,
                                    fvis_vmean,
                                    fangle_bin_timing_vis
                                   );
+        // tabulate the smearing parameters for allocation-free lookups
+        try {
+          fVISTimingTable = phot::VISTimingTable(distances_refl,
+                                                 radial_distances_refl,
+                                                 cut_off_pars,
+                                                 tau_pars);
+        }
+        catch (std::runtime_error const& e) {
+          throw cet::exception("PDFastSimPAR")
+            << "Invalid VIS timing parameterisation: " << e.what() << "\n";
+        }
       }
     }
 
@@ -846,15 +886,6 @@ namespace phot {
                               fvispars_dome
                             );
       }
-
-      // cathode dimensions
-      fcathode_ydimension = fActiveVolumes[0].SizeY();
-      fcathode_zdimension = fActiveVolumes[0].SizeZ();
-
-      // set cathode plane struct for solid angle function
-      fcathode_plane.h = fcathode_ydimension;
-      fcathode_plane.w = fcathode_zdimension;
-      fplane_depth = std::abs(fcathode_centre[0]);
     }
     else {
       fStoreReflected = false;
@@ -862,41 +893,99 @@ namespace phot {
   }
 
   //......................................................................
-  // VUV semi-analytic hits calculation
+  // semi-analytic hits from the visibilities of the optical detectors
+  void
+  PDFastSimPAR::detectedHits(std::map<size_t, int>& DetectedNumFast,
+                             std::map<size_t, int>& DetectedNumSlow,
+                             const double NumFast,
+                             const double NumSlow,
+                             TPCOpticalInfo const& tpcInfo,
+                             std::vector<double> const& visibilities)
+  {
+    for (auto const& [i, OpDet] : util::enumerate(tpcInfo.opDets)) {
+      DetectedNumFast[OpDet] = fRandPoissPhot->fire(visibilities[i] * NumFast);
+      DetectedNumSlow[OpDet] = fRandPoissPhot->fire(visibilities[i] * NumSlow);
+    }
+  }
+
+  //......................................................................
+  // visibilities from a scintillation point, via the grid cache if enabled
+  PDFastSimPAR::PointVisibilities const&
+  PDFastSimPAR::pointVisibilities(geo::Point_t const& ScintPoint,
+                                  geo::TPCGeo const& tpc,
+                                  TPCOpticalInfo const& tpcInfo,
+                                  PointVisibilities& scratch)
+  {
+    if (!fVisibilityCache) {
+      fillVisibilities(scratch, ScintPoint, tpcInfo);
+      return scratch;
+    }
+
+    // visibilities are evaluated at the centre of the grid cell (kept inside
+    // the active volume of the TPC), so that they do not depend on which
+    // deposit first lands in the cell
+    geo::TPCID const& tpcid = tpc.ID();
+    VisibilityGridCell const cell{tpcid.Cryostat,
+                                  tpcid.TPC,
+                                  static_cast<int>(std::floor(ScintPoint.X() / fVisibilityGridStep)),
+                                  static_cast<int>(std::floor(ScintPoint.Y() / fVisibilityGridStep)),
+                                  static_cast<int>(std::floor(ScintPoint.Z() / fVisibilityGridStep))};
+    if (PointVisibilities const* cached = fVisibilityCache->find(cell)) return *cached;
+
+    geo::BoxBoundedGeo const& active = tpc.ActiveBoundingBox();
+    auto const cellCentre = [this](int index, double min, double max) {
+      return std::clamp((index + 0.5) * fVisibilityGridStep, min, max);
+    };
+    geo::Point_t const centre{cellCentre(cell.x, active.MinX(), active.MaxX()),
+                              cellCentre(cell.y, active.MinY(), active.MaxY()),
+                              cellCentre(cell.z, active.MinZ(), active.MaxZ())};
+    fillVisibilities(scratch, centre, tpcInfo);
+    PointVisibilities const* stored = fVisibilityCache->insert(cell, scratch);
+    return stored ? *stored : scratch;
+  }
+
+  //......................................................................
   void
-  PDFastSimPAR::detectedDirectHits(std::map<size_t, int>& DetectedNumFast,
-                                   std::map<size_t, int>& DetectedNumSlow,
-                                   const double NumFast,
-                                   const double NumSlow,
-                                   geo::Point_t const& ScintPoint)
+  PDFastSimPAR::fillVisibilities(PointVisibilities& visibilities,
+                                 geo::Point_t const& ScintPoint,
+                                 TPCOpticalInfo const& tpcInfo)
   {
-    for (size_t const OpDet : util::counter(nOpChannels)) {
-      if (!isOpDetInSameTPC(ScintPoint, fOpDetCenter[OpDet])) continue;
+    visibilities.direct.clear();
+    visibilities.reflected.clear();
 
+    for (size_t const OpDet : tpcInfo.opDets) {
       // set detector struct for solid angle function
       const PDFastSimPAR::OpticalDetector op{
         fOpDetHeight[OpDet], fOpDetLength[OpDet],
         fOpDetCenter[OpDet], fOpDetType[OpDet]};
+      visibilities.direct.push_back(VUVVisibility(ScintPoint, op, tpcInfo));
+    }
 
-      std::vector<int> DetThis(2, 0);
-      VUVHits(NumFast, NumSlow, ScintPoint, op, DetThis);
-
-      DetectedNumFast[OpDet] = DetThis[0];
-      DetectedNumSlow[OpDet] = DetThis[1];
+    if (!fStoreReflected) return;
 
-      //   mf::LogInfo("PDFastSimPAR") << "FastScint: " <<
-      //   //   it->second<<" " << Num << " " << DetThisPMT;
-      //det_photon_ctr += DetThisPMT; // CASE-DEBUG DO NOT REMOVE THIS COMMENT
+    // hits of VUV photons on the reflective foils of the cathode,
+    // then on each PD from the hotspot
+    const double cathode_visibility = cathodeVisibility(ScintPoint, tpcInfo);
+    const geo::Point_t hotspot = {tpcInfo.cathodeCentre.X(), ScintPoint.Y(), ScintPoint.Z()};
+    for (size_t const OpDet : tpcInfo.opDets) {
+      // set detector struct for solid angle function
+      const  PDFastSimPAR::OpticalDetector op{
+        fOpDetHeight[OpDet], fOpDetLength[OpDet],
+        fOpDetCenter[OpDet], fOpDetType[OpDet]};
+      visibilities.reflected.push_back(
+        cathode_visibility * VISVisibility(ScintPoint, op, tpcInfo, hotspot));
     }
   }
 
-  void
-  PDFastSimPAR::VUVHits(const double NumFast,
-                        const double NumSlow,
-                        geo::Point_t const& ScintPoint,
-                        OpticalDetector const& opDet,
-                        std::vector<int>& DetThis)
+  //......................................................................
+  // VUV semi-analytic visibility calculation
+  double
+  PDFastSimPAR::VUVVisibility(geo::Point_t const& ScintPoint,
+                              OpticalDetector const& opDet,
+                              TPCOpticalInfo const& tpcInfo)
   {
+    geo::Point_t const& cathodeCentre = tpcInfo.cathodeCentre;
+
     // distance and angle between ScintPoint and OpDetPoint
     geo::Vector_t const relative = ScintPoint - opDet.OpDetPoint;
     const double distance = relative.R();
@@ -926,12 +1015,10 @@ namespace phot {
       std::cout << "Error: Invalid optical detector type. 0 = rectangular, 1 = dome, 2 = disk" << std::endl;
     }
 
-    // calculate number of photons hits by geometric acceptance for fast and slow components
+    // calculate fraction of photons hitting by geometric acceptance,
     // accounting for solid angle and LAr absorbtion length
-    double hits_geo_fast =
-      std::exp(-1. * distance / fL_abs_vuv) * (solid_angle / (4 * CLHEP::pi)) * NumFast;
-    double hits_geo_slow =
-      std::exp(-1. * distance / fL_abs_vuv) * (solid_angle / (4 * CLHEP::pi)) * NumSlow;
+    double visibility_geo =
+      std::exp(-1. * distance / fL_abs_vuv) * (solid_angle / (4 * CLHEP::pi));
 
     // apply Gaisser-Hillas correction for Rayleigh scattering distance
     // and angular dependence offset angle bin
@@ -939,7 +1026,7 @@ namespace phot {
 
     // determine GH parameters, accounting for border effects
     // radial distance from centre of detector (Y-Z)
-    double r = std::hypot(ScintPoint.Y() - fcathode_centre[1], ScintPoint.Z() - fcathode_centre[2]);
+    double r = std::hypot(ScintPoint.Y() - cathodeCentre.Y(), ScintPoint.Z() - cathodeCentre.Z());
 
     double pars_ini[4] = {0, 0, 0, 0};
     double s1 = 0; double s2 = 0; double s3 = 0;
@@ -974,48 +1061,40 @@ namespace phot {
     // calculate correction
     double GH_correction = Gaisser_Hillas(distance, pars_ini);
 
-    // calculate number photons for fast and slow componenets
-    DetThis[0] = fRandPoissPhot->fire(GH_correction * hits_geo_fast / cosine);
-    DetThis[1] = fRandPoissPhot->fire(GH_correction * hits_geo_slow / cosine);
-
+    return GH_correction * visibility_geo / cosine;
   }
 
   //......................................................................
-  // VIS hits semi-analytic model calculation
-  void
-  PDFastSimPAR::detectedReflecHits(std::map<size_t, int>& ReflDetectedNumFast,
-                                   std::map<size_t, int>& ReflDetectedNumSlow,
-                                   const double NumFast,
-                                   const double NumSlow,
-                                   geo::Point_t const& ScintPoint)
+  // VIS semi-analytic model calculation
+  double
+  PDFastSimPAR::cathodeVisibility(geo::Point_t const& ScintPoint, TPCOpticalInfo const& tpcInfo)
   {
     // 1). calculate total number of hits of VUV photons on
     // reflective foils via solid angle + Gaisser-Hillas
     // corrections:
 
     // set plane_depth for correct TPC:
-    double const plane_depth = ScintPoint.X() < 0. ? -fplane_depth : fplane_depth;
+    geo::Point_t const& cathodeCentre = tpcInfo.cathodeCentre;
+    double const plane_depth = cathodeCentre.X();
 
     // get scintpoint coords relative to centre of cathode plane
     geo::Vector_t const ScintPoint_relative = {std::abs(ScintPoint.X() - plane_depth),
-                                                 std::abs(ScintPoint.Y() - fcathode_centre[1]),
-                                                 std::abs(ScintPoint.Z() - fcathode_centre[2])};
+                                                 std::abs(ScintPoint.Y() - cathodeCentre.Y()),
+                                                 std::abs(ScintPoint.Z() - cathodeCentre.Z())};
     // calculate solid angle of cathode from the scintillation point
-    double solid_angle_cathode = Rectangle_SolidAngle(Dims{fcathode_plane.h, fcathode_plane.w}, ScintPoint_relative);
+    double solid_angle_cathode = Rectangle_SolidAngle(tpcInfo.cathodePlane, ScintPoint_relative);
 
     // calculate distance and angle between ScintPoint and hotspot
     // vast majority of hits in hotspot region directly infront of scintpoint,
     // therefore consider attenuation for this distance and on axis GH instead of for the centre coordinate
     double distance_cathode = std::abs(plane_depth - ScintPoint.X());
     // calculate hits on cathode plane via geometric acceptance
-    double cathode_hits_geo_fast = std::exp(-1. * distance_cathode / fL_abs_vuv) *
-                              (solid_angle_cathode / (4. * CLHEP::pi)) * NumFast;
-    double cathode_hits_geo_slow = std::exp(-1. * distance_cathode / fL_abs_vuv) *
-                              (solid_angle_cathode / (4. * CLHEP::pi)) * NumSlow;
+    double cathode_visibility_geo = std::exp(-1. * distance_cathode / fL_abs_vuv) *
+                              (solid_angle_cathode / (4. * CLHEP::pi));
 
     // determine Gaisser-Hillas correction including border effects
     // use flat correction
-    double r = std::hypot(ScintPoint.Y() - fcathode_centre[1], ScintPoint.Z() - fcathode_centre[2]);
+    double r = std::hypot(ScintPoint.Y() - cathodeCentre.Y(), ScintPoint.Z() - cathodeCentre.Z());
     double pars_ini[4] = {0, 0, 0, 0};
     double s1 = 0; double s2 = 0; double s3 = 0;
     if(fIsFlatPDCorr) {
@@ -1036,40 +1115,22 @@ namespace phot {
     pars_ini[3] = pars_ini[3];
 
 
-    // calculate corrected number of hits
+    // calculate corrected fraction of photons hitting the cathode
     double GH_correction = Gaisser_Hillas(distance_cathode, pars_ini);
-    const double cathode_hits_rec_fast = GH_correction * cathode_hits_geo_fast;
-    const double cathode_hits_rec_slow = GH_correction * cathode_hits_geo_slow;
-
-    // detemine hits on each PD
-    const geo::Point_t hotspot = {plane_depth, ScintPoint.Y(), ScintPoint.Z()};
-    for (size_t const OpDet : util::counter(nOpChannels)) {
-      if (!isOpDetInSameTPC(ScintPoint, fOpDetCenter[OpDet])) continue;
-
-      // set detector struct for solid angle function
-      const  PDFastSimPAR::OpticalDetector op{
-        fOpDetHeight[OpDet], fOpDetLength[OpDet],
-        fOpDetCenter[OpDet], fOpDetType[OpDet]};
-
-      std::vector<int> ReflDetThis(2, 0);
-      VISHits(ScintPoint, op, cathode_hits_rec_fast, cathode_hits_rec_slow, hotspot, ReflDetThis);
-
-      ReflDetectedNumFast[OpDet] = ReflDetThis[0];
-      ReflDetectedNumSlow[OpDet] = ReflDetThis[1];
-    }
+    return GH_correction * cathode_visibility_geo;
   }
 
-  void
-  PDFastSimPAR::VISHits(geo::Point_t const& ScintPoint,
-                        OpticalDetector const& opDet,
-                        const double cathode_hits_rec_fast,
-                        const double cathode_hits_rec_slow,
-                        geo::Point_t const& hotspot,
-                        std::vector<int> &ReflDetThis)
+  // fraction of the photons hitting the cathode that reach the optical detector
+  double
+  PDFastSimPAR::VISVisibility(geo::Point_t const& ScintPoint,
+                              OpticalDetector const& opDet,
+                              TPCOpticalInfo const& tpcInfo,
+                              geo::Point_t const& hotspot)
   {
 
     // set plane_depth for correct TPC:
-    double const plane_depth = ScintPoint.X() < 0. ? -fplane_depth : fplane_depth;
+    geo::Point_t const& cathodeCentre = tpcInfo.cathodeCentre;
+    double const plane_depth = cathodeCentre.X();
 
     // calculate number of these hits which reach the optical
     // detector from the hotspot using solid angle:
@@ -1109,15 +1170,13 @@ namespace phot {
       std::cout << "Error: Invalid optical detector type. 0 = rectangular, 1 = dome, 2 = disk" << std::endl;
     }
 
-    // calculate number of hits via geometeric acceptance
-    double hits_geo_fast = (solid_angle_detector / (2. * CLHEP::pi)) *
-                      cathode_hits_rec_fast; // 2*pi due to presence of reflective foils
-    double hits_geo_slow = (solid_angle_detector / (2. * CLHEP::pi)) *
-                      cathode_hits_rec_slow; // 2*pi due to presence of reflective foils
+    // calculate fraction of hits via geometeric acceptance
+    double visibility_geo =
+      solid_angle_detector / (2. * CLHEP::pi); // 2*pi due to presence of reflective foils
 
     // determine correction factor, depending on PD type
     const size_t k = (theta_vis / fdelta_angulo_vis);         // off-set angle bin
-    double r = std::hypot(ScintPoint.Y() - fcathode_centre[1], ScintPoint.Z() - fcathode_centre[2]);
+    double r = std::hypot(ScintPoint.Y() - cathodeCentre.Y(), ScintPoint.Z() - cathodeCentre.Z());
     double d_c = std::abs(ScintPoint.X() - plane_depth);       // distance to cathode
     double border_correction = 0;
     // flat PDs
@@ -1174,29 +1233,17 @@ namespace phot {
      std::cout << "Error: Invalid optical detector type. 0 = rectangular, 1 = dome, 2 = disk. Or corrections for chosen optical detector type missing." << std::endl;
     }
 
-    ReflDetThis[0] = fRandPoissPhot->fire(border_correction * hits_geo_fast / cosine_vis);
-    ReflDetThis[1] = fRandPoissPhot->fire(border_correction * hits_geo_slow / cosine_vis);
-  }
-
-  bool
-  PDFastSimPAR::isOpDetInSameTPC(geo::Point_t const& ScintPoint,
-                                 geo::Point_t const& OpDetPoint) const
-  {
-    // check optical channel is in same TPC as scintillation light, if not return 0 hits
-    // temporary method working for SBND, uBooNE, DUNE 1x2x6; to be replaced to work in full DUNE geometry
-    // check x coordinate has same sign or is close to zero, otherwise return 0 hits
-    if (((ScintPoint.X() < 0.) != (OpDetPoint.X() < 0.)) &&
-        std::abs(OpDetPoint.X()) > 10.) { // TODO: unhardcode
-      return false;
-    }
-    return true;
+    return border_correction * visibility_geo / cosine_vis;
   }
 
   bool
   PDFastSimPAR::isScintInActiveVolume(geo::Point_t const& ScintPoint)
   {
     //semi-analytic approach only works in the active volume
-    return fActiveVolumes[0].ContainsPosition(ScintPoint);
+    for (geo::BoxBoundedGeo const& box : fActiveVolumes) {
+      if (box.ContainsPosition(ScintPoint)) return true;
+    }
+    return false;
   }
 
   //......................................................................
@@ -1204,6 +1251,7 @@ namespace phot {
   PDFastSimPAR::propagationTime(std::vector<double>& arrival_time_dist,
                                 geo::Point_t const& x0,
                                 const size_t OpChannel,
+                                TPCOpticalInfo const& tpcInfo,
                                 bool Reflected)
   {
     if (fPVS->IncludePropTime()) {
@@ -1217,8 +1265,7 @@ namespace phot {
         getVUVTimes(arrival_time_dist, distance, angle_bin); // in ns
       }
       else {
-        getVISTimes(arrival_time_dist, geo::vect::toTVector3(x0),
-                    geo::vect::toTVector3(opDetCenter)); // in ns
+        getVISTimes(arrival_time_dist, x0, opDetCenter, tpcInfo.cathodeCentre); // in ns
       }
     }
     else {
@@ -1255,8 +1302,9 @@ namespace phot {
   // VIS arrival times calculation functions
   void
   PDFastSimPAR::getVISTimes(std::vector<double>& arrivalTimes,
-                            const TVector3 &ScintPoint,
-                            const TVector3 &OpDetPoint)
+                            geo::Point_t const& ScintPoint,
+                            geo::Point_t const& OpDetPoint,
+                            geo::Point_t const& CathodeCentre)
   {
     // *************************************************************************************************
     //     Calculation of earliest arrival times and corresponding unsmeared
@@ -1264,34 +1312,29 @@ namespace phot {
     // *************************************************************************************************
 
     // set plane_depth for correct TPC:
-    double plane_depth;
-    if (ScintPoint[0] < 0) { plane_depth = -fplane_depth; }
-    else {
-      plane_depth = fplane_depth;
-    }
-
-    // calculate point of reflection for shortest path
-    TVector3 bounce_point(plane_depth,ScintPoint[1],ScintPoint[2]);
+    double const plane_depth = CathodeCentre.X();
 
-    // calculate distance travelled by VUV light and by vis light
-    double VUVdist = (bounce_point - ScintPoint).Mag();
-    double Visdist = (OpDetPoint - bounce_point).Mag();
+    // the point of reflection for shortest path is (plane_depth, y, z) of the
+    // scintillation point: calculate distance travelled by VUV light and by vis light
+    double const VUVdist = std::abs(plane_depth - ScintPoint.X());
+    double const Visdist = std::hypot(OpDetPoint.X() - plane_depth,
+                                      OpDetPoint.Y() - ScintPoint.Y(),
+                                      OpDetPoint.Z() - ScintPoint.Z());
 
     // calculate times taken by VUV part of path
     int angle_bin_vuv = 0; // on-axis by definition
     getVUVTimes(arrivalTimes, VUVdist, angle_bin_vuv);
 
     // sum parts to get total transport times times
+    double const vis_time = Visdist / fvis_vmean;
     for (size_t i = 0; i < arrivalTimes.size(); ++i) {
-      arrivalTimes[i] += Visdist / fvis_vmean;
+      arrivalTimes[i] += vis_time;
     }
 
     // *************************************************************************************************
     //      Smearing of arrival time distribution
     // *************************************************************************************************
     // calculate fastest time possible
-    // vis part
-    double vis_time = Visdist / fvis_vmean;
     // vuv part
     double vuv_time;
     if (VUVdist < fmin_d) {
@@ -1307,65 +1350,29 @@ namespace phot {
     double fastest_time = vis_time + vuv_time;
 
     // calculate angle theta between bound_point and optical detector
-    double cosine_theta = std::abs(OpDetPoint[0] - bounce_point[0]) / Visdist;
+    double cosine_theta = std::abs(OpDetPoint.X() - plane_depth) / Visdist;
     double theta = fast_acos(cosine_theta) * 180. / CLHEP::pi;
 
     // determine smearing parameters using interpolation of generated points:
     // 1). tau = exponential smearing factor, varies with distance and angle
     // 2). cutoff = largest smeared time allowed, preventing excessively large
     //     times caused by exponential distance to cathode
-    double distance_cathode_plane = std::abs(plane_depth - ScintPoint[0]);
+    double distance_cathode_plane = VUVdist;
     // angular bin
     size_t theta_bin = theta / fangle_bin_timing_vis;
     // radial distance from centre of TPC (y,z plane)
-    double r = std::sqrt(std::pow(ScintPoint[1] - fcathode_centre[1], 2) + std::pow(ScintPoint[2] - fcathode_centre[2], 2));
+    double r = std::hypot(ScintPoint.Y() - CathodeCentre.Y(), ScintPoint.Z() - CathodeCentre.Z());
 
-    // cut-off and tau
-    // cut-off
-    // interpolate in d_c for each r bin
-    std::vector<double> interp_vals(fcut_off_pars[theta_bin].size(), 0.0);
-    for (size_t i = 0; i < fcut_off_pars[theta_bin].size(); i++){
-        interp_vals[i] = interpolate(fdistances_refl, fcut_off_pars[theta_bin][i], distance_cathode_plane, true);
-    }
-    // interpolate in r
-    double cutoff = interpolate(fradial_distances_refl, interp_vals, r, true);
+    // cut-off and tau, from the table precomputed at initialization
+    phot::VISTimingTable::Smearing_t const smearing =
+      fVISTimingTable.at(theta_bin, distance_cathode_plane, r);
 
-    // tau
-    // interpolate in x for each r bin
-    std::vector<double> interp_vals_tau(ftau_pars[theta_bin].size(), 0.0);
-    for (size_t i = 0; i < ftau_pars[theta_bin].size(); i++){
-        interp_vals_tau[i] = interpolate(fdistances_refl, ftau_pars[theta_bin][i], distance_cathode_plane, true);
-    }
-    // interpolate in r
-    double tau = interpolate(fradial_distances_refl, interp_vals_tau, r, true);
-
-    // apply smearing:
+    // apply smearing: times already beyond the cut-off are not smeared, the
+    // others are sampled directly within the cut-off (see phot::smearVISTime())
     for (size_t i = 0; i < arrivalTimes.size(); ++i) {
-      double arrival_time_smeared;
-      // if time is already greater than cutoff, do not apply smearing
-      if (arrivalTimes[i] >= cutoff) { continue; }
-      // otherwise smear
-      else {
-        unsigned int counter = 0;
-        // loop until time generated is within cutoff limit
-        // most are within single attempt, very few take more than two
-        do {
-          // don't attempt smearings too many times
-          if (counter >= 10) {                      // TODO: unhardcode
-            arrival_time_smeared = arrivalTimes[i]; // don't smear
-            break;
-          }
-          else {
-            // generate random number in appropriate range
-            double x = CLHEP::RandFlat::shoot(&fScintTimeEngine, 0.5, 1.0);
-            // apply the exponential smearing
-            arrival_time_smeared =
-              arrivalTimes[i] + (arrivalTimes[i] - fastest_time) * (std::pow(x, -tau) - 1);
-          }
-          counter++;
-        } while (arrival_time_smeared > cutoff);
-      }
-      arrivalTimes[i] = arrival_time_smeared;
+      if (arrivalTimes[i] >= smearing.cutoff) continue;
+      arrivalTimes[i] = phot::smearVISTime(arrivalTimes[i], fastest_time, smearing,
+                                           CLHEP::RandFlat::shoot(&fScintTimeEngine));
     }
   }
 
@@ -1716,6 +1723,54 @@ namespace phot {
     }
   }
 
+  // ---------------------------------------------------------------------------
+  void
+  PDFastSimPAR::fillTPCOpticalInfo(geo::GeometryCore const& geom)
+  {
+    // An optical detector can see the light from a TPC if it is in the same
+    // cryostat and no (opaque) cathode lies between it and the TPC active
+    // volume along the drift (x) direction. Detectors mounted on a cathode
+    // see both of its sides.
+    fTPCOpticalInfo.clear();
+    fTPCOpticalInfo.resize(geom.Ncryostats());
+
+    for (geo::CryostatGeo const& cryo : geom.IterateCryostats()) {
+      geo::BoxBoundedGeo const& activeVolume = fActiveVolumes[cryo.ID().Cryostat];
+
+      std::vector<double> cathodes;
+      for (geo::TPCGeo const& tpc : cryo.IterateTPCs())
+        cathodes.push_back(tpc.GetCathodeCenter().X());
+
+      std::vector<size_t> cryoOpDets;
+      for (size_t const OpDet : util::counter(fOpDetCenter.size())) {
+        if (cryo.ContainsPosition(fOpDetCenter[OpDet])) cryoOpDets.push_back(OpDet);
+      }
+
+      auto& cryoInfo = fTPCOpticalInfo[cryo.ID().Cryostat];
+      cryoInfo.resize(cryo.NTPC());
+      for (geo::TPCGeo const& tpc : cryo.IterateTPCs()) {
+        TPCOpticalInfo& info = cryoInfo[tpc.ID().TPC];
+        info.cathodeCentre = {
+          tpc.GetCathodeCenter().X(), activeVolume.CenterY(), activeVolume.CenterZ()};
+        info.cathodePlane = Dims{activeVolume.SizeY(), activeVolume.SizeZ()};
+
+        double const tpcX = tpc.GetActiveVolumeCenter().X();
+        for (size_t const OpDet : cryoOpDets) {
+          double const opDetX = fOpDetCenter[OpDet].X();
+          auto const blocks = [tpcX, opDetX, this](double cathodeX) {
+            return ((cathodeX - tpcX) * (cathodeX - opDetX) < 0.) &&
+                   (std::abs(opDetX - cathodeX) > fCathodeOpDetTolerance);
+          };
+          if (fOpaqueCathode && std::any_of(cathodes.begin(), cathodes.end(), blocks)) continue;
+          info.opDets.push_back(OpDet);
+        }
+
+        mf::LogTrace("PDFastSimPAR")
+          << tpc.ID() << ": " << info.opDets.size() << " optical detectors can see its light";
+      } // for TPCs
+    }   // for cryostats
+  } // PDFastSimPAR::fillTPCOpticalInfo()
+
   // ---------------------------------------------------------------------------
   std::vector<geo::BoxBoundedGeo>
   PDFastSimPAR::extractActiveVolumes(geo::GeometryCore const& geom)
@@ -21,6 +21,9 @@
 //  - visible photons: the number of photons times the visibility at the middle of the Geant4 step for a given optical channel.
 //  - other photon information is got from 'sim::SimEnergyDeposits'
 //  - add 'sim::OpDetBacktrackerRecord' to event
+// Deposits whose light can't arrive in the readout window can be skipped,
+// configured by the optional 'DepositTimeWindow' table (see
+// 'sim::DepositTimeWindow'; default maximum delay: 20 us).
 // Aug. 19 by Mu Wei
 ////////////////////////////////////////////////////////////////////////
 
@@ -38,12 +41,16 @@
 
 // LArSoft libraries
 #include "larcore/Geometry/Geometry.h"
+#include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardata/DetectorInfoServices/LArPropertiesService.h"
 #include "lardataobj/Simulation/OpDetBacktrackerRecord.h"
 #include "lardataobj/Simulation/SimEnergyDeposit.h"
 #include "lardataobj/Simulation/SimPhotons.h"
+#include "larsim/PhotonPropagation/OpDetBTRAccumulator.h"
 #include "larsim/PhotonPropagation/PhotonVisibilityService.h"
 #include "larsim/PhotonPropagation/ScintTimeTools/ScintTime.h"
+#include "larsim/Simulation/DepositTimeWindow.h"
 
 // Random number engine
 #include "CLHEP/Random/RandFlat.h"
@@ -55,9 +62,7 @@ namespace phot {
   public:
     explicit PDFastSimPVS(fhicl::ParameterSet const&);
     void produce(art::Event&) override;
-    void AddOpDetBTR(std::vector<sim::OpDetBacktrackerRecord>& opbtr,
-                     std::map<int, int>& ChannelMap,
-                     sim::OpDetBacktrackerRecord btr);
+    void endJob() override;
 
   private:
     bool fDoSlowComponent;
@@ -65,7 +70,8 @@ namespace phot {
     std::unique_ptr<ScintTime> fScintTime; // Tool to retrive timinig of scintillation
     CLHEP::HepRandomEngine& fPhotonEngine;
     CLHEP::HepRandomEngine& fScintTimeEngine;
-    std::map<int, int> PDChannelToSOCMap; //Where each OpChan is.
+    OpDetBTRAccumulator fBTRs;            //Detected photons of each OpChan.
+    sim::DepositTimeWindow fTimeWindow;   // skips deposits out of the readout window
   };
 
   //......................................................................
@@ -81,9 +87,12 @@ namespace phot {
                                                                                  "scinttime",
                                                                                  pset,
                                                                                  "SeedScintTime"))
+    , fTimeWindow{pset.get<fhicl::ParameterSet>("DepositTimeWindow", fhicl::ParameterSet{})}
   {
     std::cout << "PDFastSimPVS Module Construct" << std::endl;
 
+    fTimeWindow.SetDefaultMaxDelay(sim::DepositTimeWindow::DefaultLightDelay);
+
     produces<std::vector<sim::SimPhotonsLite>>("pvs");
     produces<std::vector<sim::OpDetBacktrackerRecord>>("pvs");
   }
@@ -101,8 +110,6 @@ namespace phot {
     CLHEP::RandPoissonQ randpoisphot{fPhotonEngine};
     //        CLHEP::RandFlat randflatscinttime{fScintTimeEngine};
 
-    std::unique_ptr<std::vector<sim::OpDetBacktrackerRecord>> opbtr(
-      new std::vector<sim::OpDetBacktrackerRecord>);
     std::unique_ptr<std::vector<sim::SimPhotonsLite>> phlit(new std::vector<sim::SimPhotonsLite>);
 
     auto& photonLiteCollection(*phlit);
@@ -110,6 +117,7 @@ namespace phot {
     for (unsigned int i = 0; i < nOpChannels; i++) {
       photonLiteCollection[i].OpChannel = i;
     }
+    fBTRs.reset(nOpChannels);
 
     art::Handle<std::vector<sim::SimEnergyDeposit>> edepHandle;
     if (!event.getByLabel(simTag, edepHandle)) {
@@ -117,6 +125,14 @@ namespace phot {
       return;
     }
 
+    if (fTimeWindow.Enabled()) {
+      auto const clockData =
+        art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(event);
+      fTimeWindow.SetEvent(
+        clockData,
+        art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(event, clockData));
+    }
+
     art::ServiceHandle<geo::Geometry> geom;
     auto const& edeps = edepHandle;
 
@@ -130,6 +146,7 @@ namespace phot {
     float vis_scale = 1.0; // to scale the visibility fraction, for test only;
 
     for (auto const& edepi : *edeps) {
+      if (!fTimeWindow.Accept(edepi)) continue;
       num_points++;
 
       auto const& prt = edepi.MidPoint();
@@ -163,8 +180,6 @@ namespace phot {
           continue; //voxel is not visible at this optical channel.
         }
 
-        sim::OpDetBacktrackerRecord tmpbtr(channel);
-
         if (nphot_fast > 0) {
           //random number, poisson distribution, mean: the amount of photons visible at this channel
           auto n = static_cast<int>(randpoisphot.fire(nphot_fast * visibleFraction));
@@ -174,7 +189,7 @@ namespace phot {
             fScintTime->GenScintTime(true, fScintTimeEngine);
             auto time = static_cast<int>(edepi.StartT() + fScintTime->GetScintTime());
             ++photonLiteCollection[channel].DetectedPhotons[time];
-            tmpbtr.AddScintillationPhotons(trackID, time, 1, pos, edeposit);
+            fBTRs.add(channel, trackID, time, 1, pos, edeposit);
           }
         }
 
@@ -185,11 +200,9 @@ namespace phot {
             fScintTime->GenScintTime(false, fScintTimeEngine);
             auto time = static_cast<int>(edepi.StartT() + fScintTime->GetScintTime());
             ++photonLiteCollection[channel].DetectedPhotons[time];
-            tmpbtr.AddScintillationPhotons(trackID, time, 1, pos, edeposit);
+            fBTRs.add(channel, trackID, time, 1, pos, edeposit);
           }
         }
-
-        AddOpDetBTR(*opbtr, PDChannelToSOCMap, tmpbtr);
       }
     }
 
@@ -199,38 +212,18 @@ namespace phot {
     std::cout << "Detected fast photons: " << num_fastdp
               << ", detected slow photons: " << num_slowdp << std::endl;
 
-    PDChannelToSOCMap.clear();
     event.put(move(phlit), "pvs");
-    event.put(move(opbtr), "pvs");
+    event.put(std::make_unique<std::vector<sim::OpDetBacktrackerRecord>>(fBTRs.makeRecords()),
+              "pvs");
 
     return;
   }
 
   //......................................................................
   void
-  PDFastSimPVS::AddOpDetBTR(std::vector<sim::OpDetBacktrackerRecord>& opbtr,
-                            std::map<int, int>& ChannelMap,
-                            sim::OpDetBacktrackerRecord btr)
+  PDFastSimPVS::endJob()
   {
-    int iChan = btr.OpDetNum();
-    std::map<int, int>::iterator channelPosition = ChannelMap.find(iChan);
-
-    if (channelPosition == ChannelMap.end()) {
-      ChannelMap[iChan] = opbtr.size();
-      opbtr.emplace_back(std::move(btr));
-    }
-    else {
-      unsigned int idtest = channelPosition->second;
-      auto const& timePDclockSDPsMap = btr.timePDclockSDPsMap();
-
-      for (auto const& timePDclockSDP : timePDclockSDPsMap) {
-        for (auto const& sdp : timePDclockSDP.second) {
-          double xyz[3] = {sdp.x, sdp.y, sdp.z};
-          opbtr.at(idtest).AddScintillationPhotons(
-            sdp.trackID, timePDclockSDP.first, sdp.numPhotons, xyz, sdp.energy);
-        }
-      }
-    }
+    fTimeWindow.PrintSummary("PDFastSimPVS");
   }
 
   /*
@@ -0,0 +1,220 @@
+/**
+ * @file   larsim/PhotonPropagation/VISTimingTable.h
+ * @brief  Precomputed smearing parameters of the reflected light timing.
+ * @see    larsim/PhotonPropagation/PDFastSimPAR_module.cc
+ *
+ * The arrival time of reflected (visible) photons is smeared with a truncated
+ * power law, whose parameters (the cut-off time and the exponent tau) are
+ * tabulated by angular bin, distance from the cathode plane and radial
+ * distance from the cathode centre.
+ *
+ * This is a header-only library.
+ */
+
+#ifndef LARSIM_PHOTONPROPAGATION_VISTIMINGTABLE_H
+#define LARSIM_PHOTONPROPAGATION_VISTIMINGTABLE_H
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phot {
+
+  /**
+   * @brief Table of the smearing parameters of the reflected light timing.
+   *
+   * The table is filled once from the parametrisation, stored by angular bin,
+   * radial distance node and cathode distance node. Each lookup is a bilinear
+   * interpolation (with linear extrapolation beyond the nodes) in cathode
+   * distance and radial distance within the angular bin, which gives the
+   * same result as interpolating first in cathode distance at each radial
+   * node and then in radial distance.
+   *
+   * When the nodes of an axis are equally spaced, the interval of a point is
+   * computed directly, otherwise it is found by binary search. Lookups do not
+   * allocate memory.
+   */
+  class VISTimingTable {
+  public:
+    /// Smearing parameters at a point.
+    struct Smearing_t {
+      double cutoff; ///< largest smeared time [ns]
+      double tau;    ///< exponent of the power law
+    };
+
+    VISTimingTable() = default;
+
+    /**
+     * @brief Constructor: fills the table.
+     * @param distances cathode distance nodes [cm]
+     * @param radialDistances radial distance nodes [cm]
+     * @param cutoffPars cut-off values, by angular bin, radial node and distance node
+     * @param tauPars tau values, by angular bin, radial node and distance node
+     * @throw std::runtime_error if the shapes of the inputs don't match
+     */
+    VISTimingTable(std::vector<double> const& distances,
+                   std::vector<double> const& radialDistances,
+                   std::vector<std::vector<std::vector<double>>> const& cutoffPars,
+                   std::vector<std::vector<std::vector<double>>> const& tauPars)
+      : fDistances(distances, "cathode distance")
+      , fRadial(radialDistances, "radial distance")
+      , fNAngles(cutoffPars.size())
+    {
+      if (fNAngles == 0) throw std::runtime_error("VISTimingTable: no angular bin");
+      if (tauPars.size() != fNAngles)
+        throw std::runtime_error("VISTimingTable: cut-off and tau angular bins differ");
+
+      std::size_t const nR = fRadial.size();
+      std::size_t const nD = fDistances.size();
+      fValues.reserve(fNAngles * nR * nD);
+      for (std::size_t iAngle = 0; iAngle < fNAngles; ++iAngle) {
+        if ((cutoffPars[iAngle].size() != nR) || (tauPars[iAngle].size() != nR))
+          throw std::runtime_error("VISTimingTable: wrong number of radial nodes");
+        for (std::size_t iR = 0; iR < nR; ++iR) {
+          if ((cutoffPars[iAngle][iR].size() != nD) || (tauPars[iAngle][iR].size() != nD))
+            throw std::runtime_error("VISTimingTable: wrong number of distance nodes");
+          for (std::size_t iD = 0; iD < nD; ++iD)
+            fValues.push_back({cutoffPars[iAngle][iR][iD], tauPars[iAngle][iR][iD]});
+        }
+      }
+    }
+
+    /// Returns whether the table was filled.
+    bool
+    empty() const
+    {
+      return fValues.empty();
+    }
+
+    /// Returns the number of angular bins.
+    std::size_t
+    nAngleBins() const
+    {
+      return fNAngles;
+    }
+
+    /**
+     * @brief Returns the smearing parameters at the specified point.
+     * @param angleBin angular bin (bins beyond the last use the last one)
+     * @param distance distance from the cathode plane [cm]
+     * @param r radial distance from the cathode centre [cm]
+     */
+    Smearing_t
+    at(std::size_t angleBin, double distance, double r) const
+    {
+      angleBin = std::min(angleBin, fNAngles - 1);
+      auto const [iD, tD] = fDistances.locate(distance);
+      auto const [iR, tR] = fRadial.locate(r);
+
+      std::size_t const nD = fDistances.size();
+      Smearing_t const* row = fValues.data() + (angleBin * fRadial.size() + iR) * nD + iD;
+      Smearing_t const& v00 = row[0];
+      Smearing_t const& v01 = row[1];
+      Smearing_t const& v10 = row[nD];
+      Smearing_t const& v11 = row[nD + 1];
+
+      double const cutoff0 = v00.cutoff + tD * (v01.cutoff - v00.cutoff);
+      double const cutoff1 = v10.cutoff + tD * (v11.cutoff - v10.cutoff);
+      double const tau0 = v00.tau + tD * (v01.tau - v00.tau);
+      double const tau1 = v10.tau + tD * (v11.tau - v10.tau);
+      return {cutoff0 + tR * (cutoff1 - cutoff0), tau0 + tR * (tau1 - tau0)};
+    }
+
+  private:
+    /// Nodes of one axis of the table.
+    class Axis_t {
+    public:
+      Axis_t() = default;
+
+      Axis_t(std::vector<double> const& nodes, char const* name) : fNodes(nodes)
+      {
+        if (fNodes.size() < 2)
+          throw std::runtime_error(std::string("VISTimingTable: at least two ") + name +
+                                   " nodes are needed");
+        fStep = (fNodes.back() - fNodes.front()) / (fNodes.size() - 1);
+        fUniform = (fStep > 0.0);
+        for (std::size_t i = 1; i < fNodes.size(); ++i) {
+          if (!(fNodes[i] > fNodes[i - 1]))
+            throw std::runtime_error(std::string("VISTimingTable: ") + name +
+                                     " nodes are not increasing");
+          double const expected = fNodes.front() + i * fStep;
+          if (std::abs(fNodes[i] - expected) > 1e-9 * std::max(1.0, std::abs(expected)))
+            fUniform = false;
+        }
+      }
+
+      std::size_t
+      size() const
+      {
+        return fNodes.size();
+      }
+
+      /// Returns the interval of `x` and its relative position in it.
+      std::pair<std::size_t, double>
+      locate(double x) const
+      {
+        std::size_t const last = fNodes.size() - 2; // last interval
+        std::size_t i;
+        if (fUniform) {
+          double const f = (x - fNodes.front()) / fStep;
+          i = (f <= 0.0) ? 0 : std::min(static_cast<std::size_t>(f), last);
+        }
+        else {
+          // first interval whose right node is not smaller than `x`
+          i = std::lower_bound(fNodes.begin() + 1, fNodes.end() - 1, x) - (fNodes.begin() + 1);
+        }
+        return {i, (x - fNodes[i]) / (fNodes[i + 1] - fNodes[i])};
+      }
+
+    private:
+      std::vector<double> fNodes;
+      double fStep = 0.0;
+      bool fUniform = false;
+    }; // Axis_t
+
+    Axis_t fDistances;                ///< cathode distance nodes
+    Axis_t fRadial;                   ///< radial distance nodes
+    std::size_t fNAngles = 0;         ///< number of angular bins
+    std::vector<Smearing_t> fValues;  ///< by angle, radial node, distance node
+  }; // class VISTimingTable
+
+  /**
+   * @brief Smears an arrival time with the truncated power law.
+   * @param time unsmeared arrival time [ns]
+   * @param fastestTime earliest possible arrival time [ns]
+   * @param smearing cut-off and exponent of the smearing
+   * @param u a random number uniformly distributed in [ 0, 1 [
+   * @return the smeared time
+   *
+   * The smeared time is `time + (time - fastestTime) (x^-tau - 1)`, with `x`
+   * uniformly distributed in [ 0.5, 1 ] and constrained so that the result
+   * does not exceed the cut-off time. That is the same distribution as
+   * drawing `x` again until the smeared time is within the cut-off, but the
+   * constrained range of `x` is computed directly (inverse transform), so a
+   * single random number is always enough. Times already beyond the cut-off
+   * are not smeared.
+   */
+  inline double
+  smearVISTime(double time, double fastestTime, VISTimingTable::Smearing_t const& smearing, double u)
+  {
+    if (time >= smearing.cutoff) return time;
+
+    double const delay = time - fastestTime;
+    double xMin = 0.5;
+    if ((delay > 0.0) && (smearing.tau > 0.0)) {
+      // x^-tau <= 1 + (cutoff - time) / delay
+      double const xCut = std::pow(1.0 + (smearing.cutoff - time) / delay, -1.0 / smearing.tau);
+      xMin = std::max(xMin, xCut);
+    }
+    double const x = xMin + u * (1.0 - xMin);
+    return time + delay * (std::pow(x, -smearing.tau) - 1.0);
+  }
+
+} // namespace phot
+
+#endif // LARSIM_PHOTONPROPAGATION_VISTIMINGTABLE_H
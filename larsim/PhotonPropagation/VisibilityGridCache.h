@@ -0,0 +1,136 @@
+/**
+ * @file   larsim/PhotonPropagation/VisibilityGridCache.h
+ * @brief  Bounded, thread-safe cache of visibilities on a grid of cells.
+ * @see    larsim/PhotonPropagation/PDFastSimPAR_module.cc
+ *
+ * Parametrised light models (like the semi-analytic one) spend most of their
+ * time computing the visibility of each optical detector from a scintillation
+ * point. Deposits from the same track are close to each other, so the result
+ * can be reused for all the points falling into the same grid cell.
+ *
+ * This is a header-only library.
+ */
+
+#ifndef LARSIM_PHOTONPROPAGATION_VISIBILITYGRIDCACHE_H
+#define LARSIM_PHOTONPROPAGATION_VISIBILITYGRIDCACHE_H
+
+// C/C++ standard libraries
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace phot {
+
+  /// Identifier of a cell of the visibility grid within a TPC.
+  struct VisibilityGridCell {
+    unsigned int cryostat; ///< cryostat number
+    unsigned int tpc;      ///< TPC number within the cryostat
+    int x, y, z;           ///< cell index on each axis
+
+    bool
+    operator==(VisibilityGridCell const& other) const
+    {
+      return (x == other.x) && (y == other.y) && (z == other.z) && (tpc == other.tpc) &&
+             (cryostat == other.cryostat);
+    }
+  };
+
+  /// Hash function for `VisibilityGridCell`.
+  struct VisibilityGridCellHash {
+    std::size_t
+    operator()(VisibilityGridCell const& cell) const
+    {
+      std::size_t h = std::hash<unsigned int>{}(cell.cryostat);
+      for (std::size_t v : {std::size_t(cell.tpc),
+                            std::size_t(cell.x),
+                            std::size_t(cell.y),
+                            std::size_t(cell.z)})
+        h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+      return h;
+    }
+  };
+
+  /**
+   * @brief Cache of values (e.g. per-detector visibilities) by grid cell.
+   * @tparam Value type of the cached value
+   *
+   * The cache stores at most `capacity()` cells; once full, new values are
+   * not stored anymore and `insert()` returns `nullptr`. Stored values are
+   * never removed nor modified, so pointers returned by `find()` and
+   * `insert()` stay valid for the lifetime of the cache.
+   *
+   * Lookups and insertions can be performed concurrently.
+   */
+  template <typename Value>
+  class VisibilityGridCache {
+  public:
+    explicit VisibilityGridCache(std::size_t capacity) : fCapacity{capacity} {}
+
+    /// Returns the value cached for `cell`, `nullptr` if none.
+    Value const*
+    find(VisibilityGridCell const& cell) const
+    {
+      std::shared_lock lock{fMutex};
+      auto const it = fValues.find(cell);
+      if (it == fValues.end()) {
+        ++fMisses;
+        return nullptr;
+      }
+      ++fHits;
+      return &(it->second);
+    }
+
+    /// Stores a copy of `value` for `cell`; returns `nullptr` if full.
+    Value const*
+    insert(VisibilityGridCell const& cell, Value const& value)
+    {
+      std::unique_lock lock{fMutex};
+      auto const it = fValues.find(cell);
+      if (it != fValues.end()) return &(it->second);
+      if (fValues.size() >= fCapacity) return nullptr;
+      return &(fValues.emplace(cell, value).first->second);
+    }
+
+    /// Returns the number of cached cells.
+    std::size_t
+    size() const
+    {
+      std::shared_lock lock{fMutex};
+      return fValues.size();
+    }
+
+    /// Returns the maximum number of cells stored.
+    std::size_t
+    capacity() const
+    {
+      return fCapacity;
+    }
+
+    /// Returns the number of successful lookups.
+    std::size_t
+    hits() const
+    {
+      return fHits;
+    }
+
+    /// Returns the number of failed lookups.
+    std::size_t
+    misses() const
+    {
+      return fMisses;
+    }
+
+  private:
+    std::size_t const fCapacity;
+    mutable std::shared_mutex fMutex;
+    std::unordered_map<VisibilityGridCell, Value, VisibilityGridCellHash> fValues;
+    mutable std::atomic<std::size_t> fHits{0};
+    mutable std::atomic<std::size_t> fMisses{0};
+  };
+
+} // namespace phot
+
+#endif // LARSIM_PHOTONPROPAGATION_VISIBILITYGRIDCACHE_H
@@ -17,6 +17,7 @@
 #include "canvas/Persistency/Common/Ptr.h"
 #include "cetlib_except/exception.h"
 #include "canvas/Persistency/Common/FindOneP.h"
+#include "canvas/Utilities/InputTag.h"
 
 // LArSoft Includes
 #include "nusimdata/SimulationBase/MCParticle.h"
@@ -62,6 +63,14 @@ namespace simfilter {
   bool FilterNoDirtNeutrinos::filter(art::Event& evt)
   {
     bool interactionDesired(false);
+
+    // LArG4 may have already found that nothing reached the detector
+    // (option `AbortDirtEvents`), in which case there is nothing to check
+    art::Handle<bool> dirtAbortedHandle;
+    if (evt.getByLabel(art::InputTag(fLArG4ModuleLabel, "DirtAborted"), dirtAbortedHandle)
+        && *dirtAbortedHandle)
+      return false;
+
     //get the list of particles from this event
     art::ServiceHandle<geo::Geometry const> geom;
 
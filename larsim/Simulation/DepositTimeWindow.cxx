@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  DepositTimeWindow.cxx
+/// \brief Skips energy deposits which can't contribute to the readout.
+///
+////////////////////////////////////////////////////////////////////////
+
+#include "larsim/Simulation/DepositTimeWindow.h"
+
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+#include "lardataalg/DetectorInfo/DetectorClocksData.h"
+#include "lardataalg/DetectorInfo/DetectorPropertiesData.h"
+
+#include "cetlib_except/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <algorithm>
+
+namespace sim {
+
+  //----------------------------------------------------------------------
+  DepositTimeWindow::DepositTimeWindow(fhicl::ParameterSet const& pset)
+    : fEnabled{!pset.is_empty() && pset.get<bool>("Enable", true)}
+  {
+    double maxDelay = 0.;
+    fMaxDelayConfigured = pset.get_if_present("MaxDelay", maxDelay);
+    if (fMaxDelayConfigured) fMaxDelay = maxDelay;
+
+    double start = 0.;
+    double end = 0.;
+    bool const hasStart = pset.get_if_present("Start", start);
+    bool const hasEnd = pset.get_if_present("End", end);
+    if (hasStart != hasEnd) {
+      throw cet::exception("DepositTimeWindow")
+        << "Both or none of 'Start' and 'End' must be specified.\n";
+    }
+    fWindowConfigured = hasStart;
+    if (fWindowConfigured) SetWindow(start, end);
+  }
+
+  //----------------------------------------------------------------------
+  void
+  DepositTimeWindow::SetEvent(detinfo::DetectorClocksData const& clockData,
+                              detinfo::DetectorPropertiesData const& detProp)
+  {
+    if (!fEnabled || fWindowConfigured) return;
+
+    // TPC tick `t` covers electronics times from `t` tick periods (us);
+    // convert back to simulation time (ns)
+    double const elecOfSimZero = clockData.G4ToElecTime(0.);
+    double const readoutLength = detProp.NumberTimeSamples() * clockData.TPCClock().TickPeriod();
+    SetWindow(-elecOfSimZero * 1000., (readoutLength - elecOfSimZero) * 1000.);
+  }
+
+  //----------------------------------------------------------------------
+  void
+  DepositTimeWindow::PrintSummary(std::string const& category) const
+  {
+    if (!fEnabled) return;
+    mf::LogInfo(category) << "Skipped " << fNSkipped << " of " << fNSeen
+                          << " energy deposits out of the readout window (" << fSkippedEnergy
+                          << " MeV); maximum signal delay: " << fMaxDelay << " ns";
+  }
+
+  //----------------------------------------------------------------------
+  double
+  DepositTimeWindow::MaxDriftTime(geo::GeometryCore const& geom,
+                                  detinfo::DetectorPropertiesData const& detProp)
+  {
+    double maxDistance = 0.;
+    for (unsigned int c = 0; c < geom.Ncryostats(); ++c)
+      for (unsigned int t = 0; t < geom.NTPC(c); ++t)
+        maxDistance = std::max(maxDistance, geom.TPC(t, c).DriftDistance());
+
+    // drift velocity in cm/us
+    double const driftVelocity = detProp.DriftVelocity(detProp.Efield(), detProp.Temperature());
+    return maxDistance / driftVelocity * 1000.;
+  }
+
+} // namespace sim
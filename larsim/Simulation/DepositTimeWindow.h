@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////
+/// \file  DepositTimeWindow.h
+/// \brief Skips energy deposits which can't contribute to the readout.
+///
+////////////////////////////////////////////////////////////////////////
+
+/// Modules simulating the charge and the light from `sim::SimEnergyDeposit`
+/// (`IonAndScint`, `SimDriftElectrons`, `PDFastSimPVS`, `PDFastSimPAR`)
+/// consult a `DepositTimeWindow` to skip the deposits whose signal can't
+/// arrive within the readout window, like the ones from overlays spanning a
+/// time much longer than the readout.
+///
+/// A deposit is kept if the interval from its start time to its end time
+/// plus the largest delay of the signal (drift, scintillation, propagation)
+/// overlaps the window.
+///
+/// It is configured by the `DepositTimeWindow` table of each module:
+/// * `Enable` (default: `true` if the table is present): skip deposits
+/// * `Start`, `End` (simulation time, ns): the window; if omitted, it is the
+///   TPC readout window, from the detector clocks of each event: TPC ticks
+///   from `0` to `NumberTimeSamples()`
+/// * `MaxDelay` (ns): the largest delay of the signal; each module has its
+///   own default (e.g. the longest drift time, or `DefaultLightDelay`)
+///
+/// The number and energy of the skipped deposits are reported at the end of
+/// the job.
+
+#ifndef SIM_DEPOSITTIMEWINDOW_H
+#define SIM_DEPOSITTIMEWINDOW_H
+
+#include "lardataobj/Simulation/SimEnergyDeposit.h"
+
+#include "fhiclcpp/fwd.h"
+
+#include <string>
+
+namespace detinfo {
+  class DetectorClocksData;
+  class DetectorPropertiesData;
+}
+
+namespace geo {
+  class GeometryCore;
+}
+
+namespace sim {
+
+  class DepositTimeWindow {
+  public:
+    /// Default largest delay of scintillation light (ns): over ten times the
+    /// slow component time constant in argon.
+    static constexpr double DefaultLightDelay = 20000.;
+
+    /// Default constructor: all deposits are kept.
+    DepositTimeWindow() = default;
+
+    /// Constructor: skips deposits which can't arrive within `maxDelay` (ns).
+    explicit DepositTimeWindow(double maxDelay) : fEnabled{true}, fMaxDelay{maxDelay} {}
+
+    /// Constructor: reads the `DepositTimeWindow` table `pset` (may be empty).
+    explicit DepositTimeWindow(fhicl::ParameterSet const& pset);
+
+    /// Returns whether deposits are skipped at all.
+    bool
+    Enabled() const
+    {
+      return fEnabled;
+    }
+
+    /// Sets the largest delay, unless it was configured (ns).
+    void
+    SetDefaultMaxDelay(double maxDelay)
+    {
+      if (!fMaxDelayConfigured) fMaxDelay = maxDelay;
+    }
+
+    /// Sets the window (simulation time, ns).
+    void
+    SetWindow(double start, double end)
+    {
+      fStart = start;
+      fEnd = end;
+    }
+
+    /// Sets the window from the TPC readout of the event, unless configured.
+    void SetEvent(detinfo::DetectorClocksData const& clockData,
+                  detinfo::DetectorPropertiesData const& detProp);
+
+    /// Returns whether a signal from `startTime` to `endTime` can be read out.
+    bool
+    Accept(double startTime, double endTime, double energy)
+    {
+      if (!fEnabled) return true;
+      ++fNSeen;
+      if ((startTime <= fEnd) && (endTime + fMaxDelay >= fStart)) return true;
+      ++fNSkipped;
+      fSkippedEnergy += energy;
+      return false;
+    }
+
+    /// Returns whether the signal from `edep` can be read out.
+    bool
+    Accept(sim::SimEnergyDeposit const& edep)
+    {
+      return Accept(edep.StartT(), edep.EndT(), edep.Energy());
+    }
+
+    /// Number of deposits which were checked.
+    unsigned long long
+    NSeen() const
+    {
+      return fNSeen;
+    }
+
+    /// Number of deposits which were skipped.
+    unsigned long long
+    NSkipped() const
+    {
+      return fNSkipped;
+    }
+
+    /// Total energy of the deposits which were skipped (MeV).
+    double
+    SkippedEnergy() const
+    {
+      return fSkippedEnergy;
+    }
+
+    /// Writes the number of skipped deposits into the log, under `category`.
+    void PrintSummary(std::string const& category) const;
+
+    /// Longest drift time from the cathode to the first plane of any TPC (ns).
+    static double MaxDriftTime(geo::GeometryCore const& geom,
+                               detinfo::DetectorPropertiesData const& detProp);
+
+  private:
+    bool fEnabled = false;            ///< whether deposits are skipped
+    bool fWindowConfigured = false;   ///< whether the window is from the configuration
+    bool fMaxDelayConfigured = false; ///< whether the delay is from the configuration
+    double fStart = 0.;               ///< start of the window (ns)
+    double fEnd = 0.;                 ///< end of the window (ns)
+    double fMaxDelay = 0.;            ///< largest delay of the signal (ns)
+    unsigned long long fNSeen = 0;    ///< number of deposits checked
+    unsigned long long fNSkipped = 0; ///< number of deposits skipped
+    double fSkippedEnergy = 0.;       ///< energy of the deposits skipped (MeV)
+  }; // class DepositTimeWindow
+
+} // namespace sim
+
+#endif // SIM_DEPOSITTIMEWINDOW_H
@@ -14,6 +14,7 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
 
 #ifndef LArG4Parameters_h
 #define LArG4Parameters_h 1
@@ -29,6 +30,31 @@ namespace sim {
 
   class LArG4Parameters {
   public:
+    /**
+     * @brief Geant4 region with its own production cuts and user limits.
+     *
+     * In Geant4 a region extends to all the daughters of its volumes (unless
+     * they are in another region): only volumes without TPC active volumes
+     * among their descendents, like rock and concrete, are accepted.
+     */
+    struct ProductionRegion_t {
+      std::string name;                        ///< name of the Geant4 region
+      std::vector<std::string> volumePatterns; ///< regular expressions of logical volume names
+      double productionCut = 0.;    ///< range cut for secondary production [cm] (0: default)
+      double maxStepLength = 0.;    ///< step length limit [cm] (0: no limit)
+      double minKineticEnergy = 0.; ///< tracks below this are stopped [GeV] (0: no limit)
+      double maxTrackTime = 0.;     ///< tracks are stopped after this time [ns] (0: no limit)
+      double fastEMShowerMinEnergy = 0.;  ///< e/gamma above this get parameterized showers [GeV]
+      double fastEMShowerMinLeakage = 0.; ///< shower leakage emitted only above this [GeV]
+
+      /// Returns whether the region sets any user limit.
+      bool hasUserLimits() const
+        { return (maxStepLength > 0.) || (minKineticEnergy > 0.) || (maxTrackTime > 0.); }
+
+      /// Returns whether electromagnetic showers are parameterized in the region.
+      bool hasFastEMShower() const { return fastEMShowerMinEnergy > 0.; }
+    };
+
     LArG4Parameters(fhicl::ParameterSet const& pset);
 
     int    OpVerbosity()                                      const { return fOpVerbosity;            }
@@ -62,10 +88,20 @@ namespace sim {
     const std::vector<int>&         OpticalParamOrientations() const { return fOpticalParamOrientations;}
     const std::vector<std::vector<std::vector<double>>>& OpticalParamParameters() const {return fOpticalParamParameters;  }
     bool UseLitePhotons()                                     const { return fLitePhotons;            }
+    bool UseBinnedLitePhotons()                               const { return fBinnedLitePhotons;      }
+    bool UseOpticalRoulette()                                 const { return fOpticalRoulette;        }
+    double OpticalRouletteMinPathLength()                     const { return fOpRouletteMinPathLength;}
+    int OpticalRouletteMinScatters()                          const { return fOpRouletteMinScatters;  }
+    double OpticalRouletteVisibilityScale()                   const { return fOpRouletteVisibilityScale; }
+    double OpticalRouletteMinSurvival()                       const { return fOpRouletteMinSurvival;  }
+    const std::vector<std::vector<double>>& OpticalRouletteRegions() const { return fOpRouletteRegions; }
+
+    const std::vector<ProductionRegion_t>& ProductionRegions()  const { return fProductionRegions;     }
 
     bool FillSimEnergyDeposits()                            const { return fFillSimEnergyDeposits;  }
     bool NoElectronPropagation()                            const { return fNoElectronPropagation;  }
     bool NoPhotonPropagation()                              const { return fNoPhotonPropagation;    }
+    bool FillIonAndScintHistograms()                        const { return fFillIonAndScintHistograms; }
 
   private:
     int  const               fOpVerbosity;           ///< Verbosity of optical simulation - soon to be depricated
@@ -113,10 +149,23 @@ namespace sim {
                                                                                  ///< parameterized volumes
 
     bool const fLitePhotons;
+    bool const fBinnedLitePhotons;      ///< draw lite photon counts per tick instead of per photon
+
+    bool const fOpticalRoulette;            ///< Russian roulette of photons in full optical simulation
+    double const fOpRouletteMinPathLength;  ///< photon path before the roulette [cm]
+    int const fOpRouletteMinScatters;       ///< Rayleigh scatters before the roulette (0: no limit)
+    double const fOpRouletteVisibilityScale;///< visibility at which photons always survive
+    double const fOpRouletteMinSurvival;    ///< smallest survival probability
+    std::vector<std::vector<double>> const fOpRouletteRegions; ///< boxes and their visibility:
+                                                               ///< { x1, x2, y1, y2, z1, z2, vis } [cm]
+
+    std::vector<ProductionRegion_t> const fProductionRegions; ///< Geant4 regions with own cuts and limits
 
     bool const fFillSimEnergyDeposits;  ///< handle to fill SimEdeps or not
     bool const fNoElectronPropagation;  ///< specifically prevents electron propagation
     bool const fNoPhotonPropagation;    ///< specifically prevents photon propagation in opfast
+    bool const fFillIonAndScintHistograms; ///< fill per-step diagnostic histograms in
+                                           ///< LArG4/IonizationAndScintillation.cxx
   };
 }
 
@@ -15,6 +15,36 @@
 
 #include "larsim/Simulation/LArG4Parameters.h"
 
+#include "cetlib_except/exception.h"
+
+namespace {
+
+  /// Reads the configuration of the production regions.
+  std::vector<sim::LArG4Parameters::ProductionRegion_t>
+  readProductionRegions(std::vector<fhicl::ParameterSet> const& configs)
+  {
+    std::vector<sim::LArG4Parameters::ProductionRegion_t> regions;
+    for (fhicl::ParameterSet const& config: configs) {
+      sim::LArG4Parameters::ProductionRegion_t region;
+      region.name             = config.get<std::string>("Name");
+      region.volumePatterns   = config.get<std::vector<std::string>>("Volumes");
+      region.productionCut    = config.get<double>("ProductionCut", 0.);
+      region.maxStepLength    = config.get<double>("MaxStepLength", 0.);
+      region.minKineticEnergy = config.get<double>("MinKineticEnergy", 0.);
+      region.maxTrackTime     = config.get<double>("MaxTrackTime", 0.);
+      region.fastEMShowerMinEnergy  = config.get<double>("FastEMShowerMinEnergy", 0.);
+      region.fastEMShowerMinLeakage = config.get<double>("FastEMShowerMinLeakage", 0.001);
+      if (region.volumePatterns.empty()) {
+        throw cet::exception("LArG4Parameters")
+          << "Production region '" << region.name << "' has no volume.\n";
+      }
+      regions.push_back(std::move(region));
+    }
+    return regions;
+  } // readProductionRegions()
+
+} // local namespace
+
 namespace sim {
 
   //--------------------------------------------------------------------------
@@ -54,9 +84,18 @@ namespace sim {
     , fOpticalParamOrientations{pset.get< std::vector<int>         >("OpticalParamOrientations")}
     , fOpticalParamParameters  {pset.get< std::vector<std::vector<std::vector<double> > > >("OpticalParamParameters")}
     , fLitePhotons             {pset.get< bool                     >("UseLitePhotons"       )}
+    , fBinnedLitePhotons       {pset.get< bool                     >("UseBinnedLitePhotons",false)}
+    , fOpticalRoulette         {pset.get< bool                     >("UseOpticalRoulette",false)}
+    , fOpRouletteMinPathLength {pset.get< double                   >("OpticalRouletteMinPathLength",100.)}
+    , fOpRouletteMinScatters   {pset.get< int                      >("OpticalRouletteMinScatters",0)}
+    , fOpRouletteVisibilityScale{pset.get< double                  >("OpticalRouletteVisibilityScale",1e-3)}
+    , fOpRouletteMinSurvival   {pset.get< double                   >("OpticalRouletteMinSurvival",0.01)}
+    , fOpRouletteRegions       {pset.get< std::vector<std::vector<double>> >("OpticalRouletteRegions",{})}
+    , fProductionRegions       {readProductionRegions(pset.get< std::vector<fhicl::ParameterSet> >("ProductionRegions",{}))}
     , fFillSimEnergyDeposits   {pset.get< bool                     >("FillSimEnergyDeposits",false)}
     , fNoElectronPropagation   {pset.get< bool                     >("NoElectronPropagation",false)}
     , fNoPhotonPropagation     {pset.get< bool                     >("NoPhotonPropagation",false)}
+    , fFillIonAndScintHistograms{pset.get< bool                    >("FillIonAndScintHistograms",false)}
   {}
 }
 
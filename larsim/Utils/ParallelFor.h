@@ -0,0 +1,62 @@
+/**
+ * @file   larsim/Utils/ParallelFor.h
+ * @brief  Runs independent work items as TBB tasks.
+ *
+ * Parallel work inside art modules must run as TBB tasks, so that it shares
+ * the threads art schedules instead of adding its own. This is a header-only
+ * library; its users link to TBB.
+ */
+
+#ifndef LARSIM_UTILS_PARALLELFOR_H
+#define LARSIM_UTILS_PARALLELFOR_H
+
+// TBB libraries
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+// C/C++ standard libraries
+#include <cstddef>
+
+namespace larsim {
+  namespace Utils {
+
+    /**
+     * @brief Calls `work(i)` for all `i` from `0` to `n - 1`.
+     * @param n number of work items
+     * @param nThreads largest number of threads to use (`0`: no limit)
+     * @param work the function processing a single item
+     *
+     * With `nThreads` `1` the items are processed in order in this thread.
+     * Otherwise they are processed as TBB tasks, in an unspecified order,
+     * by at most `nThreads` threads, within the limits of the job (e.g. the
+     * threads of art). If a call throws an exception, the remaining items
+     * may be skipped, and the exception is rethrown.
+     */
+    template <typename Work>
+    void
+    ParallelFor(std::size_t n, unsigned int nThreads, Work&& work)
+    {
+      if ((nThreads == 1U) || (n <= 1U)) {
+        for (std::size_t i = 0; i < n; ++i)
+          work(i);
+        return;
+      }
+
+      tbb::blocked_range<std::size_t> const items{0U, n};
+      auto const body = [&work](tbb::blocked_range<std::size_t> const& range) {
+        for (std::size_t i = range.begin(); i != range.end(); ++i)
+          work(i);
+      };
+      if (nThreads == 0U) {
+        tbb::parallel_for(items, body);
+        return;
+      }
+      tbb::task_arena arena{static_cast<int>(nThreads)};
+      arena.execute([&items, &body]() { tbb::parallel_for(items, body); });
+    }
+
+  } // namespace Utils
+} // namespace larsim
+
+#endif // LARSIM_UTILS_PARALLELFOR_H
@@ -0,0 +1,102 @@
+/**
+ * @file    TruncatedResponseKernel_test.cc
+ * @brief   Unit test for `detsim::TruncatedResponseKernel`.
+ * @see     `larsim/DetSim/TruncatedResponseKernel.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( TruncatedResponseKernel_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/DetSim/TruncatedResponseKernel.h"
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+//------------------------------------------------------------------------------
+/// Circular convolution with the full response, as done via FFT.
+std::vector<double> fullConvolution
+  (std::vector<double> const& signal, std::vector<double> const& response)
+{
+  std::size_t const n = signal.size();
+  std::vector<double> result(n, 0.);
+  for (std::size_t t = 0; t < n; ++t)
+    for (std::size_t k = 0; k < n; ++k)
+      result[(t + k) % n] += signal[t] * response[k];
+  return result;
+} // fullConvolution()
+
+
+/// A bipolar response peaked around `center` (may wrap around).
+std::vector<double> makeResponse(std::size_t n, double center) {
+  std::vector<double> response(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    double d = double(i) - center;
+    if (d > n / 2.) d -= n;
+    if (d < -(n / 2.)) d += n;
+    response[i] = -d * std::exp(-d * d / 18.);
+  }
+  return response;
+} // makeResponse()
+
+
+//------------------------------------------------------------------------------
+void checkAgainstFull(std::vector<double> const& response, double threshold) {
+
+  std::size_t const n = response.size();
+  detsim::TruncatedResponseKernel const kernel(response, threshold);
+  BOOST_TEST(kernel.period() == n);
+  BOOST_TEST(kernel.size() < n / 4);
+
+  std::vector<double> signal(n, 0.);
+  signal[0] = 5000.;
+  signal[7] = 1200.;
+  signal[n / 2] = 800.;
+  signal[n - 2] = 3000.;
+
+  std::vector<double> const expected = fullConvolution(signal, response);
+  std::vector<double> result = signal, work;
+  kernel.convolute(result, work);
+
+  BOOST_TEST_REQUIRE(result.size() == n);
+  double peak = 0.;
+  for (double v: expected) peak = std::max(peak, std::abs(v));
+  for (std::size_t i = 0; i < n; ++i)
+    BOOST_TEST(std::abs(result[i] - expected[i]) < 1e-9 * peak);
+
+} // checkAgainstFull()
+
+
+BOOST_AUTO_TEST_CASE(CenteredResponse_test) {
+  checkAgainstFull(makeResponse(256, 40.), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(WrappingResponse_test) {
+  // response peaked at the start, as after the alignment shift in SimWire
+  detsim::TruncatedResponseKernel const kernel(makeResponse(256, 2.), 1e-12);
+  BOOST_TEST(kernel.first() > 128U);
+  checkAgainstFull(makeResponse(256, 2.), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(Truncation_test) {
+  // a looser threshold drops the tails, with small deviations only
+  std::vector<double> const response = makeResponse(256, 100.);
+  detsim::TruncatedResponseKernel const tight(response, 1e-12);
+  detsim::TruncatedResponseKernel const loose(response, 1e-3);
+  BOOST_TEST(loose.size() < tight.size());
+
+  std::vector<double> signal(256, 0.);
+  signal[30] = 1e4;
+  std::vector<double> const expected = fullConvolution(signal, response);
+  std::vector<double> result = signal, work;
+  loose.convolute(result, work);
+  double peak = 0.;
+  for (double v: expected) peak = std::max(peak, std::abs(v));
+  for (std::size_t i = 0; i < result.size(); ++i)
+    BOOST_TEST(std::abs(result[i] - expected[i]) < 1e-3 * peak);
+}
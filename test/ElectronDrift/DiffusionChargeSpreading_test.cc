@@ -0,0 +1,220 @@
+/**
+ * @file    DiffusionChargeSpreading_test.cc
+ * @brief   Statistical validation of the analytic diffusion charge spreading.
+ * @see     `larsim/ElectronDrift/DiffusionChargeSpreading.h`
+ *
+ * The analytic bin fractions and their multinomial fluctuations are compared
+ * with the Monte Carlo cluster path of `SimDriftElectrons`, where each
+ * cluster is displaced by a Gaussian and assigned to the nearest wire and to
+ * the TDC tick it arrives in.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( DiffusionChargeSpreading_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/ElectronDrift/DiffusionChargeSpreading.h"
+
+// C/C++ standard libraries
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Fractions of clusters in each bin, sampled like the Monte Carlo path.
+std::vector<double> sampleBinFractions(
+  double mean, double sigma, double origin, double width,
+  detsim::diffusion::BinFractions const& bins, unsigned int nSamples,
+  std::mt19937& engine
+) {
+  std::normal_distribution<double> gauss{ mean, sigma };
+  std::vector<double> fractions(bins.fractions.size(), 0.0);
+  for (unsigned int i = 0; i < nSamples; ++i) {
+    int const bin = static_cast<int>(std::floor((gauss(engine) - origin) / width));
+    int const index = bin - bins.first;
+    if ((index >= 0) && (index < static_cast<int>(fractions.size())))
+      fractions[index] += 1.0 / nSamples;
+  } // for
+  return fractions;
+} // sampleBinFractions()
+
+
+//------------------------------------------------------------------------------
+void BinFractionsTest() {
+
+  // no diffusion: all in one bin
+  auto const point = detsim::diffusion::gaussianBinFractions(12.3, 0.0, -0.5, 1.0, 4.0);
+  BOOST_CHECK_EQUAL(point.first, 12);
+  BOOST_REQUIRE_EQUAL(point.fractions.size(), 1U);
+  BOOST_CHECK_EQUAL(point.fractions[0], 1.0);
+
+  // symmetric cloud centred on a wire
+  auto const wires = detsim::diffusion::gaussianBinFractions(20.0, 0.8, -0.5, 1.0, 4.0);
+  BOOST_CHECK_EQUAL(wires.first, 17); // 4 sigma = 3.2 wires
+  BOOST_REQUIRE_EQUAL(wires.fractions.size(), 7U);
+  BOOST_CHECK_CLOSE(
+    std::accumulate(wires.fractions.begin(), wires.fractions.end(), 0.0), 1.0, 1e-9);
+  BOOST_CHECK_CLOSE(wires.fractions[3], std::erf(0.5 / (0.8 * std::sqrt(2.))), 0.01);
+  BOOST_CHECK_CLOSE(wires.fractions[2], wires.fractions[4], 1e-9);
+
+} // BinFractionsTest()
+
+
+//------------------------------------------------------------------------------
+void MonteCarloComparisonTest() {
+
+  std::mt19937 engine{ 12345 };
+  unsigned int const nSamples = 400000;
+
+  struct Case_t { double mean, sigma, origin, width; };
+  for (Case_t const& test: {
+    Case_t{ 105.37, 0.65, -0.5, 1.0 },  // transverse, in wire units
+    Case_t{ 1603.2, 1.9, 0.0, 0.5 },    // longitudinal, in us with 0.5 us ticks
+    Case_t{ 7.9, 0.12, -0.5, 1.0 },     // narrow cloud
+  }) {
+    auto const bins = detsim::diffusion::gaussianBinFractions
+      (test.mean, test.sigma, test.origin, test.width, 4.0);
+    std::vector<double> const sampled = sampleBinFractions
+      (test.mean, test.sigma, test.origin, test.width, bins, nSamples, engine);
+
+    // chi^2 of the sampled fractions against the analytic expectation
+    double chi2 = 0.0;
+    unsigned int nBins = 0;
+    for (std::size_t i = 0; i < bins.fractions.size(); ++i) {
+      double const expected = bins.fractions[i] * nSamples;
+      if (expected < 5.0) continue;
+      double const diff = sampled[i] * nSamples - expected;
+      chi2 += diff * diff / expected;
+      ++nBins;
+    }
+    BOOST_TEST_MESSAGE("mean=" << test.mean << " sigma=" << test.sigma
+      << ": chi2/ndf = " << chi2 << "/" << nBins);
+    BOOST_REQUIRE_GT(nBins, 0U);
+    // generous bound: 5 sigma of the chi^2 distribution above the mean
+    BOOST_CHECK_LT(chi2, nBins + 5.0 * std::sqrt(2.0 * nBins));
+  } // for
+
+} // MonteCarloComparisonTest()
+
+
+//------------------------------------------------------------------------------
+void MultinomialTest() {
+
+  std::mt19937 engine{ 54321 };
+  auto binomial = [&engine](int n, double p)
+    { return std::binomial_distribution<int>{ n, p }(engine); };
+
+  std::vector<double> const probabilities{ 0.1, 0.0, 0.25, 0.4, 0.25 };
+  int const nElectrons = 6000;
+  unsigned int const nTrials = 2000;
+
+  std::vector<double> mean(probabilities.size(), 0.0);
+  for (unsigned int trial = 0; trial < nTrials; ++trial) {
+    std::vector<int> const counts
+      = detsim::diffusion::multinomialSplit(nElectrons, probabilities, binomial);
+    // charge is conserved in each draw
+    BOOST_CHECK_EQUAL(std::accumulate(counts.begin(), counts.end(), 0), nElectrons);
+    BOOST_CHECK_EQUAL(counts[1], 0);
+    for (std::size_t i = 0; i < counts.size(); ++i)
+      mean[i] += double(counts[i]) / nTrials;
+  } // for
+
+  for (std::size_t i = 0; i < probabilities.size(); ++i) {
+    double const expected = nElectrons * probabilities[i];
+    double const error = std::sqrt(expected * (1.0 - probabilities[i]) / nTrials);
+    BOOST_CHECK_SMALL(mean[i] - expected, 5.0 * error + 1e-9);
+  }
+
+
+  // trailing bins with no probability: the last nonzero one gets the rest
+  std::vector<double> const trailingZeros{ 0.3, 0.0, 0.7, 0.0, 0.0 };
+  for (unsigned int trial = 0; trial < 100; ++trial) {
+    std::vector<int> const counts
+      = detsim::diffusion::multinomialSplit(nElectrons, trailingZeros, binomial);
+    BOOST_CHECK_EQUAL(std::accumulate(counts.begin(), counts.end(), 0), nElectrons);
+    BOOST_CHECK_EQUAL(counts[1], 0);
+    BOOST_CHECK_EQUAL(counts[3], 0);
+    BOOST_CHECK_EQUAL(counts[4], 0);
+  } // for
+
+  // the last bin is not drawn, even if its share is rounded below 1
+  auto noBinomial = [](int, double p) -> int
+    { BOOST_CHECK_LT(p, 1.0); return 0; };
+  std::vector<int> const allLast = detsim::diffusion::multinomialSplit
+    (nElectrons, std::vector<double>{ 0.1, 0.2, 0.7 }, noBinomial);
+  BOOST_CHECK_EQUAL(allLast[2], nElectrons);
+
+  // no probability at all
+  std::vector<int> const none = detsim::diffusion::multinomialSplit
+    (nElectrons, std::vector<double>{ 0.0, 0.0 }, binomial);
+  BOOST_CHECK_EQUAL(none[0] + none[1], 0);
+
+} // MultinomialTest()
+
+
+//------------------------------------------------------------------------------
+void ChargeSplitTest() {
+
+  std::mt19937 engine{ 13579 };
+  auto binomial = [&engine](int n, double p)
+    { return std::binomial_distribution<int>{ n, p }(engine); };
+
+  // the charge of each plane, fractional part included, is conserved,
+  // as in the cluster path where each cluster carries a fractional charge
+  std::vector<double> const probabilities{ 0.1, 0.0, 0.25, 0.4, 0.25 };
+  for (double const charge: { 1234.56, 0.3, 7.0 }) {
+    for (unsigned int trial = 0; trial < 100; ++trial) {
+      std::vector<double> const charges
+        = detsim::diffusion::chargeSplit(charge, probabilities, binomial);
+      BOOST_CHECK_CLOSE
+        (std::accumulate(charges.begin(), charges.end(), 0.0), charge, 1e-9);
+      BOOST_CHECK_EQUAL(charges[1], 0.0);
+      // only the most probable bin has a fractional charge
+      for (std::size_t i = 0; i < charges.size(); ++i) {
+        if (i == 3) continue;
+        BOOST_CHECK_EQUAL(charges[i], std::floor(charges[i]));
+      }
+    } // for trials
+  } // for charges
+
+  // no charge, or no probability
+  std::vector<double> const none
+    = detsim::diffusion::chargeSplit(0.0, probabilities, binomial);
+  BOOST_CHECK_EQUAL(std::accumulate(none.begin(), none.end(), 0.0), 0.0);
+  std::vector<double> const nowhere = detsim::diffusion::chargeSplit
+    (12.5, std::vector<double>{ 0.0, 0.0 }, binomial);
+  BOOST_CHECK_EQUAL(nowhere[0] + nowhere[1], 0.0);
+
+} // ChargeSplitTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(BinFractionsTestCase) {
+
+  BinFractionsTest();
+
+} // BOOST_AUTO_TEST_CASE(BinFractionsTestCase)
+
+
+BOOST_AUTO_TEST_CASE(MonteCarloComparisonTestCase) {
+
+  MonteCarloComparisonTest();
+
+} // BOOST_AUTO_TEST_CASE(MonteCarloComparisonTestCase)
+
+
+BOOST_AUTO_TEST_CASE(MultinomialTestCase) {
+
+  MultinomialTest();
+
+} // BOOST_AUTO_TEST_CASE(MultinomialTestCase)
+
+
+BOOST_AUTO_TEST_CASE(ChargeSplitTestCase) {
+
+  ChargeSplitTest();
+
+} // BOOST_AUTO_TEST_CASE(ChargeSplitTestCase)
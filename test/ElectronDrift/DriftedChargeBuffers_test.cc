@@ -0,0 +1,142 @@
+/**
+ * @file    DriftedChargeBuffers_test.cc
+ * @brief   Unit test for `detsim::DriftedChargeBuffers`.
+ * @see     `larsim/ElectronDrift/DriftedChargeBuffers.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( DriftedChargeBuffers_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/ElectronDrift/DriftedChargeBuffers.h"
+
+// C/C++ standard libraries
+#include <vector>
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Accumulation_test) {
+
+  detsim::DriftedChargeBuffers buffers{ 10U, 20U, true };
+  BOOST_TEST(buffers.size() == 0U);
+  BOOST_TEST(!buffers.find(3U));
+
+  double const xyzA[3] = { 1.0, 2.0, 3.0 };
+  double const xyzB[3] = { 3.0, 2.0, 1.0 };
+  buffers.add(7U, 4U, 100.0, 1, 1.0, xyzA);
+  buffers.add(3U, 5U, 50.0, 1, 0.5, xyzA);
+  buffers.add(7U, 4U, 20.0, 2, 0.2, xyzB);
+  buffers.add(7U, 8U, 300.0, 1, 3.0, xyzB);
+  buffers.add(7U, 25U, 10.0, 2, 0.1, xyzB); // beyond the buffer: truth only
+
+  BOOST_TEST(buffers.size() == 2U);
+  // in order of first charge
+  std::vector<unsigned int> order;
+  for (auto const& data: buffers) order.push_back(data.channel);
+  BOOST_TEST(order == (std::vector<unsigned int>{ 7U, 3U }), boost::test_tools::per_element());
+
+  auto const* data = buffers.find(7U);
+  BOOST_REQUIRE(data);
+  BOOST_TEST(data->nSignalTicks == 2U);
+  BOOST_TEST(data->ranges.size() == 1U); // ticks 4 and 8 share a range
+  std::vector<double> charges;
+  buffers.fillCharges(*data, charges);
+  BOOST_TEST(charges.size() == 20U);
+  BOOST_TEST(charges[4] == 120.0);
+  BOOST_TEST(charges[8] == 300.0);
+  BOOST_TEST(charges[5] == 0.0);
+
+  BOOST_REQUIRE(data->tracks.size() == 2U);
+  auto const& track1 = data->tracks[0];
+  BOOST_TEST(track1.trackID == 1);
+  BOOST_TEST(track1.electrons == 400.0);
+  BOOST_TEST(track1.energy == 4.0, boost::test_tools::tolerance(1e-12));
+  BOOST_TEST(track1.meanTick() == 7.0);
+  BOOST_TEST(track1.xyzSum[0] / track1.electrons == 2.5);
+  auto const& track2 = data->tracks[1];
+  BOOST_TEST(track2.trackID == 2);
+  BOOST_TEST(track2.electrons == 30.0);
+  BOOST_TEST(track2.meanTick() == 11.0);
+
+} // BOOST_AUTO_TEST_CASE(Accumulation_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Reuse_test) {
+
+  double const xyz[3] = { 0.0, 0.0, 0.0 };
+  detsim::DriftedChargeBuffers buffers{ 10U, 5U, false };
+  buffers.add(2U, 1U, 10.0, 1, 0.1, xyz);
+  buffers.add(6U, 3U, 10.0, 1, 0.1, xyz);
+  BOOST_TEST(buffers.find(2U)->tracks.empty());
+
+  buffers.clear();
+  BOOST_TEST(buffers.size() == 0U);
+  BOOST_TEST(!buffers.find(2U));
+  BOOST_TEST(!buffers.find(6U));
+
+  // a reused buffer starts empty
+  buffers.add(9U, 0U, 5.0, 1, 0.1, xyz);
+  auto const* data = buffers.find(9U);
+  BOOST_REQUIRE(data);
+  BOOST_TEST(data->nSignalTicks == 1U);
+  std::vector<double> charges;
+  buffers.fillCharges(*data, charges);
+  BOOST_TEST(charges == (std::vector<double>{ 5.0, 0.0, 0.0, 0.0, 0.0 }),
+    boost::test_tools::per_element());
+
+} // BOOST_AUTO_TEST_CASE(Reuse_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(TickRanges_test) {
+
+  using Buffers_t = detsim::DriftedChargeBuffers;
+  constexpr unsigned int Gap = Buffers_t::MaxGap;
+
+  double const xyz[3] = { 0.0, 0.0, 0.0 };
+  Buffers_t buffers{ 1U, 1000U, false };
+  auto const addAt = [&buffers, &xyz](unsigned int tick, double charge)
+    { buffers.add(0U, tick, charge, 1, 0.0, xyz); };
+  auto const& data = [&buffers]() -> Buffers_t::Channel_t const&
+    { return *buffers.find(0U); };
+
+  addAt(500U, 1.0);
+  addAt(100U, 2.0);
+  addAt(800U, 3.0);
+  BOOST_REQUIRE(data().ranges.size() == 3U);
+  BOOST_TEST(data().ranges[0].first == 100U); // sorted
+  BOOST_TEST(data().ranges[1].first == 500U);
+  BOOST_TEST(data().ranges[2].first == 800U);
+
+  addAt(500U + Gap + 1U, 4.0); // right after the gap: extends the range
+  BOOST_TEST(data().ranges[1].charges.size() == Gap + 2U);
+  addAt(500U - Gap - 1U, 5.0); // right before the gap: extends to the front
+  BOOST_TEST(data().ranges[1].first == 500U - Gap - 1U);
+  BOOST_TEST(data().ranges.size() == 3U);
+  addAt(100U + 2U * Gap + 2U, 6.0); // beyond the gap: a new range
+  BOOST_TEST(data().ranges.size() == 4U);
+
+  addAt(100U + Gap + 1U, 7.0); // bridges the first two ranges
+  BOOST_REQUIRE(data().ranges.size() == 3U);
+  BOOST_TEST(data().ranges[0].first == 100U);
+  BOOST_TEST(data().ranges[0].charges.size() == 2U * Gap + 3U);
+
+  addAt(800U, 8.0); // same tick: no new signal tick
+  BOOST_TEST(data().nSignalTicks == 7U);
+
+  std::vector<double> charges;
+  buffers.fillCharges(data(), charges);
+  BOOST_TEST(charges.size() == 1000U);
+  std::vector<double> expected(1000U, 0.0);
+  expected[100U] = 2.0;
+  expected[100U + Gap + 1U] = 7.0;
+  expected[100U + 2U * Gap + 2U] = 6.0;
+  expected[500U - Gap - 1U] = 5.0;
+  expected[500U] = 1.0;
+  expected[500U + Gap + 1U] = 4.0;
+  expected[800U] = 11.0;
+  BOOST_TEST(charges == expected, boost::test_tools::per_element());
+
+} // BOOST_AUTO_TEST_CASE(TickRanges_test)
@@ -0,0 +1,146 @@
+/**
+ * @file    WeightManager_test.cc
+ * @brief   Unit test for the parallel calculators of `evwgh::WeightManager`.
+ * @see     `larsim/EventWeight/Base/WeightManager.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( WeightManager_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_TEST()
+
+// LArSoft libraries
+#include "larsim/EventWeight/Base/WeightManager.h"
+
+// C/C++ standard libraries
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+  /// Calculator returning fixed weights, and remembering where it ran.
+  class MockWeightCalc: public evwgh::WeightCalc {
+  public:
+    MockWeightCalc(double weight, unsigned int delayMs)
+      : fWeight(weight), fDelayMs(delayMs) {}
+
+    void Configure(fhicl::ParameterSet const&, CLHEP::HepRandomEngine&) override {}
+
+    std::vector<std::vector<double>> GetWeight(art::Event&) override
+      { return Compute(); }
+
+    /// Returns weights for two neutrinos, after some time.
+    std::vector<std::vector<double>> Compute()
+      {
+        fThread = std::this_thread::get_id();
+        std::this_thread::sleep_for(std::chrono::milliseconds(fDelayMs));
+        return { { fWeight, fWeight + 0.5 }, { fWeight + 10.0 } };
+      }
+
+    std::thread::id fThread; ///< thread of the last computation
+
+  private:
+    double fWeight;
+    unsigned int fDelayMs;
+  }; // MockWeightCalc
+
+  /// Mock calculator declaring itself thread-safe.
+  class ThreadSafeMockWeightCalc: public MockWeightCalc {
+  public:
+    using MockWeightCalc::MockWeightCalc;
+    bool IsThreadSafe() const override { return true; }
+  }; // ThreadSafeMockWeightCalc
+
+  evwgh::WeightManager::WeightFunc_t const mockWeight
+    = [](evwgh::Weight_t& winfo)
+      { return static_cast<MockWeightCalc&>(*winfo.fWeightCalc).Compute(); };
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(DefaultNotThreadSafe_test) {
+
+  MockWeightCalc calc(1.0, 0U);
+  BOOST_TEST(!calc.IsThreadSafe());
+
+} // BOOST_AUTO_TEST_CASE(DefaultNotThreadSafe_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MergeOrder_test) {
+
+  for (unsigned int nThreads: { 1U, 2U, 4U, 0U }) {
+    BOOST_TEST_MESSAGE("Threads: " << nThreads);
+
+    // the slowest functions are the last in name order, so that the
+    // parallel tasks finish in the reverse order
+    ThreadSafeMockWeightCalc zeta(1.0, 40U), mu(2.0, 20U), alpha(4.0, 0U);
+    MockWeightCalc kappa(3.0, 10U);
+    std::map<std::string, MockWeightCalc*> const calcs
+      { { "zeta", &zeta }, { "mu", &mu }, { "kappa", &kappa }, { "alpha", &alpha } };
+
+    evwgh::WeightManager manager;
+    manager.SetNThreads(nThreads);
+    for (auto const& [ name, calc ]: calcs)
+      manager.AddWeightCalc(name, "mock", calc, 2);
+
+    for (int inu: { 0, 1 }) {
+      evwgh::MCEventWeight const mcwgh = manager.Run(inu, mockWeight);
+
+      std::vector<std::string> names;
+      for (auto const& [ name, weights ]: mcwgh.fWeight) names.push_back(name);
+      std::vector<std::string> const expectedNames
+        { "alpha_mock", "kappa_mock", "mu_mock", "zeta_mock" };
+      BOOST_TEST(names == expectedNames, boost::test_tools::per_element());
+
+      std::vector<double> const expectedAlpha
+        = (inu == 0)? std::vector<double>{ 4.0, 4.5 }: std::vector<double>{ 14.0 };
+      std::vector<double> const expectedZeta
+        = (inu == 0)? std::vector<double>{ 1.0, 1.5 }: std::vector<double>{ 11.0 };
+      BOOST_TEST(mcwgh.fWeight.at("alpha_mock") == expectedAlpha,
+        boost::test_tools::per_element());
+      BOOST_TEST(mcwgh.fWeight.at("zeta_mock") == expectedZeta,
+        boost::test_tools::per_element());
+    } // for neutrinos
+
+    // calculators which did not opt in run in the calling thread
+    BOOST_TEST((kappa.fThread == std::this_thread::get_id()));
+    if (nThreads == 1U) {
+      for (auto const& [ name, calc ]: calcs)
+        BOOST_TEST((calc->fThread == std::this_thread::get_id()));
+    }
+
+    // mockWeight bypasses Weight_t::GetWeight(), which collects statistics
+    for (auto const& [ name, winfo ]: manager.GetWeightCalcMap())
+      BOOST_TEST(winfo->fNcalls == 0);
+
+    // WeightManager does not own the calculators
+    for (auto const& [ name, winfo ]: manager.GetWeightCalcMap()) delete winfo;
+  } // for threads
+
+} // BOOST_AUTO_TEST_CASE(MergeOrder_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(EmptyWeights_test) {
+
+  // functions without weights are all merged as a single "empty" entry
+  ThreadSafeMockWeightCalc a(1.0, 0U), b(2.0, 0U);
+  evwgh::WeightManager manager;
+  manager.SetNThreads(2U);
+  manager.AddWeightCalc("a", "mock", &a, 1);
+  manager.AddWeightCalc("b", "mock", &b, 1);
+
+  evwgh::MCEventWeight const mcwgh = manager.Run(0,
+    [](evwgh::Weight_t&){ return std::vector<std::vector<double>>{}; });
+  BOOST_TEST(mcwgh.fWeight.size() == 1U);
+  BOOST_TEST(mcwgh.fWeight.count("empty") == 1U);
+
+  for (auto const& [ name, winfo ]: manager.GetWeightCalcMap()) delete winfo;
+
+} // BOOST_AUTO_TEST_CASE(EmptyWeights_test)
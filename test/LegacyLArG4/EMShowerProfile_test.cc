@@ -0,0 +1,75 @@
+/**
+ * @file    EMShowerProfile_test.cc
+ * @brief   Unit test for `larsim/LegacyLArG4/EMShowerProfile.h`.
+ * @see     `larsim/LegacyLArG4/EMShowerProfile.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( EMShowerProfile_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/LegacyLArG4/EMShowerProfile.h"
+
+// C/C++ standard libraries
+#include <cmath>
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(IncompleteGamma_test) {
+
+  using larg4::EMShowerProfile;
+  auto const tol = boost::test_tools::tolerance(1e-9);
+
+  // P(1, x) = 1 - exp(-x)
+  for (double x: { 0.1, 1.0, 2.5, 10.0 })
+    BOOST_TEST(EMShowerProfile::regularizedGammaP(1.0, x) == 1.0 - std::exp(-x), tol);
+
+  // P(2, x) = 1 - (1 + x) exp(-x), on both sides of the series/fraction switch
+  for (double x: { 0.5, 2.9, 3.1, 20.0 })
+    BOOST_TEST(EMShowerProfile::regularizedGammaP(2.0, x) == 1.0 - (1.0 + x) * std::exp(-x), tol);
+
+  BOOST_TEST(EMShowerProfile::regularizedGammaP(3.0, 0.0) == 0.0);
+
+} // BOOST_AUTO_TEST_CASE(IncompleteGamma_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Profile_test) {
+
+  // 1 GeV electron in iron (Z = 26)
+  double const Ec = larg4::EMShowerProfile::criticalEnergy(26.0);
+  BOOST_TEST(Ec == 22.4, boost::test_tools::tolerance(0.01));
+
+  larg4::EMShowerProfile const electron(1000.0, Ec, false);
+  larg4::EMShowerProfile const photon(1000.0, Ec, true);
+
+  BOOST_TEST(electron.maximumDepth() == std::log(1000.0 / Ec) - 0.5,
+    boost::test_tools::tolerance(1e-12));
+  BOOST_TEST(photon.maximumDepth() == electron.maximumDepth() + 1.0,
+    boost::test_tools::tolerance(1e-12));
+
+  // everything leaks at the start, then leakage decreases with depth
+  BOOST_TEST(electron.leakageFraction(0.0) == 1.0);
+  double last = 1.0;
+  for (double t = 1.0; t <= 30.0; t += 1.0) {
+    double const leakage = electron.leakageFraction(t);
+    BOOST_TEST(leakage < last);
+    last = leakage;
+  }
+  BOOST_TEST(last < 1e-3); // 30 radiation lengths contain the shower
+
+  // photon showers start later
+  BOOST_TEST(photon.leakageFraction(5.0) > electron.leakageFraction(5.0));
+
+  // the profile is skewed: more than half of the energy is past the maximum
+  double const pastMaximum = electron.leakageFraction(electron.maximumDepth());
+  BOOST_TEST(pastMaximum > 0.5);
+  BOOST_TEST(pastMaximum < 0.75);
+
+  // below the critical energy the profile is exponential
+  larg4::EMShowerProfile const soft(10.0, Ec, false);
+  BOOST_TEST(soft.shapeA() == 1.0);
+  BOOST_TEST(soft.leakageFraction(2.0) == std::exp(-1.0), boost::test_tools::tolerance(1e-9));
+
+} // BOOST_AUTO_TEST_CASE(Profile_test)
@@ -0,0 +1,122 @@
+/**
+ * @file    MergeSimChannels_test.cc
+ * @brief   Unit test for `larg4::MergeSimChannels()`.
+ * @see     `larsim/LegacyLArG4/MergeSimChannels.h`
+ *
+ * The SimChannels of a few TPCs sharing some channels are merged with one and
+ * with several threads; the result must be the one of a serial merge.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( MergeSimChannels_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/LegacyLArG4/MergeSimChannels.h"
+
+// C/C++ standard libraries
+#include <map>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------
+constexpr unsigned int NTPCs = 4U;
+constexpr unsigned int NChannels = 50U;
+
+/// Content of a SimChannel: (TDC, track) -> (electrons, energy).
+using ChannelContent_t = std::map<std::pair<unsigned int, int>, std::pair<double, double>>;
+
+//------------------------------------------------------------------------------
+/// Creates the SimChannels of each TPC; TPC `t` covers channels from `10 t`.
+std::vector<std::vector<sim::SimChannel>> makeTPCChannels() {
+  std::vector<std::vector<sim::SimChannel>> perTPC(NTPCs);
+  for (unsigned int t = 0; t < NTPCs; ++t) {
+    // adjacent TPCs share 10 channels; channels in decreasing order in odd TPCs
+    for (unsigned int i = 0; i < 20U; ++i) {
+      unsigned int const channel = 10U * t + ((t % 2)? 19U - i: i);
+      sim::SimChannel sc(channel);
+      double const xyz[3] = { 1.0 * t, 2.0, 3.0 };
+      sc.AddIonizationElectrons(1 + t, channel % 7, 100.0 + channel, xyz, 0.01 * channel);
+      sc.AddIonizationElectrons(10 + t, 3, 50.0, xyz, 0.5);
+      perTPC[t].push_back(std::move(sc));
+    } // for
+  } // for TPC
+  return perTPC;
+} // makeTPCChannels()
+
+
+//------------------------------------------------------------------------------
+ChannelContent_t content(sim::SimChannel const& sc) {
+  ChannelContent_t result;
+  for (auto const& [ tdc, ides ]: sc.TDCIDEMap()) {
+    for (auto const& ide: ides) {
+      auto& dest = result[{ tdc, ide.trackID }];
+      dest.first += ide.numElectrons;
+      dest.second += ide.energy;
+    }
+  }
+  return result;
+} // content()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SerialMerge_test) {
+
+  std::vector<sim::SimChannel> const merged
+    = larg4::MergeSimChannels(makeTPCChannels(), 1U);
+
+  BOOST_TEST(merged.size() == NChannels);
+
+  // reference: order of first appearance, deposits summed over TPCs
+  std::vector<unsigned int> expectedOrder;
+  std::map<unsigned int, ChannelContent_t> expectedContent;
+  for (auto const& channels: makeTPCChannels()) {
+    for (sim::SimChannel const& sc: channels) {
+      if (expectedContent.count(sc.Channel()) == 0)
+        expectedOrder.push_back(sc.Channel());
+      for (auto const& [ key, values ]: content(sc)) {
+        auto& dest = expectedContent[sc.Channel()][key];
+        dest.first += values.first;
+        dest.second += values.second;
+      }
+    } // for channels
+  } // for TPCs
+
+  for (std::size_t i = 0; i < merged.size(); ++i) {
+    BOOST_TEST_MESSAGE("Channel #" << i);
+    BOOST_TEST(merged[i].Channel() == expectedOrder[i]);
+    ChannelContent_t const found = content(merged[i]);
+    ChannelContent_t const& expected = expectedContent[expectedOrder[i]];
+    BOOST_TEST(found.size() == expected.size());
+    for (auto const& [ key, values ]: expected) {
+      auto const itFound = found.find(key);
+      BOOST_TEST((itFound != found.end()));
+      if (itFound == found.end()) continue;
+      BOOST_TEST(itFound->second.first == values.first);
+      BOOST_TEST(itFound->second.second == values.second,
+        boost::test_tools::tolerance(1e-6));
+    }
+  } // for
+
+} // BOOST_AUTO_TEST_CASE(SerialMerge_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ParallelMerge_test) {
+
+  std::vector<sim::SimChannel> const serial
+    = larg4::MergeSimChannels(makeTPCChannels(), 1U);
+
+  for (unsigned int nThreads: { 2U, 3U, 8U }) {
+    BOOST_TEST_MESSAGE("Threads: " << nThreads);
+    std::vector<sim::SimChannel> const parallel
+      = larg4::MergeSimChannels(makeTPCChannels(), nThreads);
+    BOOST_TEST(parallel.size() == serial.size());
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+      BOOST_TEST(parallel[i].Channel() == serial[i].Channel());
+      BOOST_TEST((content(parallel[i]) == content(serial[i])));
+    }
+  } // for
+
+} // BOOST_AUTO_TEST_CASE(ParallelMerge_test)
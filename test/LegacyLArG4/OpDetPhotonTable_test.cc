@@ -0,0 +1,164 @@
+/**
+ * @file    OpDetPhotonTable_test.cc
+ * @brief   Unit test for the per-thread `larg4::OpDetPhotonTable`.
+ * @see     `larsim/LegacyLArG4/OpDetPhotonTable.h`
+ *
+ * The same set of deposits is recorded by one and by several worker threads;
+ * after the end-of-event reduction the content of the tables must match.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( OpDetPhotonTable_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/LegacyLArG4/OpDetPhotonTable.h"
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <map>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------
+constexpr std::size_t NOpChannels = 7U;
+constexpr int NDeposits = 500;
+
+/// Content of the table, in a form which does not depend on filling order.
+struct TableSummary {
+  std::map<int, std::vector<std::pair<float, int>>> photons; // time, track
+  std::map<int, std::map<int, int>> litePhotons;
+  std::map<std::pair<int, double>, double> btrPhotons; // (channel, time)
+  std::map<std::string, std::vector<std::tuple<int, double, double>>> edeps;
+};
+
+//------------------------------------------------------------------------------
+/// Records in the table of the calling thread the deposits `i`, with
+/// `i % nWorkers == worker`.
+void fillDeposits(int worker, int nWorkers) {
+  auto& table = *larg4::OpDetPhotonTable::Instance();
+  for (int i = worker; i < NDeposits; i += nWorkers) {
+    int const channel = i % NOpChannels;
+    int const track = 1 + i / 10;
+
+    sim::OnePhoton photon;
+    photon.Time = 0.5f * i;
+    photon.MotherTrackID = track;
+    table.AddPhoton(channel, std::move(photon), (i % 3) == 0);
+
+    table.AddLitePhoton(channel, i % 20, 1 + i % 4, (i % 5) == 0);
+
+    sim::OpDetBacktrackerRecord btr(channel);
+    double const xyz[3] = { 1.0 * i, 2.0, 3.0 };
+    btr.AddScintillationPhotons(track, i % 20, 1 + i % 4, xyz, 0.001 * i);
+    table.AddOpDetBacktrackerRecord(std::move(btr), (i % 5) == 0);
+
+    table.AddEnergyDeposit(1 + i % 4, 2, 1.0, 0.001 * i,
+      0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 1.0 * i, 1.0 * i + 0.1,
+      track, 13, ((i % 2) == 0)? "volTPCActive": "volCryostat");
+  } // for
+} // fillDeposits()
+
+
+//------------------------------------------------------------------------------
+TableSummary summarize(larg4::OpDetPhotonTable& table) {
+  TableSummary summary;
+
+  for (bool reflected: { false, true }) {
+    int const offset = reflected? 1000: 0;
+    for (sim::SimPhotons const& photons: table.GetPhotons(reflected)) {
+      auto& dest = summary.photons[offset + photons.OpChannel()];
+      for (sim::OnePhoton const& photon: photons)
+        dest.emplace_back(photon.Time, photon.MotherTrackID);
+      std::sort(dest.begin(), dest.end());
+    }
+    for (sim::SimPhotonsLite const& photons: table.YieldLitePhotons(reflected))
+      summary.litePhotons[offset + photons.OpChannel] = photons.DetectedPhotons;
+
+    auto const btrs = reflected
+      ? table.YieldReflectedOpDetBacktrackerRecords()
+      : table.YieldOpDetBacktrackerRecords();
+    for (sim::OpDetBacktrackerRecord const& btr: btrs) {
+      for (auto const& [ time, sdps ]: btr.timePDclockSDPsMap()) {
+        for (auto const& sdp: sdps)
+          summary.btrPhotons[{ offset + btr.OpDetNum(), time }] += sdp.numPhotons;
+      }
+    }
+  } // for reflected
+
+  using Table_t = larg4::OpDetPhotonTable;
+  for (auto const category: { Table_t::kTPCActive, Table_t::kOtherVolume }) {
+    auto const edeps = table.YieldSimEnergyDeposits(category);
+    if (edeps.empty()) continue;
+    auto& dest = summary.edeps[(category == Table_t::kTPCActive)? "TPCActive": "Other"];
+    for (sim::SimEnergyDeposit const& edep: edeps)
+      dest.emplace_back(edep.TrackID(), edep.StartT(), edep.Energy());
+    std::sort(dest.begin(), dest.end());
+  }
+
+  return summary;
+} // summarize()
+
+
+//------------------------------------------------------------------------------
+/// Processes the deposits with `nWorkers` threads and reduces the tables.
+TableSummary runEvent(int nWorkers) {
+  larg4::OpDetPhotonTable::ClearAllTables(NOpChannels);
+
+  std::vector<std::thread> workers;
+  for (int worker = 0; worker < nWorkers; ++worker)
+    workers.emplace_back(fillDeposits, worker, nWorkers);
+  for (auto& worker: workers) worker.join();
+
+  auto& table = *larg4::OpDetPhotonTable::Instance();
+  table.MergeWorkerTables();
+  return summarize(table);
+} // runEvent()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(OneVsManyWorkers_test) {
+
+  TableSummary const single = runEvent(1);
+
+  BOOST_TEST(single.photons.size() == 2 * NOpChannels);
+  BOOST_TEST(single.edeps.size() == 2U);
+  std::size_t nPhotons = 0U;
+  for (auto const& [ channel, photons ]: single.photons) nPhotons += photons.size();
+  BOOST_TEST(nPhotons == std::size_t(NDeposits));
+
+  for (int nWorkers: { 2, 4, 7 }) {
+    BOOST_TEST_MESSAGE("Workers: " << nWorkers);
+    TableSummary const multi = runEvent(nWorkers);
+    BOOST_TEST((multi.photons == single.photons));
+    BOOST_TEST((multi.litePhotons == single.litePhotons));
+    BOOST_TEST((multi.btrPhotons == single.btrPhotons));
+    BOOST_TEST((multi.edeps == single.edeps));
+  } // for
+
+} // BOOST_AUTO_TEST_CASE(OneVsManyWorkers_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ClearAllTables_test) {
+
+  // leave some content in a worker table, which must not leak into next event
+  larg4::OpDetPhotonTable::ClearAllTables(NOpChannels);
+  std::thread(fillDeposits, 0, 1).join();
+
+  larg4::OpDetPhotonTable::ClearAllTables(NOpChannels);
+  auto& table = *larg4::OpDetPhotonTable::Instance();
+  table.MergeWorkerTables();
+  TableSummary const summary = summarize(table);
+
+  for (auto const& [ channel, photons ]: summary.photons)
+    BOOST_TEST(photons.empty());
+  BOOST_TEST(summary.litePhotons.empty());
+  BOOST_TEST(summary.btrPhotons.empty());
+  BOOST_TEST(summary.edeps.empty());
+
+} // BOOST_AUTO_TEST_CASE(ClearAllTables_test)
@@ -0,0 +1,77 @@
+/**
+ * @file    OpticalRouletteMap_test.cc
+ * @brief   Unit test for `larsim/LegacyLArG4/OpticalRouletteMap.h`.
+ * @see     `larsim/LegacyLArG4/OpticalRouletteMap.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( OpticalRouletteMap_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/LegacyLArG4/OpticalRouletteMap.h"
+
+// C/C++ standard libraries
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SurvivalProbability_test) {
+
+  // a dark region, overlapped by a darker one, with a bright one apart
+  larg4::OpticalRouletteMap const map({
+      { 0., 100., -50., 50., 0., 500., 2e-4 },
+      { 0., 100., -50., 50., 400., 0., 1e-6 }, // corners in any order
+      { 200., 300., -50., 50., 0., 500., 5e-3 },
+    }, 1e-3, 0.01);
+
+  BOOST_TEST(!map.empty());
+  BOOST_TEST(map.survivalProbability(50., 0., 450.) == 0.2, boost::test_tools::tolerance(1e-12));
+  BOOST_TEST(map.survivalProbability(50., 0., 100.) == 0.2, boost::test_tools::tolerance(1e-12));
+  BOOST_TEST(map.survivalProbability(250., 0., 100.) == 1.); // bright region
+  BOOST_TEST(map.survivalProbability(150., 0., 100.) == 1.); // no region
+  BOOST_TEST(map.survivalWeight(50., 0., 100.) == 5U);
+  BOOST_TEST(map.survivalWeight(250., 0., 100.) == 1U);
+
+  // the minimum survival bounds the weights
+  larg4::OpticalRouletteMap const darkMap({ { 0., 1., 0., 1., 0., 1., 0. } }, 1e-3, 0.01);
+  BOOST_TEST(darkMap.survivalWeight(0.5, 0.5, 0.5) == 100U);
+
+  BOOST_TEST(larg4::OpticalRouletteMap{}.empty());
+  BOOST_TEST(larg4::OpticalRouletteMap{}.survivalWeight(0., 0., 0.) == 1U);
+
+} // BOOST_AUTO_TEST_CASE(SurvivalProbability_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(WeightConservation_test) {
+
+  // photons played the way OpRussianRoulette does preserve the count on average
+  std::mt19937 engine(2468);
+  std::uniform_real_distribution<double> uniform;
+
+  for (double survival: { 0.5, 0.3, 0.07, 0.01 }) {
+    unsigned int const weight = larg4::OpticalRouletteMap::weightFor(survival);
+    constexpr int NPhotons = 1000000;
+    long int count = 0;
+    for (int i = 0; i < NPhotons; ++i)
+      if (uniform(engine) * weight < 1.) count += weight;
+    double const sigma = std::sqrt(double(NPhotons) * (weight - 1));
+    BOOST_TEST_MESSAGE("survival " << survival << " weight " << weight << ": " << count);
+    BOOST_TEST(std::abs(count - NPhotons) < 5. * sigma);
+  } // for
+
+} // BOOST_AUTO_TEST_CASE(WeightConservation_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Configuration_test) {
+
+  BOOST_CHECK_THROW(larg4::OpticalRouletteMap({ { 0., 1., 0., 1., 0., 1. } }, 1e-3, 0.01),
+                    std::runtime_error);
+  BOOST_CHECK_THROW(larg4::OpticalRouletteMap({}, 0., 0.01), std::runtime_error);
+  BOOST_CHECK_THROW(larg4::OpticalRouletteMap({}, 1e-3, 0.), std::runtime_error);
+
+} // BOOST_AUTO_TEST_CASE(Configuration_test)
@@ -0,0 +1,65 @@
+/**
+ * @file    ReachingTrackCounter_test.cc
+ * @brief   Unit test for `larsim/LegacyLArG4/ReachingTrackCounter.h`.
+ * @see     `larsim/LegacyLArG4/ReachingTrackCounter.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( ReachingTrackCounter_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_TEST()
+
+// LArSoft libraries
+#include "larsim/LegacyLArG4/ReachingTrackCounter.h"
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(StackAndRelease_test) {
+
+  larg4::ReachingTrackCounter pending;
+  BOOST_TEST(pending.empty());
+
+  // two primaries are stacked, one of them is killed by the stacking
+  pending.classified(1, true, true);
+  pending.classified(2, false, true);
+  BOOST_TEST(pending.size() == 1U);
+
+  // the first primary is tracked and leaves three secondaries, one unreachable
+  pending.released(1);
+  BOOST_TEST(pending.empty());
+  pending.classified(3, true, true);
+  pending.classified(4, true, false);
+  pending.classified(5, true, true);
+  BOOST_TEST(pending.size() == 2U);
+
+  // releasing a track which was never counted changes nothing
+  pending.released(4);
+  BOOST_TEST(pending.size() == 2U);
+
+  pending.released(3);
+  pending.released(5);
+  BOOST_TEST(pending.empty());
+
+} // BOOST_AUTO_TEST_CASE(StackAndRelease_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Reclassification_test) {
+
+  larg4::ReachingTrackCounter pending;
+
+  // a new stage classifies again the stacked tracks: no double counting
+  pending.classified(3, true, true);
+  pending.classified(3, true, true);
+  BOOST_TEST(pending.size() == 1U);
+
+  // the reclassification kills the track, which is then no longer waited for
+  pending.classified(3, false, true);
+  BOOST_TEST(pending.empty());
+
+  // a new event forgets the tracks of the previous one
+  pending.classified(6, true, true);
+  pending.clear();
+  BOOST_TEST(pending.empty());
+
+} // BOOST_AUTO_TEST_CASE(Reclassification_test)
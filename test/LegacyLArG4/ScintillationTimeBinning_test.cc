@@ -0,0 +1,121 @@
+/**
+ * @file    ScintillationTimeBinning_test.cc
+ * @brief   Unit test for `larsim/LegacyLArG4/ScintillationTimeBinning.h`.
+ * @see     `larsim/LegacyLArG4/ScintillationTimeBinning.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( ScintillationTimeBinning_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/LegacyLArG4/ScintillationTimeBinning.h"
+
+// C/C++ standard libraries
+#include <cmath>
+#include <map>
+#include <random>
+#include <stdexcept>
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(EmissionSurvival_test) {
+
+  using larg4::scinttime::emissionSurvival;
+
+  BOOST_TEST(emissionSurvival(0., 0., 6.) == 1.);
+  BOOST_TEST(emissionSurvival(0., 1., 6.) == 1.);
+  BOOST_TEST(emissionSurvival(6., 0., 6.) == std::exp(-1.), boost::test_tools::tolerance(1e-12));
+
+  // with a rise time emission is delayed, and survival is monotonic
+  double previous = 1.;
+  for (double t = 0.5; t < 100.; t += 0.5) {
+    double const survival = emissionSurvival(t, 1., 6.);
+    BOOST_TEST(survival > emissionSurvival(t, 0., 6.));
+    BOOST_TEST(survival < previous);
+    previous = survival;
+  }
+
+} // BOOST_AUTO_TEST_CASE(EmissionSurvival_test)
+
+
+//------------------------------------------------------------------------------
+/// Compares binned counts with the per-photon sampling of emission times.
+void compareWithSampling(double startTime, double riseTime, double decayTime) {
+
+  std::mt19937 engine(12345);
+  auto binomial = [&engine](int n, double p)
+    { return std::binomial_distribution<int>(n, p)(engine); };
+
+  // the same profile as OpFastScintillation::sample_time()
+  std::uniform_real_distribution<double> uniform;
+  auto sampleTime = [&]() -> double {
+    if (riseTime <= 0.) return -decayTime * std::log(uniform(engine));
+    while (true) {
+      double const t = -decayTime * std::log(1. - uniform(engine));
+      if (uniform(engine) <= 1. - std::exp(-t / riseTime)) return t;
+    }
+  };
+
+  constexpr int NPhotons = 200;
+  constexpr int NTrials = 2000;
+
+  std::map<int, double> binned, sampled;
+  for (int trial = 0; trial < NTrials; ++trial) {
+    int total = 0;
+    larg4::scinttime::binPhotonTimes(NPhotons, startTime, riseTime, decayTime,
+      binomial, [&](int bin, int count) { binned[bin] += count; total += count; });
+    BOOST_TEST(total == NPhotons);
+
+    for (int i = 0; i < NPhotons; ++i)
+      sampled[static_cast<int>(startTime + sampleTime())] += 1.;
+  } // for trials
+
+  BOOST_TEST(binned.begin()->first >= static_cast<int>(startTime));
+
+  // chi2 over the bins with enough statistics
+  double chi2 = 0.;
+  unsigned int nBins = 0;
+  for (auto const& [ bin, count ]: sampled) {
+    if (count < 50.) continue;
+    double const other = binned.count(bin)? binned.at(bin): 0.;
+    chi2 += (count - other) * (count - other) / (count + other);
+    ++nBins;
+  }
+  BOOST_TEST_MESSAGE("chi2/bins = " << chi2 << "/" << nBins);
+  BOOST_TEST(nBins > 5U);
+  BOOST_TEST(chi2 < 2. * nBins);
+
+} // compareWithSampling()
+
+
+BOOST_AUTO_TEST_CASE(FastComponent_test) {
+  compareWithSampling(10.3, 0., 6.);
+}
+
+BOOST_AUTO_TEST_CASE(RiseTime_test) {
+  compareWithSampling(0.7, 2., 6.);
+}
+
+BOOST_AUTO_TEST_CASE(NegativeStart_test) {
+  // the emission spans negative ticks, tick 0 and positive ticks
+  compareWithSampling(-15.4, 0., 6.);
+}
+
+BOOST_AUTO_TEST_CASE(NoDecay_test) {
+  // an instantaneous emission puts all photons in the starting bin
+  int total = 0;
+  larg4::scinttime::binPhotonTimes(17, 4.2, 0., 0.,
+    [](int, double) -> int { throw std::logic_error("unexpected draw"); },
+    [&total](int bin, int count) { BOOST_TEST(bin == 4); total += count; });
+  BOOST_TEST(total == 17);
+}
+
+BOOST_AUTO_TEST_CASE(NegativeNoDecay_test) {
+  // negative times are truncated toward zero, like the single lite photons
+  int total = 0;
+  larg4::scinttime::binPhotonTimes(17, -4.2, 0., 0.,
+    [](int, double) -> int { throw std::logic_error("unexpected draw"); },
+    [&total](int bin, int count) { BOOST_TEST(bin == -4); total += count; });
+  BOOST_TEST(total == 17);
+}
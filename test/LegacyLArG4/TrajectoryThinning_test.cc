@@ -0,0 +1,128 @@
+/**
+ * @file    TrajectoryThinning_test.cc
+ * @brief   Unit test for `larg4::TrajectoryThinning`.
+ * @see     `larsim/LegacyLArG4/TrajectoryThinning.h`
+ *
+ * Points are fed to the thinning the way `ParticleListAction` does, and the
+ * stored trajectory is checked.
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( TrajectoryThinning_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/LegacyLArG4/TrajectoryThinning.h"
+
+// C/C++ standard libraries
+#include <cmath>
+#include <vector>
+
+//------------------------------------------------------------------------------
+/// Returns the points stored out of `points`, as `ParticleListAction` does.
+std::vector<TVector3> thin(std::vector<TVector3> const& points, double tolerance) {
+
+  larg4::TrajectoryThinning thinning{ tolerance };
+  std::vector<TVector3> stored;
+  TVector3 const* pending = nullptr;
+  for (TVector3 const& point: points) {
+    if (!thinning.enabled() || stored.empty()) {
+      stored.push_back(point);
+      continue;
+    }
+    if (pending && !thinning.drop(stored.back(), *pending, point)) {
+      stored.push_back(*pending);
+      thinning.clear();
+    }
+    pending = &point;
+  } // for
+  if (pending) stored.push_back(*pending); // the last point is always stored
+  return stored;
+
+} // thin()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(DistanceFromSegment_test) {
+
+  TVector3 const a{ 0.0, 0.0, 0.0 }, b{ 10.0, 0.0, 0.0 };
+  BOOST_TEST(larg4::distanceFromSegment({ 5.0, 3.0, 0.0 }, a, b) == 3.0);
+  BOOST_TEST(larg4::distanceFromSegment({ -4.0, 3.0, 0.0 }, a, b) == 5.0);
+  BOOST_TEST(larg4::distanceFromSegment({ 13.0, 0.0, 4.0 }, a, b) == 5.0);
+  BOOST_TEST(larg4::distanceFromSegment({ 0.0, 2.0, 0.0 }, a, a) == 2.0);
+
+} // BOOST_AUTO_TEST_CASE(DistanceFromSegment_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Disabled_test) {
+
+  std::vector<TVector3> points;
+  for (int i = 0; i < 10; ++i) points.emplace_back(i, 0.0, 0.0);
+
+  larg4::TrajectoryThinning thinning;
+  BOOST_TEST(!thinning.enabled());
+  BOOST_TEST(!thinning.drop(points[0], points[1], points[2]));
+  BOOST_TEST(thin(points, 0.0).size() == points.size());
+
+} // BOOST_AUTO_TEST_CASE(Disabled_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(StraightLine_test) {
+
+  // a straight track keeps only its end points
+  std::vector<TVector3> points;
+  for (int i = 0; i <= 20; ++i) points.emplace_back(0.5 * i, 0.0, 0.0);
+
+  std::vector<TVector3> const stored = thin(points, 0.01);
+  BOOST_TEST(stored.size() == 2U);
+  BOOST_TEST((stored.front() == points.front()));
+  BOOST_TEST((stored.back() == points.back()));
+
+} // BOOST_AUTO_TEST_CASE(StraightLine_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Kink_test) {
+
+  // the corner of a kink farther than the tolerance is kept
+  std::vector<TVector3> points;
+  for (int i = 0; i <= 10; ++i) points.emplace_back(i, 0.0, 0.0);
+  for (int i = 1; i <= 10; ++i) points.emplace_back(10.0, i, 0.0);
+
+  std::vector<TVector3> const stored = thin(points, 0.1);
+  BOOST_TEST(stored.size() == 3U);
+  BOOST_TEST((stored[1] == TVector3(10.0, 0.0, 0.0)));
+
+} // BOOST_AUTO_TEST_CASE(Kink_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Arc_test) {
+
+  // on an arc each point is close to the chord of its neighbours, but not to
+  // the longer chords: all the dropped points must stay within tolerance
+  double const radius = 100.0, tolerance = 0.05;
+  std::vector<TVector3> points;
+  for (int i = 0; i <= 200; ++i) {
+    double const angle = 0.005 * i;
+    points.emplace_back(radius * std::sin(angle), radius * (1.0 - std::cos(angle)), 0.0);
+  }
+
+  std::vector<TVector3> const stored = thin(points, tolerance);
+  BOOST_TEST(stored.size() > 2U);
+  BOOST_TEST(stored.size() < points.size());
+
+  // every original point is within tolerance of the stored trajectory
+  for (TVector3 const& point: points) {
+    double distance = larg4::distanceFromSegment(point, stored[0], stored[1]);
+    for (std::size_t i = 1; i + 1 < stored.size(); ++i) {
+      distance = std::min
+        (distance, larg4::distanceFromSegment(point, stored[i], stored[i + 1]));
+    }
+    BOOST_TEST(distance <= tolerance);
+  } // for
+
+} // BOOST_AUTO_TEST_CASE(Arc_test)
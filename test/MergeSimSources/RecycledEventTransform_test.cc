@@ -0,0 +1,179 @@
+/**
+ * @file    RecycledEventTransform_test.cc
+ * @brief   Unit test for `sim::RecycledEventTransform`.
+ * @see     `larsim/MergeSimSources/RecycledEventTransform.h`
+ *
+ * The transforms are built on the example detector geometry
+ * (`lartpcdetector`), configured in `test_geometry.fcl`:
+ *
+ *     RecycledEventTransform_test -- ./test_geometry.fcl
+ *
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( RecycledEventTransform_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/MergeSimSources/RecycledEventTransform.h"
+#include "larcorealg/Geometry/ChannelMapStandardAlg.h"
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcorealg/Geometry/WireGeo.h"
+#include "larcorealg/TestUtils/boost_unit_test_base.h"
+#include "larcorealg/TestUtils/geometry_unit_test_base.h"
+
+// C/C++ standard libraries
+#include <cstddef>
+
+
+//------------------------------------------------------------------------------
+using StandardGeometryConfiguration
+  = testing::BoostCommandLineConfiguration<
+      testing::BasicGeometryEnvironmentConfiguration<geo::ChannelMapStandardAlg>
+    >;
+
+using StandardGeometryTestEnvironment
+  = testing::GeometryTesterEnvironment<StandardGeometryConfiguration>;
+
+/// Loads the geometry for each test case.
+struct GeometryFixture: private StandardGeometryTestEnvironment {
+
+  geo::GeometryCore const& geom() const
+    { return *StandardGeometryTestEnvironment::Geometry(); }
+
+  /// Number of channels with at least one wire.
+  std::size_t NWiredChannels() const
+    {
+      std::size_t n = 0;
+      for (raw::ChannelID_t channel = 0; channel < geom().Nchannels(); ++channel)
+        if (!geom().ChannelToWire(channel).empty()) ++n;
+      return n;
+    }
+
+}; // struct GeometryFixture
+
+
+constexpr double Tolerance = 0.01; // cm
+
+
+//------------------------------------------------------------------------------
+BOOST_FIXTURE_TEST_SUITE(RecycledEventTransformTest, GeometryFixture)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Identity_test) {
+
+  sim::RecycledEventTransform const identity
+    (geom(), false, false, geo::Vector_t{}, Tolerance);
+
+  BOOST_TEST(identity.IsIdentity());
+  BOOST_TEST(identity.NUnmappedChannels() == 0U);
+  for (raw::ChannelID_t channel = 0; channel < geom().Nchannels(); ++channel)
+    BOOST_TEST(identity.Channel(channel) == channel);
+
+  geo::Point_t const pos{ 1.0, -2.0, 3.0 };
+  BOOST_TEST((identity.Position(pos) == pos));
+
+} // BOOST_AUTO_TEST_CASE(Identity_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(WirePitchTranslation_test) {
+
+  // the shift from a collection wire to the next one
+  for (geo::PlaneGeo const& plane: geom().IteratePlanes()) {
+    if (geom().SignalType(plane.ID()) != geo::kCollection) continue;
+    if (plane.Nwires() < 2U) continue;
+
+    geo::Vector_t const shift = plane.Wire(1).GetCenter<geo::Point_t>()
+      - plane.Wire(0).GetCenter<geo::Point_t>();
+    BOOST_TEST_MESSAGE("Translation by one wire of " << plane.ID());
+
+    sim::RecycledEventTransform const transform
+      (geom(), false, false, shift, Tolerance);
+    BOOST_TEST(!transform.IsIdentity());
+
+    // channel mapping: each wire onto the next one; the last has no image
+    for (unsigned int w = 0; w < plane.Nwires(); ++w) {
+      geo::WireID const wireID{ plane.ID(), w };
+      raw::ChannelID_t const image
+        = transform.Channel(geom().PlaneWireToChannel(wireID));
+      raw::ChannelID_t const expected = (w + 1 < plane.Nwires())
+        ? geom().PlaneWireToChannel(geo::WireID{ plane.ID(), w + 1 })
+        : raw::InvalidChannelID;
+      BOOST_TEST(image == expected);
+    } // for wires
+
+    // the last wire can't be mapped: this is not a symmetry of the detector
+    BOOST_TEST(transform.NUnmappedChannels() > 0U);
+
+    // half a pitch puts the collection wires between two wires
+    sim::RecycledEventTransform const halfShift
+      (geom(), false, false, shift / 2., Tolerance);
+    for (unsigned int w = 0; w < plane.Nwires(); ++w) {
+      raw::ChannelID_t const channel
+        = geom().PlaneWireToChannel(geo::WireID{ plane.ID(), w });
+      BOOST_TEST(halfShift.Channel(channel) == raw::InvalidChannelID);
+    }
+
+    break; // one plane is enough
+  } // for planes
+
+} // BOOST_AUTO_TEST_CASE(WirePitchTranslation_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(DriftTranslation_test) {
+
+  // moving along the drift direction takes the wires out of their planes
+  sim::RecycledEventTransform const transform
+    (geom(), false, false, geo::Vector_t{ 10.0, 0.0, 0.0 }, Tolerance);
+
+  BOOST_TEST(transform.NUnmappedChannels() == NWiredChannels());
+  for (raw::ChannelID_t channel = 0; channel < geom().Nchannels(); ++channel)
+    BOOST_TEST(transform.Channel(channel) == raw::InvalidChannelID);
+
+} // BOOST_AUTO_TEST_CASE(DriftTranslation_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Mirror_test) {
+
+  sim::RecycledEventTransform const mirrorZ
+    (geom(), false, true, geo::Vector_t{}, Tolerance);
+  BOOST_TEST(!mirrorZ.IsIdentity());
+
+  // mirroring is its own inverse
+  geo::Point_t const pos{ 10.0, -20.0, 30.0 };
+  geo::Point_t const back = mirrorZ.Position(mirrorZ.Position(pos));
+  BOOST_TEST(back.X() == pos.X(), boost::test_tools::tolerance(1e-9));
+  BOOST_TEST(back.Y() == pos.Y(), boost::test_tools::tolerance(1e-9));
+  BOOST_TEST(back.Z() == pos.Z(), boost::test_tools::tolerance(1e-9));
+
+  geo::Vector_t const dir = mirrorZ.Direction({ 0.3, 0.4, 0.5 });
+  BOOST_TEST(dir.X() == 0.3);
+  BOOST_TEST(dir.Y() == 0.4);
+  BOOST_TEST(dir.Z() == -0.5);
+
+  // ... and so is the channel mapping, where defined
+  for (raw::ChannelID_t channel = 0; channel < geom().Nchannels(); ++channel) {
+    raw::ChannelID_t const image = mirrorZ.Channel(channel);
+    if (image == raw::InvalidChannelID) continue;
+    BOOST_TEST(mirrorZ.Channel(image) == channel);
+  }
+
+  // with a single TPC, mirroring the drift coordinate moves the wire planes
+  // onto the cathode: no channel has an image
+  if (geom().NTPC() == 1U) {
+    sim::RecycledEventTransform const mirrorX
+      (geom(), true, false, geo::Vector_t{}, Tolerance);
+    BOOST_TEST(mirrorX.NUnmappedChannels() == NWiredChannels());
+  }
+
+} // BOOST_AUTO_TEST_CASE(Mirror_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
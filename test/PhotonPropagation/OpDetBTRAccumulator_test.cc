@@ -0,0 +1,104 @@
+/**
+ * @file    OpDetBTRAccumulator_test.cc
+ * @brief   Unit test for `phot::OpDetBTRAccumulator`.
+ * @see     `larsim/PhotonPropagation/OpDetBTRAccumulator.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( OpDetBTRAccumulator_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/PhotonPropagation/OpDetBTRAccumulator.h"
+
+// C/C++ standard libraries
+#include <map>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------
+/// Photons and energy by time and track.
+using Content_t = std::map<std::pair<double, int>, std::pair<double, double>>;
+
+Content_t recordContent(sim::OpDetBacktrackerRecord const& record) {
+  Content_t content;
+  for (auto const& [ time, sdps ]: record.timePDclockSDPsMap()) {
+    for (auto const& sdp: sdps) {
+      auto& [ photons, energy ] = content[{ time, sdp.trackID }];
+      photons += sdp.numPhotons;
+      energy += sdp.energy;
+    }
+  }
+  return content;
+} // recordContent()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Accumulation_test) {
+
+  double const posA[3] = { 1.0, 2.0, 3.0 };
+  double const posB[3] = { -1.0, 0.0, 5.0 };
+
+  phot::OpDetBTRAccumulator acc(4);
+  BOOST_TEST(acc.nChannels() == 4U);
+
+  // channel 2: photons out of time order, two of them to be merged
+  acc.add(2, 7, 30.0, 1.0, posA, 0.1);
+  acc.add(2, 7, 30.0, 1.0, posA, 0.1);
+  acc.add(2, 7, 10.0, 1.0, posA, 0.1);
+  acc.add(2, 8, 30.0, 2.0, posB, 0.4);
+  BOOST_TEST(acc.nEntries(2) == 3U);
+
+  // channel 0: one photon
+  acc.add(0, 5, 20.0, 1.0, posB, 0.2);
+
+  std::vector<sim::OpDetBacktrackerRecord> const records = acc.makeRecords();
+  BOOST_TEST(records.size() == 2U);
+
+  // records are in channel order
+  BOOST_TEST(records[0].OpDetNum() == 0);
+  BOOST_TEST(records[1].OpDetNum() == 2);
+
+  Content_t const content0 = recordContent(records[0]);
+  BOOST_TEST(content0.size() == 1U);
+  BOOST_TEST(content0.at({ 20.0, 5 }).first == 1.0);
+
+  Content_t const content2 = recordContent(records[1]);
+  BOOST_TEST(content2.size() == 3U);
+  BOOST_TEST(content2.at({ 10.0, 7 }).first == 1.0);
+  BOOST_TEST(content2.at({ 30.0, 7 }).first == 2.0);
+  BOOST_TEST(content2.at({ 30.0, 7 }).second == 0.2, boost::test_tools::tolerance(1e-12));
+  BOOST_TEST(content2.at({ 30.0, 8 }).first == 2.0);
+
+  // times are in increasing order
+  double lastTime = -1.0;
+  for (auto const& timeSDPs: records[1].timePDclockSDPsMap()) {
+    BOOST_TEST(timeSDPs.first > lastTime);
+    lastTime = timeSDPs.first;
+  }
+
+  // the accumulator is empty after making the records
+  for (std::size_t channel = 0; channel < acc.nChannels(); ++channel)
+    BOOST_TEST(acc.nEntries(channel) == 0U);
+  BOOST_TEST(acc.makeRecords().empty());
+
+} // BOOST_AUTO_TEST_CASE(Accumulation_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Reset_test) {
+
+  double const pos[3] = { 0.0, 0.0, 0.0 };
+
+  phot::OpDetBTRAccumulator acc;
+  BOOST_TEST(acc.nChannels() == 0U);
+
+  acc.reset(3);
+  BOOST_TEST(acc.nChannels() == 3U);
+  acc.add(1, 1, 5.0, 1.0, pos, 0.1);
+  acc.reset(3);
+  BOOST_TEST(acc.nEntries(1) == 0U);
+  BOOST_TEST(acc.makeRecords().empty());
+
+} // BOOST_AUTO_TEST_CASE(Reset_test)
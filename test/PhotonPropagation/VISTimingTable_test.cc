@@ -0,0 +1,129 @@
+/**
+ * @file    VISTimingTable_test.cc
+ * @brief   Unit test for `phot::VISTimingTable` and `phot::smearVISTime()`.
+ * @see     `larsim/PhotonPropagation/VISTimingTable.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( VISTimingTable_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/PhotonPropagation/VISTimingTable.h"
+
+// C/C++ standard libraries
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+//------------------------------------------------------------------------------
+using Pars_t = std::vector<std::vector<std::vector<double>>>;
+
+/// Linear interpolation (and extrapolation) between the two nearest nodes.
+double interpolate(std::vector<double> const& xs, std::vector<double> const& ys, double x) {
+  std::size_t i = 0;
+  while ((i + 2 < xs.size()) && (x > xs[i + 1])) ++i;
+  return ys[i] + (x - xs[i]) * (ys[i + 1] - ys[i]) / (xs[i + 1] - xs[i]);
+} // interpolate()
+
+
+/// Parameter value at the nodes: linear in each variable, but not bilinear.
+double cutoffAt(std::size_t angle, double d, double r)
+  { return 100.0 * (angle + 1) + 2.0 * d + 0.5 * r + 0.01 * d * r + 0.001 * d * d; }
+double tauAt(std::size_t angle, double d, double r)
+  { return 0.5 + 0.1 * angle + 0.001 * d + 0.002 * r; }
+
+
+//------------------------------------------------------------------------------
+void checkTable(std::vector<double> const& distances, std::vector<double> const& radial) {
+
+  std::size_t const nAngles = 3U;
+  Pars_t cutoffs(nAngles), taus(nAngles);
+  for (std::size_t a = 0; a < nAngles; ++a) {
+    for (double r: radial) {
+      cutoffs[a].emplace_back();
+      taus[a].emplace_back();
+      for (double d: distances) {
+        cutoffs[a].back().push_back(cutoffAt(a, d, r));
+        taus[a].back().push_back(tauAt(a, d, r));
+      }
+    }
+  }
+
+  phot::VISTimingTable const table{ distances, radial, cutoffs, taus };
+  BOOST_TEST(!table.empty());
+  BOOST_TEST(table.nAngleBins() == nAngles);
+
+  // reference: interpolate in distance at each radial node, then in radius
+  for (std::size_t a = 0; a < nAngles + 1; ++a) {
+    std::size_t const refAngle = std::min(a, nAngles - 1);
+    for (double d = -20.0; d < 420.0; d += 13.7) {
+      for (double r = -10.0; r < 320.0; r += 17.3) {
+        std::vector<double> cutoffAtR, tauAtR;
+        for (std::size_t i = 0; i < radial.size(); ++i) {
+          cutoffAtR.push_back(interpolate(distances, cutoffs[refAngle][i], d));
+          tauAtR.push_back(interpolate(distances, taus[refAngle][i], d));
+        }
+        phot::VISTimingTable::Smearing_t const s = table.at(a, d, r);
+        BOOST_TEST(s.cutoff == interpolate(radial, cutoffAtR, r), boost::test_tools::tolerance(1e-9));
+        BOOST_TEST(s.tau == interpolate(radial, tauAtR, r), boost::test_tools::tolerance(1e-9));
+      } // for r
+    } // for d
+  } // for angle
+
+} // checkTable()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(UniformNodes_test) {
+  checkTable({ 0.0, 50.0, 100.0, 150.0, 200.0, 250.0, 300.0, 350.0, 400.0 },
+             { 0.0, 75.0, 150.0, 225.0, 300.0 });
+}
+
+BOOST_AUTO_TEST_CASE(IrregularNodes_test) {
+  checkTable({ 0.0, 25.0, 100.0, 110.0, 250.0, 400.0 }, { 0.0, 20.0, 150.0, 300.0 });
+}
+
+BOOST_AUTO_TEST_CASE(InvalidShape_test) {
+  Pars_t const pars(2U, std::vector<std::vector<double>>(2U, std::vector<double>(3U, 1.0)));
+  BOOST_CHECK_NO_THROW((phot::VISTimingTable{{ 0.0, 1.0, 2.0 }, { 0.0, 1.0 }, pars, pars }));
+  BOOST_CHECK_THROW((phot::VISTimingTable{{ 0.0, 1.0 }, { 0.0, 1.0 }, pars, pars }),
+                    std::runtime_error);
+  BOOST_CHECK_THROW((phot::VISTimingTable{{ 0.0, 2.0, 1.0 }, { 0.0, 1.0 }, pars, pars }),
+                    std::runtime_error);
+  BOOST_CHECK_THROW((phot::VISTimingTable{{ 0.0, 1.0, 2.0 }, { 0.0, 1.0 }, pars, Pars_t{} }),
+                    std::runtime_error);
+}
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Smearing_test) {
+
+  phot::VISTimingTable::Smearing_t const smearing{ 100.0, 1.5 };
+  double const fastest = 20.0;
+
+  // times beyond the cut-off are untouched
+  BOOST_TEST(phot::smearVISTime(120.0, fastest, smearing, 0.3) == 120.0);
+
+  // without constraint from the cut-off, x = 0.5 + u / 2
+  double const time = 30.0;
+  double const expectedAtHalf
+    = time + (time - fastest) * (std::pow(0.75, -smearing.tau) - 1.0);
+  BOOST_TEST(phot::smearVISTime(time, fastest, smearing, 0.5) == expectedAtHalf,
+             boost::test_tools::tolerance(1e-12));
+  BOOST_TEST(phot::smearVISTime(time, fastest, smearing, 1.0) == time,
+             boost::test_tools::tolerance(1e-12));
+
+  // with the cut-off constraining the range, the result stays within it;
+  // the smallest random number reaches the cut-off exactly
+  double const lateTime = 60.0;
+  BOOST_TEST(phot::smearVISTime(lateTime, fastest, smearing, 0.0) == smearing.cutoff,
+             boost::test_tools::tolerance(1e-9));
+  for (double u = 0.0; u < 1.0; u += 0.01) {
+    double const smeared = phot::smearVISTime(lateTime, fastest, smearing, u);
+    BOOST_TEST(smeared >= lateTime);
+    BOOST_TEST(smeared <= smearing.cutoff * (1.0 + 1e-12));
+  }
+
+} // BOOST_AUTO_TEST_CASE(Smearing_test)
@@ -0,0 +1,62 @@
+/**
+ * @file    VisibilityGridCache_test.cc
+ * @brief   Unit test for `phot::VisibilityGridCache`.
+ * @see     `larsim/PhotonPropagation/VisibilityGridCache.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( VisibilityGridCache_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/PhotonPropagation/VisibilityGridCache.h"
+
+// C/C++ standard libraries
+#include <vector>
+
+//------------------------------------------------------------------------------
+void VisibilityGridCacheTest() {
+
+  using Visibilities_t = std::vector<double>;
+
+  phot::VisibilityGridCache<Visibilities_t> cache{ 2U };
+  BOOST_CHECK_EQUAL(cache.capacity(), 2U);
+  BOOST_CHECK_EQUAL(cache.size(), 0U);
+
+  phot::VisibilityGridCell const cellA{ 0U, 1U, -3, 4, 5 };
+  phot::VisibilityGridCell const cellB{ 0U, 0U, -3, 4, 5 }; // different TPC
+  phot::VisibilityGridCell const cellC{ 1U, 1U, -3, 4, 5 }; // different cryostat
+
+  BOOST_CHECK(!cache.find(cellA));
+  BOOST_CHECK_EQUAL(cache.misses(), 1U);
+
+  Visibilities_t const* storedA = cache.insert(cellA, { 0.1, 0.2 });
+  BOOST_REQUIRE(storedA);
+  BOOST_CHECK_EQUAL(storedA->size(), 2U);
+  BOOST_CHECK_EQUAL(cache.find(cellA), storedA);
+  BOOST_CHECK_EQUAL(cache.hits(), 1U);
+
+  // inserting again does not replace the value
+  BOOST_CHECK_EQUAL(cache.insert(cellA, { 0.5 }), storedA);
+  BOOST_CHECK_EQUAL((*storedA)[0], 0.1);
+
+  BOOST_CHECK(!cache.find(cellB));
+  BOOST_CHECK(cache.insert(cellB, { 0.3 }));
+  BOOST_CHECK_EQUAL(cache.size(), 2U);
+
+  // cache is full: new cells are not stored, old ones are still there
+  BOOST_CHECK(!cache.insert(cellC, { 0.4 }));
+  BOOST_CHECK(!cache.find(cellC));
+  BOOST_CHECK_EQUAL(cache.find(cellA), storedA);
+  BOOST_CHECK_EQUAL(cache.size(), 2U);
+
+} // VisibilityGridCacheTest()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(VisibilityGridCacheTestCase) {
+
+  VisibilityGridCacheTest();
+
+} // BOOST_AUTO_TEST_CASE(VisibilityGridCacheTestCase)
@@ -0,0 +1,64 @@
+/**
+ * @file    ParallelFor_test.cc
+ * @brief   Unit test for `larsim::Utils::ParallelFor()`.
+ * @see     `larsim/Utils/ParallelFor.h`
+ */
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( ParallelFor_test )
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK()
+
+// LArSoft libraries
+#include "larsim/Utils/ParallelFor.h"
+
+// C/C++ standard libraries
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(AllItems_test) {
+
+  for (unsigned int nThreads: { 0U, 1U, 2U, 4U }) {
+    BOOST_TEST_MESSAGE("Threads: " << nThreads);
+    std::vector<int> done(1000, 0);
+    larsim::Utils::ParallelFor
+      (done.size(), nThreads, [&done](std::size_t i){ ++done[i]; });
+    for (int count: done) BOOST_TEST(count == 1);
+  } // for
+
+  // nothing to do
+  std::atomic<int> calls{ 0 };
+  larsim::Utils::ParallelFor(0U, 4U, [&calls](std::size_t){ ++calls; });
+  BOOST_TEST(calls.load() == 0);
+
+} // BOOST_AUTO_TEST_CASE(AllItems_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SerialOrder_test) {
+
+  std::vector<std::size_t> order;
+  larsim::Utils::ParallelFor
+    (10U, 1U, [&order](std::size_t i){ order.push_back(i); });
+  BOOST_TEST(order.size() == 10U);
+  for (std::size_t i = 0; i < order.size(); ++i) BOOST_TEST(order[i] == i);
+
+} // BOOST_AUTO_TEST_CASE(SerialOrder_test)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Exception_test) {
+
+  auto const work
+    = [](std::size_t i){ if (i == 7U) throw std::runtime_error("item 7"); };
+  for (unsigned int nThreads: { 0U, 1U, 3U }) {
+    BOOST_TEST_MESSAGE("Threads: " << nThreads);
+    BOOST_CHECK_THROW
+      (larsim::Utils::ParallelFor(10U, nThreads, work), std::runtime_error);
+  } // for
+
+} // BOOST_AUTO_TEST_CASE(Exception_test)